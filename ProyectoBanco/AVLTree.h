@@ -1,6 +1,7 @@
 #pragma once
 
 #include "BNode.h"
+#include "Memoria.h"
 #include <functional>
 
 template <class C>
@@ -159,6 +160,7 @@ void AVLTree<C>::_destroyTree(BNode<C>* node) {
 // Mtodo pblico para insertar un valor
 template <class C>
 void AVLTree<C>::insert(const C& value) {
+    ZonaMemoria zona(Subsistema::Contenedores, false);
     root = _insert(root, value);
 }
 
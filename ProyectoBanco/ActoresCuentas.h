@@ -0,0 +1,276 @@
+#pragma once
+
+#include "MGeneral.h"
+#include "Operacion.h"
+#include "ConcurrentQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Modo de ejecucin por actores: las cuentas del registro se reparten entre N hilos segn el
+// hash de su nmero y cada hilo es el nico que procesa las operaciones de su parte.
+// Las operaciones llegan al buzn (ConcurrentQueue) del hilo dueo de la cuenta; el hilo saca
+// varias a la vez, las agrupa por cuenta y aplica cada grupo con Cuenta::aplicarLote, por lo
+// que el saldo de una cuenta solo lo toca un ncleo y nunca hay competencia por l.
+class ActoresCuentas
+{
+private:
+	struct Mensaje
+	{
+		Operacion operacion;
+		function<void(EstadoOperacion)> respuesta; // Opcional
+	};
+
+	struct Actor
+	{
+		ConcurrentQueue<Mensaje> buzon;
+		HashTable<Cuenta*, uint64_t> cuentas; // Cuentas de esta parte, indexadas por NumeroCuenta::getValor
+		atomic<bool> dormido;
+		mutex m;
+		condition_variable cv;
+		thread hilo;
+		atomic<size_t> aplicadas;
+		atomic<size_t> rechazadas;
+
+		Actor(size_t capacidadBuzon) : buzon(capacidadBuzon), cuentas(1024), dormido(false), aplicadas(0), rechazadas(0) {}
+	};
+
+	static constexpr size_t LOTE = 64; // Mensajes que un actor saca del buzn por pasada
+
+	vector<unique_ptr<Actor>> actores;
+	atomic<bool> detener;
+	atomic<size_t> enviadas;
+	atomic<size_t> procesadas;
+
+	size_t _actorDe(const NumeroCuenta& numeroCuenta) const;
+	void _trabajar(Actor& actor);
+	void _procesar(Actor& actor, vector<Mensaje>& mensajes);
+
+public:
+	// 'hilos' = 0 usa todos los ncleos; cada buzn admite 'capacidadBuzon' operaciones en espera
+	ActoresCuentas(MGeneral& registro, size_t hilos = 0, size_t capacidadBuzon = 4096);
+	~ActoresCuentas();
+
+	ActoresCuentas(const ActoresCuentas&) = delete;
+	ActoresCuentas& operator=(const ActoresCuentas&) = delete;
+
+	size_t size() const;
+
+	// Seguros entre hilos. Si el buzn del actor est lleno, esperan a que tenga espacio;
+	// 'respuesta' se llama desde el hilo del actor con el estado final de la operacin
+	void enviar(const Operacion& operacion);
+	void enviar(const Operacion& operacion, const function<void(EstadoOperacion)>& respuesta);
+
+	// Espera a que se procesen todas las operaciones enviadas hasta el momento
+	void esperar();
+
+	// Totales de las operaciones procesadas hasta el momento
+	size_t getAplicadas() const;
+	size_t getRechazadas() const;
+};
+
+ActoresCuentas::ActoresCuentas(MGeneral& registro, size_t hilos, size_t capacidadBuzon)
+	: detener(false), enviadas(0), procesadas(0)
+{
+	if (hilos == 0)
+	{
+		hilos = max<size_t>(1, thread::hardware_concurrency());
+	}
+	for (size_t i = 0; i < hilos; ++i)
+	{
+		actores.emplace_back(new Actor(capacidadBuzon));
+	}
+
+	// Repartir las cuentas antes de arrancar los hilos: despus cada tabla es solo de su actor
+	for (Cliente* cliente : registro.getClientes())
+	{
+		cliente->aplicarCuentas([this](Cuenta& cuenta) {
+			NumeroCuenta numero = cuenta.getNumeroCuentaNumerico();
+			HashTable<Cuenta*, uint64_t>& tabla = actores[_actorDe(numero)]->cuentas;
+			if (!numero.empty() && !tabla.contains(numero.getValor()))
+			{
+				tabla.addElement(numero.getValor(), &cuenta);
+			}
+			});
+	}
+
+	for (auto& actor : actores)
+	{
+		actor->hilo = thread(&ActoresCuentas::_trabajar, this, ref(*actor));
+	}
+}
+
+ActoresCuentas::~ActoresCuentas()
+{
+	detener = true;
+	for (auto& actor : actores)
+	{
+		{
+			lock_guard<mutex> bloqueo(actor->m);
+		}
+		actor->cv.notify_one();
+	}
+	for (auto& actor : actores)
+	{
+		actor->hilo.join();
+	}
+}
+
+size_t ActoresCuentas::_actorDe(const NumeroCuenta& numeroCuenta) const
+{
+	return numeroCuenta.getValor() % actores.size();
+}
+
+void ActoresCuentas::_trabajar(Actor& actor)
+{
+	vector<Mensaje> mensajes;
+	Mensaje mensaje;
+	while (true)
+	{
+		while (mensajes.size() < LOTE && actor.buzon.tryPop(mensaje))
+		{
+			mensajes.push_back(move(mensaje));
+		}
+		if (!mensajes.empty())
+		{
+			_procesar(actor, mensajes);
+			mensajes.clear();
+			continue;
+		}
+		if (detener)
+		{
+			return;
+		}
+
+		// Buzn vaco: dormir hasta que llegue una operacin. 'dormido' se publica antes de
+		// volver a mirar el buzn y enviar() lo lee despus de encolar (con barreras en ambos
+		// lados), as no se pierde el aviso; la espera mxima es solo una red de seguridad
+		unique_lock<mutex> bloqueo(actor.m);
+		actor.dormido = true;
+		atomic_thread_fence(memory_order_seq_cst);
+		actor.cv.wait_for(bloqueo, chrono::milliseconds(10), [&actor, this]() {
+			return !actor.buzon.empty() || detener.load();
+			});
+		actor.dormido = false;
+	}
+}
+
+void ActoresCuentas::_procesar(Actor& actor, vector<Mensaje>& mensajes)
+{
+	// Agrupar por cuenta conservando el orden de llegada dentro de cada una
+	vector<Operacion> operaciones;
+	operaciones.reserve(mensajes.size());
+	for (Mensaje& m : mensajes)
+	{
+		operaciones.push_back(move(m.operacion));
+	}
+	vector<size_t> indices(operaciones.size());
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		indices[i] = i;
+	}
+	stable_sort(indices.begin(), indices.end(), [&operaciones](size_t a, size_t b) {
+		return operaciones[a].numeroCuenta < operaciones[b].numeroCuenta;
+		});
+
+	vector<EstadoOperacion> estados(operaciones.size(), EstadoOperacion::Pendiente);
+	for (size_t inicio = 0, fin; inicio < indices.size(); inicio = fin)
+	{
+		const string& numero = operaciones[indices[inicio]].numeroCuenta;
+		fin = inicio + 1;
+		while (fin < indices.size() && operaciones[indices[fin]].numeroCuenta == numero)
+		{
+			++fin;
+		}
+
+		NumeroCuenta clave(numero);
+		if (!actor.cuentas.contains(clave.getValor()))
+		{
+			for (size_t k = inicio; k < fin; ++k)
+			{
+				estados[indices[k]] = EstadoOperacion::CuentaInexistente;
+			}
+			continue;
+		}
+		actor.cuentas.getElement(clave.getValor())->aplicarLote(operaciones, indices.data() + inicio, fin - inicio, estados);
+	}
+
+	size_t aplicadas = 0;
+	for (size_t i = 0; i < mensajes.size(); ++i)
+	{
+		aplicadas += (estados[i] == EstadoOperacion::Aplicada) ? 1 : 0;
+		if (mensajes[i].respuesta)
+		{
+			mensajes[i].respuesta(estados[i]);
+		}
+	}
+	actor.aplicadas.fetch_add(aplicadas, memory_order_relaxed);
+	actor.rechazadas.fetch_add(mensajes.size() - aplicadas, memory_order_relaxed);
+	procesadas.fetch_add(mensajes.size(), memory_order_release);
+}
+
+size_t ActoresCuentas::size() const
+{
+	return actores.size();
+}
+
+void ActoresCuentas::enviar(const Operacion& operacion)
+{
+	enviar(operacion, nullptr);
+}
+
+void ActoresCuentas::enviar(const Operacion& operacion, const function<void(EstadoOperacion)>& respuesta)
+{
+	// Un nmero invlido queda vaco y su actor lo rechaza como cuenta inexistente
+	Actor& actor = *actores[_actorDe(NumeroCuenta(operacion.numeroCuenta))];
+	++enviadas;
+
+	Mensaje mensaje{ operacion, respuesta };
+	while (!actor.buzon.push(move(mensaje)))
+	{
+		this_thread::yield(); // Buzn lleno: el actor va atrasado
+	}
+
+	atomic_thread_fence(memory_order_seq_cst);
+	if (actor.dormido)
+	{
+		{
+			lock_guard<mutex> bloqueo(actor.m);
+		}
+		actor.cv.notify_one();
+	}
+}
+
+void ActoresCuentas::esperar()
+{
+	size_t objetivo = enviadas.load();
+	while (procesadas.load(memory_order_acquire) < objetivo)
+	{
+		this_thread::yield();
+	}
+}
+
+size_t ActoresCuentas::getAplicadas() const
+{
+	size_t total = 0;
+	for (const auto& actor : actores)
+	{
+		total += actor->aplicadas;
+	}
+	return total;
+}
+
+size_t ActoresCuentas::getRechazadas() const
+{
+	size_t total = 0;
+	for (const auto& actor : actores)
+	{
+		total += actor->rechazadas;
+	}
+	return total;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Generador pseudoaleatorio xoshiro256** (rpido, de 64 bits y con estado propio).
+//
+// A diferencia de rand(), cada objeto tiene su estado: con la misma semilla produce siempre
+// la misma secuencia y varios hilos pueden usar cada uno el suyo sin competir. Cumple los
+// requisitos de UniformRandomBitGenerator, as que tambin sirve con <random>.
+class Aleatorio
+{
+private:
+	uint64_t estado[4];
+
+	static uint64_t _rotar(uint64_t x, int k);
+	// Mezcla de splitmix64; convierte semillas parecidas (0, 1, 2...) en estados muy distintos
+	static uint64_t _mezclar(uint64_t& x);
+
+public:
+	using result_type = uint64_t;
+
+	Aleatorio(uint64_t semilla = 1);
+
+	void sembrar(uint64_t semilla);
+	// Generador independiente para la subsecuencia 'indice' de 'semilla': el resultado solo
+	// depende de ambos valores, no del orden ni del hilo en que se pida
+	static Aleatorio derivar(uint64_t semilla, uint64_t indice);
+
+	// Generador del hilo actual; se siembra al azar la primera vez que se usa en cada hilo
+	static Aleatorio& delHilo();
+
+	uint64_t siguiente();
+	uint64_t operator()() { return siguiente(); }
+	static constexpr uint64_t min() { return 0; }
+	static constexpr uint64_t max() { return UINT64_MAX; }
+
+	// Entero uniforme en [0, n); n debe ser mayor que 0
+	uint32_t entero(uint32_t n);
+	// Real uniforme en [0, 1)
+	double real();
+	// Real con distribucin normal estndar (media 0, desviacin 1)
+	double normal();
+};
+
+// Distribucin de Zipf sobre los rangos 1..n: el rango k sale con probabilidad proporcional a
+// 1 / k^exponente, as que unos pocos rangos bajos concentran la mayora de las muestras.
+// Se muestrea con una bsqueda binaria en la tabla acumulada, que se calcula una sola vez y
+// luego solo se lee (se puede compartir entre hilos).
+class DistribucionZipf
+{
+private:
+	std::vector<double> acumulada;  // acumulada[k - 1] = P(rango <= k)
+
+public:
+	DistribucionZipf(uint32_t n = 1, double exponente = 1.0);
+
+	uint32_t getN() const;
+	// Valor esperado de la muestra
+	double media() const;
+
+	uint32_t operator()(Aleatorio& aleatorio) const;
+};
+
+uint64_t Aleatorio::_rotar(uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+uint64_t Aleatorio::_mezclar(uint64_t& x)
+{
+	uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+Aleatorio::Aleatorio(uint64_t semilla)
+{
+	sembrar(semilla);
+}
+
+void Aleatorio::sembrar(uint64_t semilla)
+{
+	for (uint64_t& parte : estado)
+	{
+		parte = _mezclar(semilla);
+	}
+}
+
+Aleatorio Aleatorio::derivar(uint64_t semilla, uint64_t indice)
+{
+	uint64_t base = semilla;
+	uint64_t mezcla = _mezclar(base) ^ (indice * 0xD1B54A32D192ED03ull);
+	return Aleatorio(_mezclar(mezcla));
+}
+
+Aleatorio& Aleatorio::delHilo()
+{
+	thread_local Aleatorio generador((static_cast<uint64_t>(std::random_device()()) << 32) ^ std::random_device()());
+	return generador;
+}
+
+uint64_t Aleatorio::siguiente()
+{
+	uint64_t resultado = _rotar(estado[1] * 5, 7) * 9;
+	uint64_t t = estado[1] << 17;
+	estado[2] ^= estado[0];
+	estado[3] ^= estado[1];
+	estado[1] ^= estado[2];
+	estado[0] ^= estado[3];
+	estado[2] ^= t;
+	estado[3] = _rotar(estado[3], 45);
+	return resultado;
+}
+
+uint32_t Aleatorio::entero(uint32_t n)
+{
+	// Multiplicar en lugar de usar %: sin divisin y con sesgo despreciable para n < 2^32
+	return static_cast<uint32_t>(((siguiente() >> 32) * n) >> 32);
+}
+
+double Aleatorio::real()
+{
+	return (siguiente() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double Aleatorio::normal()
+{
+	// Box-Muller; 1 - real() est en (0, 1] y evita log(0)
+	double radio = std::sqrt(-2.0 * std::log(1.0 - real()));
+	return radio * std::cos(6.283185307179586 * real());
+}
+
+DistribucionZipf::DistribucionZipf(uint32_t n, double exponente)
+	: acumulada(std::max<uint32_t>(1, n))
+{
+	double total = 0;
+	for (size_t k = 0; k < acumulada.size(); ++k)
+	{
+		total += 1.0 / std::pow(static_cast<double>(k + 1), exponente);
+		acumulada[k] = total;
+	}
+	for (double& valor : acumulada)
+	{
+		valor /= total;
+	}
+}
+
+uint32_t DistribucionZipf::getN() const
+{
+	return static_cast<uint32_t>(acumulada.size());
+}
+
+double DistribucionZipf::media() const
+{
+	double suma = 0;
+	double anterior = 0;
+	for (size_t k = 0; k < acumulada.size(); ++k)
+	{
+		suma += (k + 1) * (acumulada[k] - anterior);
+		anterior = acumulada[k];
+	}
+	return suma;
+}
+
+uint32_t DistribucionZipf::operator()(Aleatorio& aleatorio) const
+{
+	auto rango = std::upper_bound(acumulada.begin(), acumulada.end(), aleatorio.real());
+	return static_cast<uint32_t>(std::min<size_t>(rango - acumulada.begin(), acumulada.size() - 1) + 1);
+}
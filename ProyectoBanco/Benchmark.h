@@ -0,0 +1,901 @@
+#pragma once
+
+#include "MGeneral.h"
+#include "ConcurrentQueue.h"
+#include "ActoresCuentas.h"
+#include "Operacion.h"
+#include "MotorSesiones.h"
+#include "GeneradorCarga.h"
+#include "GeneradorBanco.h"
+#include "MotorTransferencias.h"
+#include "ImportadorClientes.h"
+#include "ProcesadorLotes.h"
+#include "HistorialColumnar.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+// Benchmarks del proyecto. Se ejecutan desde la lnea de comandos (ejecutable Benchmarks); con
+// --metricas al final se muestran adems las mtricas del proceso (ver Metricas.h) y con
+// --memoria los bytes vivos por subsistema (ver Memoria.h):
+//   Benchmarks generador [--clientes N] [--hilos 1,2,4,8] [--semilla S] [perfil]
+//   Benchmarks generador --salida archivo [--formato texto|binario] [--quejas archivo] [--clientes N] [perfil]
+//     perfil: [--cuentas 1,3] [--zipf 2.0] [--max-transacciones N] [--mediana 50] [--dispersion 1.2]
+//             [--desde 2020] [--hasta 2024] [--tasa-quejas 0.02]
+//   Benchmarks importar --archivo archivo [--hilos 1,2,4,8] [--bloque B] (un archivo escrito por generador --salida)
+//   Benchmarks reporte [--clientes N] [--hilos 1,2,4,8] [--repeticiones R]
+//   Benchmarks cola [--clientes N] [--operaciones N] [--hilos 1,2,4,8]
+//   Benchmarks actores [--clientes N] [--operaciones N] [--hilos 1,2,4,8] [--productores P]
+//   Benchmarks lotes [--clientes N] [--operaciones N] [--hilos 1,2,4,8] [--archivo Operaciones.txt]
+//   Benchmarks columnar [--clientes N] [--archivo Historial.col]
+//   Benchmarks transferencias [--cuentas N] [--hilos 1,2,4,8] [--transferencias N]
+//   Benchmarks sesiones [--sesiones N] [--guion archivo]
+//   Benchmarks carga [--direccion unix:/ruta|tcp:puerto] [--conexiones C] [--peticiones N]
+class Benchmark
+{
+private:
+	// Retorna el mejor tiempo (en segundos) de 'repeticiones' ejecuciones
+	static double _medir(const function<void()>& operacion, size_t repeticiones);
+	static vector<size_t> _parsearLista(const string& lista);
+	static string _opcion(const vector<string>& argumentos, const string& nombre, const string& defecto);
+	// Huella del banco independiente del orden de la tabla: suma de los hashes de cada cliente
+	static size_t _huella(MGeneral& registro);
+	// Perfil de GeneradorBanco a partir de las opciones (las que faltan toman el valor por defecto)
+	static PerfilBanco _perfil(const vector<string>& argumentos);
+	// Depsitos y retiros al azar sobre las cuentas del registro
+	static vector<Operacion> _generarOperaciones(MGeneral& registro, size_t cantidad, unsigned semilla);
+
+public:
+	// Genera y registra 'clientes' clientes con un GeneradorBanco de semilla fija (siempre el mismo banco)
+	static void generarBanco(MGeneral& registro, size_t clientes);
+
+	// Genera el mismo banco con cada cantidad de 'hilos'; reporta clientes por segundo y
+	// verifica que todos los bancos sean idnticos
+	static int generador(size_t clientes, const vector<size_t>& hilos, uint64_t semilla, const PerfilBanco& perfil);
+
+	// Escribe un banco de 'clientes' clientes en 'salida' (y sus quejas en 'archivoQuejas' si no
+	// est vaco) sin mantenerlo en memoria; reporta transacciones por segundo
+	static int volcar(size_t clientes, uint64_t semilla, const PerfilBanco& perfil, const string& salida,
+		FormatoVolcado formato, const string& archivoQuejas);
+
+	// Importa 'archivo' con un ImportadorClientes de bloques de 'bloque' bytes, primero en serie y
+	// luego en paralelo con cada cantidad de 'hilos'; reporta registros por segundo y lneas
+	// malformadas y verifica que cada importacin paralela deje el mismo registro que la serial
+	static int importar(const string& archivo, const vector<size_t>& hilos, size_t bloque);
+
+	// Reporte de todo el banco con 1 hilo (secuencial) y con un ThreadPool de cada tamao de 'hilos'
+	static int reporte(size_t clientes, const vector<size_t>& hilos, size_t repeticiones);
+
+	// Productores que encolan operaciones en una ConcurrentQueue y consumidores que las aplican a
+	// las cuentas; para cada valor de 'hilos' se usan esa cantidad de productores y de consumidores
+	static int cola(size_t clientes, size_t operaciones, const vector<size_t>& hilos);
+
+	// Enva las operaciones a un ActoresCuentas con cada cantidad de 'hilos' desde 'productores'
+	// hilos, cada vez sobre el mismo banco recin generado. Con un solo productor el orden por
+	// cuenta est definido y se verifica el estado de cada operacin y el banco final contra
+	// Cuenta::aplicarLote aplicado operacin por operacin
+	static int actores(size_t clientes, size_t operaciones, const vector<size_t>& hilos, size_t productores);
+
+	// Guarda un lote de 'operaciones' operaciones en 'archivo', lo vuelve a cargar y lo procesa
+	// con un ProcesadorLotes para cada cantidad de 'hilos' sobre el mismo banco recin generado;
+	// verifica cada resultado contra la aplicacin secuencial de las operaciones una por una
+	static int lotes(size_t clientes, size_t operaciones, const vector<size_t>& hilos, const string& archivo);
+
+	// Exporta el historial de todas las cuentas a un HistorialColumnar en 'archivo', lo vuelve a
+	// leer (todas las columnas y solo MONTO) y compara; verifica adems que se rechace el archivo truncado
+	static int columnar(size_t clientes, const string& archivo);
+
+	// Transferencias aleatorias entre 'cuentas' cuentas con un MotorTransferencias para cada
+	// cantidad de 'hilos'; falla si alguna auditora encontr que el dinero total cambi
+	static int transferencias(size_t cuentas, const vector<size_t>& hilos, size_t transferencias);
+
+	// Abre 'sesiones' mens de cliente en un MotorSesiones y les entrega el guion (una entrada
+	// por lnea) intercalando las sesiones lnea a lnea, como si escribieran a la vez
+	static int sesiones(size_t sesiones, const vector<string>& guion);
+
+	// Carga contra un ServidorBanco en marcha (ProyectoBanco --servidor) con cada cantidad de
+	// 'conexiones'; reporta peticiones por segundo y latencias p50/p99
+	static int carga(const string& direccion, const vector<size_t>& conexiones, size_t peticiones);
+
+	// Interpreta los argumentos de main (argv[1] es el nombre del benchmark) y lo ejecuta
+	static int ejecutar(int argc, char* argv[]);
+};
+
+double Benchmark::_medir(const function<void()>& operacion, size_t repeticiones)
+{
+	double mejor = 0;
+	for (size_t r = 0; r < max<size_t>(1, repeticiones); ++r)
+	{
+		auto inicio = chrono::steady_clock::now();
+		operacion();
+		double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+		if (r == 0 || segundos < mejor)
+		{
+			mejor = segundos;
+		}
+	}
+	return mejor;
+}
+
+vector<size_t> Benchmark::_parsearLista(const string& lista)
+{
+	vector<size_t> valores;
+	istringstream in(lista);
+	string valor;
+	while (getline(in, valor, ','))
+	{
+		if (!valor.empty())
+		{
+			valores.push_back(stoul(valor));
+		}
+	}
+	return valores;
+}
+
+string Benchmark::_opcion(const vector<string>& argumentos, const string& nombre, const string& defecto)
+{
+	for (size_t i = 0; i + 1 < argumentos.size(); ++i)
+	{
+		if (argumentos[i] == nombre)
+		{
+			return argumentos[i + 1];
+		}
+	}
+	return defecto;
+}
+
+size_t Benchmark::_huella(MGeneral& registro)
+{
+	size_t huella = 0;
+	registro.apply([&](Cliente& cliente) { huella += hash<string>()(cliente.toSave()); });
+	return huella;
+}
+
+PerfilBanco Benchmark::_perfil(const vector<string>& argumentos)
+{
+	PerfilBanco perfil;
+	vector<size_t> cuentas = _parsearLista(_opcion(argumentos, "--cuentas", "1,3"));
+	if (cuentas.size() != 2)
+	{
+		throw runtime_error("--cuentas espera minimo,maximo");
+	}
+	perfil.minCuentas = cuentas[0];
+	perfil.maxCuentas = cuentas[1];
+	perfil.exponenteActividad = stod(_opcion(argumentos, "--zipf", to_string(perfil.exponenteActividad)));
+	perfil.maxTransacciones = stoul(_opcion(argumentos, "--max-transacciones", to_string(perfil.maxTransacciones)));
+	perfil.medianaMonto = stod(_opcion(argumentos, "--mediana", to_string(perfil.medianaMonto)));
+	perfil.dispersionMonto = stod(_opcion(argumentos, "--dispersion", to_string(perfil.dispersionMonto)));
+	perfil.fechaInicio = Fecha(1, 1, stoi(_opcion(argumentos, "--desde", to_string(perfil.fechaInicio.getAnio()))));
+	perfil.fechaFin = Fecha(31, 12, stoi(_opcion(argumentos, "--hasta", to_string(perfil.fechaFin.getAnio()))));
+	perfil.tasaQuejas = stod(_opcion(argumentos, "--tasa-quejas", to_string(perfil.tasaQuejas)));
+	if (!perfil.valido())
+	{
+		throw runtime_error("perfil invalido: " + perfil.toDebug());
+	}
+	return perfil;
+}
+
+vector<Operacion> Benchmark::_generarOperaciones(MGeneral& registro, size_t cantidad, unsigned semilla)
+{
+	vector<string> numeros;
+	for (Cliente* cliente : registro.getClientes())
+	{
+		cliente->aplicarCuentas([&numeros](Cuenta& cuenta) { numeros.push_back(cuenta.getNumeroCuenta()); });
+	}
+
+	mt19937 generador(semilla);
+	vector<Operacion> operaciones;
+	operaciones.reserve(cantidad);
+	for (size_t k = 0; k < cantidad; ++k)
+	{
+		Monto monto;
+		monto.setTotalCentimos(1 + generador() % 10000);
+		TipoTransaccion tipo = (generador() & 1) ? TipoTransaccion::Deposito : TipoTransaccion::Retiro;
+		operaciones.emplace_back(numeros[generador() % numeros.size()], Transaccion(monto, registro.getFechaActual(), tipo));
+	}
+	return operaciones;
+}
+
+void Benchmark::generarBanco(MGeneral& registro, size_t clientes)
+{
+	GeneradorBanco(1).generar(registro, clientes);
+}
+
+int Benchmark::generador(size_t clientes, const vector<size_t>& hilos, uint64_t semilla, const PerfilBanco& perfil)
+{
+	cout << perfil.toDebug() << "\n\n";
+	cout << setw(8) << "hilos" << setw(14) << "segundos" << setw(18) << "clientes/s"
+		<< setw(12) << "cuentas" << setw(16) << "transacciones" << setw(20) << "huella" << '\n';
+
+	int codigo = 0;
+	size_t huellaEsperada = 0;
+	for (size_t i = 0; i < hilos.size(); ++i)
+	{
+		MGeneral registro;
+		GeneradorBanco generadorBanco(semilla, hilos[i]);
+		generadorBanco.setPerfil(perfil);
+		ResultadoGeneracion resultado = generadorBanco.generar(registro, clientes);
+
+		size_t huella = _huella(registro);
+
+		cout << setw(8) << hilos[i] << setw(14) << fixed << setprecision(3) << resultado.segundos
+			<< setw(18) << setprecision(0) << resultado.clientesPorSegundo()
+			<< setw(12) << resultado.cuentas << setw(16) << resultado.transacciones
+			<< setw(20) << hex << huella << dec << '\n';
+
+		if (i == 0)
+		{
+			huellaEsperada = huella;
+		}
+		else if (huella != huellaEsperada)
+		{
+			cerr << "El banco generado con " << hilos[i] << " hilos es distinto al de " << hilos[0] << '\n';
+			codigo = 1;
+		}
+	}
+	return codigo;
+}
+
+int Benchmark::volcar(size_t clientes, uint64_t semilla, const PerfilBanco& perfil, const string& salida,
+	FormatoVolcado formato, const string& archivoQuejas)
+{
+	ofstream out(salida, ios::binary);
+	ofstream outQuejas;
+	if (!archivoQuejas.empty())
+	{
+		outQuejas.open(archivoQuejas, ios::binary);
+	}
+	if (!out || (!archivoQuejas.empty() && !outQuejas))
+	{
+		cerr << "No se pudo crear el archivo de salida\n";
+		return 1;
+	}
+
+	GeneradorBanco generadorBanco(semilla);
+	generadorBanco.setPerfil(perfil);
+	cout << perfil.toDebug() << '\n';
+	ResultadoGeneracion resultado = generadorBanco.escribir(out, clientes, formato,
+		archivoQuejas.empty() ? nullptr : &outQuejas);
+	cout << resultado.toDebug() << '\n';
+	cout << "Transacciones/s: " << fixed << setprecision(0) << resultado.transaccionesPorSegundo()
+		<< ", MB/s: " << setprecision(1) << resultado.bytes / 1e6 / max(resultado.segundos, 1e-9) << '\n';
+
+	if (!out || resultado.registrados < clientes)
+	{
+		cerr << "Error al escribir " << salida << '\n';
+		return 1;
+	}
+	return 0;
+}
+
+int Benchmark::importar(const string& archivo, const vector<size_t>& hilos, size_t bloque)
+{
+	cout << setw(8) << "hilos" << setw(14) << "segundos" << setw(16) << "registros/s" << setw(10) << "MB/s"
+		<< setw(12) << "registros" << setw(14) << "malformados" << setw(12) << "duplicados" << '\n';
+
+	int codigo = 0;
+	size_t huellaSerial = 0;
+	ResultadoImportacion serial;
+	for (size_t i = 0; i <= hilos.size(); ++i)
+	{
+		MGeneral registro;
+		ImportadorClientes importador(registro.getFechaActual(), bloque);
+		ResultadoImportacion resultado;
+		try
+		{
+			resultado = i == 0 ? importador.importar(archivo, registro) : importador.importarParalelo(archivo, registro, hilos[i - 1]);
+		}
+		catch (const exception& e)
+		{
+			cerr << e.what() << '\n';
+			return 1;
+		}
+
+		cout << setw(8) << (i == 0 ? "serial" : to_string(hilos[i - 1])) << setw(14) << fixed << setprecision(4) << resultado.segundos
+			<< setw(16) << setprecision(0) << resultado.registrosPorSegundo()
+			<< setw(10) << setprecision(1) << resultado.bytes / 1e6 / max(resultado.segundos, 1e-9)
+			<< setw(12) << resultado.registros << setw(14) << resultado.malformados << setw(12) << resultado.duplicados;
+
+		size_t huella = _huella(registro);
+		if (i == 0)
+		{
+			serial = resultado;
+			huellaSerial = huella;
+		}
+		else if (huella != huellaSerial || resultado.registros != serial.registros
+			|| resultado.malformados != serial.malformados || resultado.duplicados != serial.duplicados
+			|| resultado.bytes != serial.bytes)
+		{
+			cout << "  ERROR: el registro no coincide con el de la importacion serial";
+			codigo = 1;
+		}
+		cout << '\n';
+	}
+	return codigo;
+}
+
+int Benchmark::reporte(size_t clientes, const vector<size_t>& hilos, size_t repeticiones)
+{
+	MGeneral registro;
+	cout << "Generando " << clientes << " clientes...\n";
+	double generacion = _medir([&]() { generarBanco(registro, clientes); }, 1);
+	cout << "Generacion: " << fixed << setprecision(2) << generacion << " s, "
+		<< registro.getNumeroCuentas() << " cuentas\n\n";
+
+	ReporteBanco esperado;
+	double base = _medir([&]() { esperado = registro.generarReporte(); }, repeticiones);
+
+	cout << setw(8) << "hilos" << setw(14) << "segundos" << setw(18) << "clientes/s" << setw(14) << "aceleracion" << '\n';
+	cout << setw(8) << "serial" << setw(14) << setprecision(4) << base
+		<< setw(18) << setprecision(0) << clientes / base << setw(14) << setprecision(2) << 1.0 << '\n';
+
+	int codigo = 0;
+	for (size_t n : hilos)
+	{
+		ThreadPool pool(n);
+		ReporteBanco obtenido;
+		double segundos = _medir([&]() { obtenido = registro.generarReporte(pool); }, repeticiones);
+
+		cout << setw(8) << n << setw(14) << setprecision(4) << segundos
+			<< setw(18) << setprecision(0) << clientes / segundos
+			<< setw(14) << setprecision(2) << base / segundos;
+		if (obtenido.toDebug() != esperado.toDebug())
+		{
+			cout << "  ERROR: el reporte no coincide con el secuencial";
+			codigo = 1;
+		}
+		cout << '\n';
+	}
+
+	cout << '\n' << esperado.toShow();
+	return codigo;
+}
+
+int Benchmark::cola(size_t clientes, size_t operaciones, const vector<size_t>& hilos)
+{
+	MGeneral registro;
+	generarBanco(registro, clientes);
+	vector<string> numeros;
+	for (Cliente* cliente : registro.getClientes())
+	{
+		cliente->aplicarCuentas([&numeros](Cuenta& cuenta) { numeros.push_back(cuenta.getNumeroCuenta()); });
+	}
+
+	cout << setw(12) << "productores" << setw(14) << "consumidores" << setw(14) << "segundos" << setw(18) << "operaciones/s" << '\n';
+	for (size_t n : hilos)
+	{
+		ConcurrentQueue<Operacion> entrada(4096);
+		atomic<size_t> consumidas(0);
+		vector<thread> trabajadores;
+
+		auto inicio = chrono::steady_clock::now();
+		for (size_t p = 0; p < n; ++p)
+		{
+			size_t cantidad = operaciones / n + (p < operaciones % n ? 1 : 0);
+			trabajadores.emplace_back([&, p, cantidad]() {
+				mt19937 generador(static_cast<unsigned>(p + 1));
+				for (size_t k = 0; k < cantidad; ++k)
+				{
+					Monto monto;
+					monto.setTotalCentimos(1 + generador() % 10000);
+					TipoTransaccion tipo = (generador() & 1) ? TipoTransaccion::Deposito : TipoTransaccion::Retiro;
+					Operacion operacion(numeros[generador() % numeros.size()], Transaccion(monto, registro.getFechaActual(), tipo));
+					while (!entrada.push(move(operacion)))
+					{
+						this_thread::yield(); // Cola llena: los consumidores van atrasados
+					}
+				}
+				});
+		}
+		for (size_t c = 0; c < n; ++c)
+		{
+			trabajadores.emplace_back([&]() {
+				Operacion operacion;
+				while (consumidas.load() < operaciones)
+				{
+					if (!entrada.tryPop(operacion))
+					{
+						this_thread::yield();
+						continue;
+					}
+					Cuenta* cuenta = registro.getCuenta(operacion.numeroCuenta);
+					const Transaccion& transaccion = operacion.transaccion;
+					if (transaccion.getTipo() == TipoTransaccion::Deposito)
+					{
+						cuenta->depositar(transaccion.getFechaEmision(), transaccion.getMontoMonto());
+					}
+					else
+					{
+						cuenta->retirar(transaccion.getFechaEmision(), transaccion.getMontoMonto());
+					}
+					++consumidas;
+				}
+				});
+		}
+		for (auto& trabajador : trabajadores)
+		{
+			trabajador.join();
+		}
+		double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+		cout << setw(12) << n << setw(14) << n << setw(14) << fixed << setprecision(4) << segundos
+			<< setw(18) << setprecision(0) << operaciones / segundos << '\n';
+	}
+	return 0;
+}
+
+int Benchmark::actores(size_t clientes, size_t operaciones, const vector<size_t>& hilos, size_t productores)
+{
+	vector<Operacion> lote;
+	vector<EstadoOperacion> esperados(operaciones, EstadoOperacion::Pendiente);
+	size_t huellaEsperada = 0;
+	{
+		MGeneral secuencial;
+		generarBanco(secuencial, clientes);
+		lote = _generarOperaciones(secuencial, operaciones, 1);
+		for (size_t i = 0; i < lote.size(); ++i)
+		{
+			Cuenta* cuenta = secuencial.getCuenta(lote[i].numeroCuenta);
+			if (cuenta == nullptr)
+			{
+				esperados[i] = EstadoOperacion::CuentaInexistente;
+				continue;
+			}
+			cuenta->aplicarLote(lote, &i, 1, esperados);
+		}
+		huellaEsperada = _huella(secuencial);
+	}
+	productores = max<size_t>(1, productores);
+	if (productores > 1)
+	{
+		cout << "Con " << productores << " productores el orden por cuenta no esta definido: solo se verifican los totales\n";
+	}
+
+	cout << setw(8) << "hilos" << setw(14) << "segundos" << setw(18) << "operaciones/s" << setw(12) << "aplicadas" << '\n';
+	int codigo = 0;
+	for (size_t n : hilos)
+	{
+		MGeneral registro;
+		generarBanco(registro, clientes);
+		vector<EstadoOperacion> estados(lote.size(), EstadoOperacion::Pendiente);
+		ActoresCuentas actores(registro, n);
+		auto inicio = chrono::steady_clock::now();
+
+		vector<thread> enviadores;
+		for (size_t p = 0; p < productores; ++p)
+		{
+			enviadores.emplace_back([&, p]() {
+				for (size_t k = p; k < lote.size(); k += productores)
+				{
+					EstadoOperacion* estado = &estados[k];
+					actores.enviar(lote[k], [estado](EstadoOperacion resultado) { *estado = resultado; });
+				}
+				});
+		}
+		for (auto& enviador : enviadores)
+		{
+			enviador.join();
+		}
+		actores.esperar();
+		double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+		cout << setw(8) << n << setw(14) << fixed << setprecision(4) << segundos
+			<< setw(18) << setprecision(0) << operaciones / segundos << setw(12) << actores.getAplicadas();
+		if (actores.getAplicadas() + actores.getRechazadas() != operaciones)
+		{
+			cout << "  ERROR: no se procesaron todas las operaciones";
+			codigo = 1;
+		}
+		else if (productores == 1 && (estados != esperados || _huella(registro) != huellaEsperada))
+		{
+			cout << "  ERROR: el resultado no coincide con la aplicacion secuencial";
+			codigo = 1;
+		}
+		cout << '\n';
+	}
+	return codigo;
+}
+
+int Benchmark::lotes(size_t clientes, size_t operaciones, const vector<size_t>& hilos, const string& archivo)
+{
+	vector<Operacion> lote;
+	{
+		MGeneral registro;
+		generarBanco(registro, clientes);
+		lote = _generarOperaciones(registro, operaciones, 1);
+	}
+
+	// Ida y vuelta por archivo: el lote procesado es el que se carg
+	vector<Operacion> cargado;
+	bool escrito = false;
+	double guardado = _medir([&]() { escrito = ProcesadorLotes::guardarArchivo(archivo, lote); }, 1);
+	if (!escrito)
+	{
+		return 1;
+	}
+	try
+	{
+		double carga = _medir([&]() { cargado = ProcesadorLotes::cargarArchivo(archivo); }, 1);
+		cout << "Archivo " << archivo << ": guardado " << fixed << setprecision(4) << guardado
+			<< " s, carga " << carga << " s\n";
+	}
+	catch (const exception& e)
+	{
+		cerr << e.what() << '\n';
+		return 1;
+	}
+	bool igual = cargado.size() == lote.size();
+	for (size_t i = 0; igual && i < lote.size(); ++i)
+	{
+		igual = cargado[i].toSave() == lote[i].toSave();
+	}
+	if (!igual)
+	{
+		cerr << "El lote cargado de " << archivo << " no coincide con el guardado\n";
+		return 1;
+	}
+
+	// Referencia: las operaciones aplicadas una por una en el orden del lote
+	MGeneral secuencial;
+	generarBanco(secuencial, clientes);
+	vector<bool> esperadas(cargado.size(), false);
+	size_t aplicadasEsperadas = 0;
+	double base = _medir([&]() {
+		for (size_t i = 0; i < cargado.size(); ++i)
+		{
+			Cuenta* cuenta = secuencial.getCuenta(cargado[i].numeroCuenta);
+			const Transaccion& transaccion = cargado[i].transaccion;
+			if (cuenta != nullptr)
+			{
+				esperadas[i] = transaccion.getTipo() == TipoTransaccion::Deposito
+					? cuenta->depositar(transaccion.getFechaEmision(), transaccion.getMontoMonto())
+					: cuenta->retirar(transaccion.getFechaEmision(), transaccion.getMontoMonto());
+				aplicadasEsperadas += esperadas[i] ? 1 : 0;
+			}
+		}
+		}, 1);
+	size_t huellaEsperada = _huella(secuencial);
+
+	cout << setw(8) << "hilos" << setw(14) << "segundos" << setw(18) << "operaciones/s"
+		<< setw(12) << "aplicadas" << setw(12) << "rechazadas" << setw(10) << "cuentas" << '\n';
+	cout << setw(8) << "serial" << setw(14) << setprecision(4) << base << setw(18) << setprecision(0)
+		<< cargado.size() / max(base, 1e-9) << setw(12) << aplicadasEsperadas
+		<< setw(12) << cargado.size() - aplicadasEsperadas << setw(10) << "-" << '\n';
+
+	int codigo = 0;
+	for (size_t n : hilos)
+	{
+		MGeneral registro;
+		generarBanco(registro, clientes);
+		ResultadoLote resultado = ProcesadorLotes(registro).procesar(cargado, n);
+
+		cout << setw(8) << n << setw(14) << setprecision(4) << resultado.segundos
+			<< setw(18) << setprecision(0) << resultado.operacionesPorSegundo()
+			<< setw(12) << resultado.aplicadas << setw(12) << resultado.rechazadas << setw(10) << resultado.cuentas;
+		bool coincide = resultado.aplicadas == aplicadasEsperadas && _huella(registro) == huellaEsperada;
+		for (size_t i = 0; coincide && i < cargado.size(); ++i)
+		{
+			coincide = (resultado.estados[i] == EstadoOperacion::Aplicada) == esperadas[i];
+		}
+		if (!coincide)
+		{
+			cout << "  ERROR: el resultado no coincide con la aplicacion secuencial";
+			codigo = 1;
+		}
+		cout << '\n';
+	}
+	return codigo;
+}
+
+int Benchmark::columnar(size_t clientes, const string& archivo)
+{
+	MGeneral registro;
+	generarBanco(registro, clientes);
+
+	HistorialColumnar exportado(archivo);
+	double agregado = _medir([&]() {
+		exportado.clear();
+		registro.apply([&](Cliente& cliente) { cliente.aplicarCuentas([&](Cuenta& cuenta) { exportado.agregarCuenta(cuenta); }); });
+		}, 1);
+	bool guardado = false;
+	double escritura = _medir([&]() { guardado = exportado.saveToFile(); }, 1);
+	if (!guardado)
+	{
+		return 1;
+	}
+
+	HistorialColumnar completo(archivo);
+	HistorialColumnar soloMontos(archivo, ColumnasHistorial::MONTO);
+	bool leidos = false;
+	double lectura = _medir([&]() { leidos = completo.loadFromFile(); }, 1);
+	double lecturaMontos = _medir([&]() { leidos = leidos && soloMontos.loadFromFile(); }, 1);
+
+	cout << setw(12) << "filas" << setw(14) << "agregar s" << setw(14) << "guardar s" << setw(14) << "cargar s"
+		<< setw(16) << "cargar monto s" << '\n';
+	cout << setw(12) << exportado.size() << setw(14) << fixed << setprecision(4) << agregado << setw(14) << escritura
+		<< setw(14) << lectura << setw(16) << lecturaMontos << '\n';
+
+	int codigo = 0;
+	if (!leidos || completo.size() != exportado.size() || completo.getCuentas() != exportado.getCuentas()
+		|| completo.getTipos() != exportado.getTipos() || completo.getFechas() != exportado.getFechas()
+		|| completo.getMontos() != exportado.getMontos())
+	{
+		cerr << "ERROR: el historial leido de " << archivo << " no coincide con el exportado\n";
+		codigo = 1;
+	}
+	if (soloMontos.getMontos() != exportado.getMontos() || !soloMontos.getCuentas().empty())
+	{
+		cerr << "ERROR: la lectura de solo la columna monto no coincide\n";
+		codigo = 1;
+	}
+
+	// Un archivo cortado a la mitad declara ms filas de las que contiene
+	if (exportado.size() > 0)
+	{
+		string truncado = archivo + ".truncado";
+		{
+			ifstream in(archivo, ios::binary);
+			string datos((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+			ofstream out(truncado, ios::binary | ios::trunc);
+			out.write(datos.data(), static_cast<streamsize>(datos.size() / 2));
+		}
+		HistorialColumnar danado(truncado);
+		if (danado.loadFromFile() || !danado.empty())
+		{
+			cerr << "ERROR: se acepto el historial truncado " << truncado << '\n';
+			codigo = 1;
+		}
+		remove(truncado.c_str());
+	}
+	return codigo;
+}
+
+int Benchmark::transferencias(size_t cuentas, const vector<size_t>& hilos, size_t transferencias)
+{
+	// Cada cliente generado tiene al menos una cuenta: con 'cuentas' clientes alcanza
+	MGeneral registro;
+	generarBanco(registro, cuentas);
+	vector<Cuenta*> seleccion;
+	for (Cliente* cliente : registro.getClientes())
+	{
+		cliente->aplicarCuentas([&](Cuenta& cuenta) {
+			if (seleccion.size() < cuentas)
+			{
+				seleccion.push_back(&cuenta);
+			}
+			});
+	}
+
+	cout << setw(8) << "hilos" << setw(14) << "segundos" << setw(20) << "transferencias/s"
+		<< setw(12) << "exitosas" << setw(12) << "rechazadas" << setw(12) << "auditorias" << '\n';
+	int codigo = 0;
+	for (size_t n : hilos)
+	{
+		MotorTransferencias motor(registro.getFechaActual());
+		ResultadoTransferencias resultado = motor.estresar(seleccion, n, transferencias);
+		cout << setw(8) << n << setw(14) << fixed << setprecision(4) << resultado.segundos
+			<< setw(20) << setprecision(0) << resultado.transferenciasPorSegundo()
+			<< setw(12) << resultado.exitosas << setw(12) << resultado.rechazadas << setw(12) << resultado.auditorias;
+		if (!resultado.conservado())
+		{
+			cout << "  ERROR: " << resultado.descuadres << " descuadres, total " << resultado.totalInicial
+				<< " -> " << resultado.totalFinal;
+			codigo = 1;
+		}
+		else if (resultado.exitosas + resultado.rechazadas != transferencias)
+		{
+			cout << "  ERROR: no se procesaron todas las transferencias";
+			codigo = 1;
+		}
+		cout << '\n';
+	}
+	return codigo;
+}
+
+int Benchmark::sesiones(size_t sesiones, const vector<string>& guion)
+{
+	vector<shared_ptr<Cliente>> clientes;
+	clientes.reserve(sesiones);
+	Aleatorio aleatorio(1);
+	for (size_t i = 0; i < sesiones; ++i)
+	{
+		clientes.push_back(make_shared<Cliente>());
+		clientes.back()->generateRandom(aleatorio);
+	}
+
+	MotorSesiones motor;
+	size_t bytes = 0;
+	auto inicio = chrono::steady_clock::now();
+	for (size_t i = 0; i < sesiones; ++i)
+	{
+		shared_ptr<Cliente> cliente = clientes[i];
+		motor.abrir(i, [cliente](Sesion& sesion) { return cliente->interactuar(sesion); });
+		bytes += motor.tomarSalida(i).size();
+	}
+	size_t maximoActivas = motor.getActivas();
+	for (const string& linea : guion)
+	{
+		for (size_t i = 0; i < sesiones; ++i)
+		{
+			motor.entregar(i, linea);
+			bytes += motor.tomarSalida(i).size();
+		}
+	}
+	for (size_t i = 0; i < sesiones; ++i)
+	{
+		motor.cerrar(i);
+	}
+	double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+	size_t lineas = sesiones * guion.size();
+	cout << setw(10) << "sesiones" << setw(14) << "segundos" << setw(14) << "lineas/s" << setw(14) << "MB salida" << '\n';
+	cout << setw(10) << sesiones << setw(14) << fixed << setprecision(4) << segundos
+		<< setw(14) << setprecision(0) << lineas / segundos
+		<< setw(14) << setprecision(2) << bytes / (1024.0 * 1024.0) << '\n';
+	cout << "Sesiones abiertas a la vez: " << maximoActivas << ", terminadas: " << motor.getTerminadas() << '\n';
+	return motor.getTerminadas() == sesiones ? 0 : 1;
+}
+
+int Benchmark::carga(const string& direccion, const vector<size_t>& conexiones, size_t peticiones)
+{
+	cout << setw(12) << "conexiones" << setw(14) << "segundos" << setw(16) << "peticiones/s"
+		<< setw(12) << "p50 us" << setw(12) << "p99 us" << setw(12) << "max us" << setw(12) << "rechazadas" << '\n';
+	int codigo = 0;
+	for (size_t n : conexiones)
+	{
+		GeneradorCarga generador(direccion, n);
+		ResultadoCarga resultado = generador.ejecutar(peticiones);
+		cout << setw(12) << n << setw(14) << fixed << setprecision(4) << resultado.segundos
+			<< setw(16) << setprecision(0) << resultado.peticiones / max(resultado.segundos, 1e-9)
+			<< setw(12) << setprecision(1) << resultado.p50 << setw(12) << resultado.p99
+			<< setw(12) << resultado.maxima << setw(12) << resultado.rechazadas;
+		if (!resultado.completo)
+		{
+			cout << "  ERROR: solo se completaron " << resultado.peticiones << " peticiones";
+			codigo = 1;
+		}
+		cout << '\n';
+	}
+	return codigo;
+}
+
+int Benchmark::ejecutar(int argc, char* argv[])
+{
+	vector<string> argumentos(argv + 1, argv + argc);
+	string nombre = argumentos.empty() ? "" : argumentos[0];
+
+	try
+	{
+		if (nombre == "generador")
+		{
+			size_t clientes = stoul(_opcion(argumentos, "--clientes", "1000000"));
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			uint64_t semilla = stoull(_opcion(argumentos, "--semilla", "1"));
+			PerfilBanco perfil = _perfil(argumentos);
+			string salida = _opcion(argumentos, "--salida", "");
+			if (!salida.empty())
+			{
+				string formato = _opcion(argumentos, "--formato", "texto");
+				if (formato != "texto" && formato != "binario")
+				{
+					throw runtime_error("formato desconocido " + formato);
+				}
+				return volcar(clientes, semilla, perfil, salida,
+					formato == "texto" ? FormatoVolcado::Texto : FormatoVolcado::Binario, _opcion(argumentos, "--quejas", ""));
+			}
+			return generador(clientes, hilos, semilla, perfil);
+		}
+		if (nombre == "importar")
+		{
+			string archivo = _opcion(argumentos, "--archivo", "");
+			if (archivo.empty())
+			{
+				throw runtime_error("falta --archivo");
+			}
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			size_t bloque = stoul(_opcion(argumentos, "--bloque", to_string(1 << 20)));
+			return importar(archivo, hilos, bloque);
+		}
+		if (nombre == "reporte")
+		{
+			size_t clientes = stoul(_opcion(argumentos, "--clientes", "1000000"));
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			size_t repeticiones = stoul(_opcion(argumentos, "--repeticiones", "3"));
+			return reporte(clientes, hilos, repeticiones);
+		}
+		if (nombre == "cola")
+		{
+			size_t clientes = stoul(_opcion(argumentos, "--clientes", "10000"));
+			size_t operaciones = stoul(_opcion(argumentos, "--operaciones", "1000000"));
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			return cola(clientes, operaciones, hilos);
+		}
+		if (nombre == "actores")
+		{
+			size_t clientes = stoul(_opcion(argumentos, "--clientes", "10000"));
+			size_t operaciones = stoul(_opcion(argumentos, "--operaciones", "1000000"));
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			size_t productores = stoul(_opcion(argumentos, "--productores", "1"));
+			return actores(clientes, operaciones, hilos, productores);
+		}
+		if (nombre == "lotes")
+		{
+			size_t clientes = stoul(_opcion(argumentos, "--clientes", "10000"));
+			size_t operaciones = stoul(_opcion(argumentos, "--operaciones", "1000000"));
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			return lotes(clientes, operaciones, hilos, _opcion(argumentos, "--archivo", "Operaciones.txt"));
+		}
+		if (nombre == "columnar")
+		{
+			size_t clientes = stoul(_opcion(argumentos, "--clientes", "100000"));
+			return columnar(clientes, _opcion(argumentos, "--archivo", "Historial.col"));
+		}
+		if (nombre == "transferencias")
+		{
+			size_t cuentas = stoul(_opcion(argumentos, "--cuentas", "10000"));
+			size_t nucleos = max<size_t>(1, thread::hardware_concurrency());
+			vector<size_t> hilos = _parsearLista(_opcion(argumentos, "--hilos", "1,2,4," + to_string(nucleos)));
+			size_t cantidad = stoul(_opcion(argumentos, "--transferencias", "1000000"));
+			return transferencias(cuentas, hilos, cantidad);
+		}
+		if (nombre == "sesiones")
+		{
+			size_t cantidad = stoul(_opcion(argumentos, "--sesiones", "10000"));
+			string archivo = _opcion(argumentos, "--guion", "");
+
+			// Guion por defecto: ver datos, cuentas y reporte, depositar y retirar en la primera
+			// cuenta, ver su historial y salir de ambos mens
+			vector<string> guion = { "1", "2", "3", "5", "0", "S", "4", "100", "5", "30", "2", "6", "7" };
+			if (!archivo.empty())
+			{
+				ifstream in(archivo);
+				if (!in)
+				{
+					throw runtime_error("no se pudo abrir el guion " + archivo);
+				}
+				guion.clear();
+				string linea;
+				while (getline(in, linea))
+				{
+					guion.push_back(linea);
+				}
+			}
+			return sesiones(cantidad, guion);
+		}
+		if (nombre == "carga")
+		{
+			string direccion = _opcion(argumentos, "--direccion", "unix:/tmp/ProyectoBanco.sock");
+			vector<size_t> conexiones = _parsearLista(_opcion(argumentos, "--conexiones", "1,16,64"));
+			size_t peticiones = stoul(_opcion(argumentos, "--peticiones", "200000"));
+			return carga(direccion, conexiones, peticiones);
+		}
+	}
+	catch (const exception& e)
+	{
+		cerr << "Argumentos invalidos: " << e.what() << '\n';
+		return 2;
+	}
+
+	cerr << "Uso (cualquier benchmark admite --metricas y --memoria):\n"
+		<< "     Benchmarks micro [--filtro texto] [--repeticiones R] [--ms M]\n"
+		<< "     Benchmarks generador [--clientes N] [--hilos 1,2,4,8] [--semilla S] [perfil]\n"
+		<< "     Benchmarks generador --salida archivo [--formato texto|binario] [--quejas archivo] [--clientes N] [perfil]\n"
+		<< "       perfil: [--cuentas 1,3] [--zipf 2.0] [--max-transacciones N] [--mediana 50] [--dispersion 1.2]\n"
+		<< "               [--desde 2020] [--hasta 2024] [--tasa-quejas 0.02]\n"
+		<< "     Benchmarks importar --archivo archivo [--hilos 1,2,4,8] [--bloque B]\n"
+		<< "     Benchmarks reporte [--clientes N] [--hilos 1,2,4,8] [--repeticiones R]\n"
+		<< "     Benchmarks cola [--clientes N] [--operaciones N] [--hilos 1,2,4,8]\n"
+		<< "     Benchmarks actores [--clientes N] [--operaciones N] [--hilos 1,2,4,8] [--productores P]\n"
+		<< "     Benchmarks lotes [--clientes N] [--operaciones N] [--hilos 1,2,4,8] [--archivo Operaciones.txt]\n"
+		<< "     Benchmarks columnar [--clientes N] [--archivo Historial.col]\n"
+		<< "     Benchmarks transferencias [--cuentas N] [--hilos 1,2,4,8] [--transferencias N]\n"
+		<< "     Benchmarks sesiones [--sesiones N] [--guion archivo]\n"
+		<< "     Benchmarks carga [--direccion unix:/ruta|tcp:puerto] [--conexiones 1,16,64] [--peticiones N]\n";
+	return 2;
+}
@@ -0,0 +1,29 @@
+#include "Benchmark.h"
+#include "Microbenchmarks.h"
+#include "Memoria.h"
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+// Cuenta cada asignacin del proceso por subsistema (ver Memoria.h) para reportar
+// asignaciones por operacin y el uso de memoria con --memoria
+MEMORIA_REEMPLAZAR_OPERADORES()
+
+int main(int argc, char* argv[])
+{
+	Aleatorio::delHilo().sembrar(1); // Datos repetibles entre ejecuciones
+	string nombre = argc > 1 ? argv[1] : "micro";
+	int codigo = (nombre == "micro") ? Microbenchmarks::ejecutar(argc, argv) : Benchmark::ejecutar(argc, argv);
+
+	// Con --metricas se muestra lo que midieron los mdulos durante el benchmark
+	if (find(argv + 1, argv + argc, string("--metricas")) != argv + argc)
+	{
+		cout << '\n' << Metricas::global().volcar();
+	}
+	// Con --memoria, los bytes que siguen vivos por subsistema
+	if (find(argv + 1, argv + argc, string("--memoria")) != argv + argc)
+	{
+		cout << '\n' << Memoria::volcar();
+	}
+	return codigo;
+}
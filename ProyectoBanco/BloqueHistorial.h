@@ -0,0 +1,328 @@
+#pragma once
+
+#include "Transaccion.h"
+#include <cstdint>
+#include <vector>
+
+// Bloque comprimido de un historial de transacciones.
+//
+// Cada columna se codifica por separado:
+//   tipos:  1 bit por transaccin (Deposito/Retiro), 2 bits si aparece otro tipo
+//   fechas: diferencia con el da anterior (Fecha::toNumeroDia) en varint zigzag
+//   montos: total en cntimos en varint
+//
+// Formato serializado: version u8 | bitsPorTipo u8 | varint cantidad |
+//                      varint bytesTipos | varint bytesFechas | varint bytesMontos | columnas
+class BloqueHistorial : public IDebugable
+{
+private:
+    size_t cantidad;            // Nmero de transacciones codificadas
+    uint8_t bitsPorTipo;        // 1 o 2 bits por tipo
+    int32_t ultimoDia;          // Da de la ltima transaccin (base del siguiente delta)
+    vector<uint8_t> tipos;      // Columna de tipos empaquetada
+    vector<uint8_t> fechas;     // Columna de deltas de da
+    vector<uint8_t> montos;     // Columna de montos
+
+    static constexpr uint8_t VERSION = 1;
+
+    void _ampliarTipos();
+    void _agregarTipo(uint8_t tipo);
+
+    static void _escribirVarint(vector<uint8_t>& destino, uint64_t valor);
+    static uint64_t _leerVarint(const uint8_t*& actual);
+    static void _escribirVarint(ostream& out, uint64_t valor);
+    static bool _leerVarint(istream& in, uint64_t& valor);
+    static bool _columnaValida(const vector<uint8_t>& columna, size_t n);
+    static bool _leerColumna(istream& in, vector<uint8_t>& columna, uint64_t bytes);
+    static uint64_t _zigzag(int64_t valor);
+    static int64_t _deshacerZigzag(uint64_t valor);
+
+public:
+    BloqueHistorial();
+    ~BloqueHistorial() = default;
+
+    size_t size() const;
+    bool empty() const;
+    // Bytes ocupados por las columnas codificadas
+    size_t getTamanioBytes() const;
+
+    // Agrega una transaccin al final del bloque
+    void agregar(const Transaccion& transaccion);
+    void agregar(const RegistroTransaccion& registro);
+    void clear();
+
+    // Decodifica todo el bloque en arreglos contiguos (agrega al final de cada uno)
+    void decodificar(vector<uint8_t>& tiposDestino, vector<int32_t>& diasDestino, vector<int64_t>& centimosDestino) const;
+    // Decodifica todo el bloque en registros compactos (agrega al final)
+    void decodificar(vector<RegistroTransaccion>& destino) const;
+    // Reconstruye cada transaccin en orden
+    void recorrer(const function<void(const Transaccion&)>& operacion) const;
+
+    // Serializacin binaria del bloque
+    bool guardar(ostream& out) const;
+    bool cargar(istream& in);
+
+    string toDebug() const override;
+};
+
+constexpr uint8_t BloqueHistorial::VERSION;
+
+BloqueHistorial::BloqueHistorial()
+    : cantidad(0), bitsPorTipo(1), ultimoDia(0) {}
+
+size_t BloqueHistorial::size() const {
+    return cantidad;
+}
+
+bool BloqueHistorial::empty() const {
+    return cantidad == 0;
+}
+
+size_t BloqueHistorial::getTamanioBytes() const {
+    return tipos.size() + fechas.size() + montos.size();
+}
+
+void BloqueHistorial::clear() {
+    cantidad = 0;
+    bitsPorTipo = 1;
+    ultimoDia = 0;
+    tipos.clear();
+    fechas.clear();
+    montos.clear();
+}
+
+// Pasa la columna de tipos de 1 a 2 bits por transaccin
+void BloqueHistorial::_ampliarTipos() {
+    vector<uint8_t> ampliados((cantidad + 3) / 4, 0);
+    for (size_t i = 0; i < cantidad; ++i) {
+        uint8_t tipo = (tipos[i / 8] >> (i % 8)) & 1;
+        ampliados[i / 4] |= static_cast<uint8_t>(tipo << ((i % 4) * 2));
+    }
+    tipos.swap(ampliados);
+    bitsPorTipo = 2;
+}
+
+void BloqueHistorial::_agregarTipo(uint8_t tipo) {
+    if (tipo > 1 && bitsPorTipo == 1) {
+        _ampliarTipos();
+    }
+
+    size_t porByte = 8 / bitsPorTipo;
+    if (cantidad % porByte == 0) {
+        tipos.push_back(0);
+    }
+    tipos.back() |= static_cast<uint8_t>(tipo << ((cantidad % porByte) * bitsPorTipo));
+}
+
+void BloqueHistorial::agregar(const Transaccion& transaccion) {
+    agregar(transaccion.toRegistro());
+}
+
+void BloqueHistorial::agregar(const RegistroTransaccion& registro) {
+    _agregarTipo(registro.tipo);
+    _escribirVarint(fechas, _zigzag(static_cast<int64_t>(registro.numeroDia) - ultimoDia));
+    _escribirVarint(montos, static_cast<uint64_t>(registro.centimos));
+
+    ultimoDia = registro.numeroDia;
+    ++cantidad;
+}
+
+void BloqueHistorial::decodificar(vector<uint8_t>& tiposDestino, vector<int32_t>& diasDestino, vector<int64_t>& centimosDestino) const {
+    size_t base = diasDestino.size();
+    tiposDestino.resize(base + cantidad);
+    diasDestino.resize(base + cantidad);
+    centimosDestino.resize(base + cantidad);
+
+    uint8_t mascara = static_cast<uint8_t>((1 << bitsPorTipo) - 1);
+    size_t porByte = 8 / bitsPorTipo;
+    const uint8_t* fecha = fechas.data();
+    const uint8_t* monto = montos.data();
+    int64_t dia = 0;
+
+    for (size_t i = 0; i < cantidad; ++i) {
+        tiposDestino[base + i] = (tipos[i / porByte] >> ((i % porByte) * bitsPorTipo)) & mascara;
+        dia += _deshacerZigzag(_leerVarint(fecha));
+        diasDestino[base + i] = static_cast<int32_t>(dia);
+        centimosDestino[base + i] = static_cast<int64_t>(_leerVarint(monto));
+    }
+}
+
+void BloqueHistorial::decodificar(vector<RegistroTransaccion>& destino) const {
+    uint8_t mascara = static_cast<uint8_t>((1 << bitsPorTipo) - 1);
+    size_t porByte = 8 / bitsPorTipo;
+    const uint8_t* fecha = fechas.data();
+    const uint8_t* monto = montos.data();
+    int64_t dia = 0;
+
+    destino.reserve(destino.size() + cantidad);
+    for (size_t i = 0; i < cantidad; ++i) {
+        RegistroTransaccion registro = {};
+        registro.tipo = (tipos[i / porByte] >> ((i % porByte) * bitsPorTipo)) & mascara;
+        dia += _deshacerZigzag(_leerVarint(fecha));
+        registro.numeroDia = static_cast<int32_t>(dia);
+        registro.centimos = static_cast<int64_t>(_leerVarint(monto));
+        destino.push_back(registro);
+    }
+}
+
+void BloqueHistorial::recorrer(const function<void(const Transaccion&)>& operacion) const {
+    vector<uint8_t> tiposDecodificados;
+    vector<int32_t> dias;
+    vector<int64_t> centimos;
+    decodificar(tiposDecodificados, dias, centimos);
+
+    Fecha fecha;
+    Monto monto;
+    for (size_t i = 0; i < cantidad; ++i) {
+        fecha.setNumeroDia(dias[i]);
+        monto.setTotalCentimos(centimos[i]);
+        operacion(Transaccion(monto, fecha, static_cast<TipoTransaccion>(tiposDecodificados[i])));
+    }
+}
+
+bool BloqueHistorial::guardar(ostream& out) const {
+    out.put(static_cast<char>(VERSION));
+    out.put(static_cast<char>(bitsPorTipo));
+    _escribirVarint(out, cantidad);
+    _escribirVarint(out, tipos.size());
+    _escribirVarint(out, fechas.size());
+    _escribirVarint(out, montos.size());
+    out.write(reinterpret_cast<const char*>(tipos.data()), tipos.size());
+    out.write(reinterpret_cast<const char*>(fechas.data()), fechas.size());
+    out.write(reinterpret_cast<const char*>(montos.data()), montos.size());
+    return out.good();
+}
+
+bool BloqueHistorial::cargar(istream& in) {
+    clear();
+
+    int version = in.get();
+    int bits = in.get();
+    uint64_t n, bytesTipos, bytesFechas, bytesMontos;
+    if (version != VERSION || (bits != 1 && bits != 2) ||
+        !_leerVarint(in, n) || !_leerVarint(in, bytesTipos) ||
+        !_leerVarint(in, bytesFechas) || !_leerVarint(in, bytesMontos)) {
+        return false;
+    }
+
+    // Cada columna debe tener el tamao que corresponde a 'n' transacciones (un varint ocupa
+    // a lo sumo 10 bytes; un 'n' mayor desbordara el lmite)
+    size_t porByte = 8 / bits;
+    if (n > UINT64_MAX / 10 || bytesTipos != (n + porByte - 1) / porByte || bytesFechas < n || bytesMontos < n ||
+        bytesFechas > n * 10 || bytesMontos > n * 10) {
+        return false;
+    }
+
+    if (!_leerColumna(in, tipos, bytesTipos) || !_leerColumna(in, fechas, bytesFechas) ||
+        !_leerColumna(in, montos, bytesMontos) || !_columnaValida(fechas, static_cast<size_t>(n)) || !_columnaValida(montos, static_cast<size_t>(n))) {
+        clear();
+        return false;
+    }
+
+    cantidad = static_cast<size_t>(n);
+    bitsPorTipo = static_cast<uint8_t>(bits);
+
+    // Recalcular la base de los deltas para poder seguir agregando
+    const uint8_t* fecha = fechas.data();
+    int64_t dia = 0;
+    for (size_t i = 0; i < cantidad; ++i) {
+        dia += _deshacerZigzag(_leerVarint(fecha));
+    }
+    ultimoDia = static_cast<int32_t>(dia);
+    return true;
+}
+
+// Los tamaos vienen de la cabecera: se lee por tramos para que la memoria crezca con los
+// bytes que realmente hay en el flujo y no con lo que declara un archivo daado
+bool BloqueHistorial::_leerColumna(istream& in, vector<uint8_t>& columna, uint64_t bytes) {
+    constexpr uint64_t TRAMO = 1 << 16;
+    columna.clear();
+    while (columna.size() < bytes) {
+        size_t inicio = columna.size();
+        size_t pedidos = static_cast<size_t>(min(TRAMO, bytes - inicio));
+        columna.resize(inicio + pedidos);
+        if (!in.read(reinterpret_cast<char*>(columna.data() + inicio), static_cast<streamsize>(pedidos))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+string BloqueHistorial::toDebug() const {
+    ostringstream debug;
+    debug << "BloqueHistorial(cantidad=" << cantidad
+        << ", bitsPorTipo=" << static_cast<int>(bitsPorTipo)
+        << ", bytesTipos=" << tipos.size()
+        << ", bytesFechas=" << fechas.size()
+        << ", bytesMontos=" << montos.size() << ")";
+    return debug.str();
+}
+
+void BloqueHistorial::_escribirVarint(vector<uint8_t>& destino, uint64_t valor) {
+    while (valor >= 0x80) {
+        destino.push_back(static_cast<uint8_t>(valor | 0x80));
+        valor >>= 7;
+    }
+    destino.push_back(static_cast<uint8_t>(valor));
+}
+
+uint64_t BloqueHistorial::_leerVarint(const uint8_t*& actual) {
+    uint64_t valor = 0;
+    int desplazamiento = 0;
+    uint8_t byte;
+    do {
+        byte = *actual++;
+        valor |= static_cast<uint64_t>(byte & 0x7F) << desplazamiento;
+        desplazamiento += 7;
+    } while ((byte & 0x80) && desplazamiento < 64);
+    return valor;
+}
+
+void BloqueHistorial::_escribirVarint(ostream& out, uint64_t valor) {
+    while (valor >= 0x80) {
+        out.put(static_cast<char>(valor | 0x80));
+        valor >>= 7;
+    }
+    out.put(static_cast<char>(valor));
+}
+
+bool BloqueHistorial::_leerVarint(istream& in, uint64_t& valor) {
+    valor = 0;
+    for (int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7) {
+        int byte = in.get();
+        if (byte == EOF) {
+            return false;
+        }
+        valor |= static_cast<uint64_t>(byte & 0x7F) << desplazamiento;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Verifica que la columna contenga exactamente 'n' varints completos
+bool BloqueHistorial::_columnaValida(const vector<uint8_t>& columna, size_t n) {
+    size_t terminados = 0;
+    size_t continuacion = 0;
+    for (uint8_t byte : columna) {
+        if (byte & 0x80) {
+            if (++continuacion >= 10) {
+                return false;
+            }
+        }
+        else {
+            ++terminados;
+            continuacion = 0;
+        }
+    }
+    return terminados == n && continuacion == 0;
+}
+
+uint64_t BloqueHistorial::_zigzag(int64_t valor) {
+    return (static_cast<uint64_t>(valor) << 1) ^ static_cast<uint64_t>(valor >> 63);
+}
+
+int64_t BloqueHistorial::_deshacerZigzag(uint64_t valor) {
+    return static_cast<int64_t>(valor >> 1) ^ -static_cast<int64_t>(valor & 1);
+}
@@ -20,12 +20,12 @@ private:
 	float _totalRecursivoDinero(const SList<Cuenta>& cuentas, SList<Cuenta>::Iterator it);
 	Monto _totalDinero();
 
-	void _showDatos();
-	void _showCuentas();
-	void _showReporte();
-	void _interactNuevaCuenta();
-	void _interactSeleccionarCuenta();
-	void _interactRegistrarQueja();
+	void _showDatos(ostream& out);
+	void _showCuentas(ostream& out);
+	void _showReporte(ostream& out);
+	Tarea _interactNuevaCuenta(Sesion& sesion);
+	Tarea _interactSeleccionarCuenta(Sesion& sesion);
+	Tarea _interactRegistrarQueja(Sesion& sesion);
 
 public:
 	Cliente(const Fecha& fechaActual, const Identidad& identidad, const Contacto& contacto);
@@ -34,12 +34,21 @@ public:
 
 	~Cliente() = default;
 
+	// Aplica una operacin a cada cuenta del cliente (sin copiarlas)
+	void aplicarCuentas(const function<void(Cuenta&)>& operacion);
+	// Agrega una cuenta ya armada (por ejemplo, de un generador) al final de la lista
+	bool addCuenta(const Cuenta& cuenta);
+	// Reemplaza las quejas del cliente sin guardarlas en el archivo de quejas
+	bool setQuejas(const SStack<Queja>& quejas);
+
 	string toDebug() const override;
 	string toSave() const override;
 	void load(const string& data) override;
 	string toShow() const override;
-	void generateRandom() override;
-	void interact() override;
+	void generateRandom(Aleatorio& aleatorio) override;
+	using IRandomizable::generateRandom;
+	Tarea interactuar(Sesion& sesion) override;
+	using IInteractive::interact;
 };
 
 Cliente::Cliente(const Fecha& fechaActual, const Identidad& identidad, const Contacto& contacto)
@@ -72,39 +81,53 @@ string Cliente::toDebug() const {
 
 string Cliente::toSave() const
 {
-	ostringstream out;
-	out << identidad.getDNI() << Serialization::DELIMITER_MAIN
-		<< identidad.toSave() << Serialization::DELIMITER_MAIN
-		<< contacto.toSave() << Serialization::DELIMITER_MAIN;
+	static Histograma latencia("Cliente.toSave");
+	Cronometro cronometro(latencia);
+	ZonaMemoria zona(Subsistema::Serializacion);
+	// Todo se agrega a un solo string; identidad, contacto y cuentas se guardan sin llamadas virtuales
+	string out;
+	out += identidad.getDNI();
+	out += Serialization::DELIMITER_MAIN;
+	identidad.guardarEn(out);
+	out += Serialization::DELIMITER_MAIN;
+	contacto.guardarEn(out);
+	out += Serialization::DELIMITER_MAIN;
 
 	for (const auto& cuenta : cuentas) {
-		out << cuenta.toSave() << Serialization::DELIMITER_MAIN;
+		cuenta.guardarEn(out);
+		out += Serialization::DELIMITER_MAIN;
 	}
 
-	return out.str();
+	return out;
 }
 
 void Cliente::load(const string& data)
 {
-	istringstream in(data);
-	string _, identidadStr, contactoStr, cuentaStr;
+	static Histograma latencia("Cliente.load");
+	Cronometro cronometro(latencia);
+	ZonaMemoria zona(Subsistema::Dominio);
+	size_t posicion = 0;
+	string_view _, identidadStr, contactoStr, cuentaStr;
 
 	// Leer y descartar el primer valor si es necesario
-	if (!getline(in, _, Serialization::DELIMITER_MAIN) ||
-		!getline(in, identidadStr, Serialization::DELIMITER_MAIN) ||
-		!getline(in, contactoStr, Serialization::DELIMITER_MAIN))
+	if (!leerCampo(data, posicion, Serialization::DELIMITER_MAIN, _) ||
+		!leerCampo(data, posicion, Serialization::DELIMITER_MAIN, identidadStr) ||
+		!leerCampo(data, posicion, Serialization::DELIMITER_MAIN, contactoStr))
 	{
 		throw runtime_error("Error al cargar los datos bsicos (identidad y contacto).");
 	}
 
-	// Cargar la identidad y contacto
-	identidad.load(identidadStr);
-	contacto.load(contactoStr);
+	// Cargar la identidad y contacto directamente desde las vistas
+	{
+		ZonaMemoria zonaIdentidad(Subsistema::Identidades);
+		identidad.cargar(identidadStr);
+		contacto.cargar(contactoStr);
+	}
 
 	// Leer todas las cuentas y agregar a la lista
-	while (getline(in, cuentaStr, Serialization::DELIMITER_MAIN)) {
+	while (leerCampo(data, posicion, Serialization::DELIMITER_MAIN, cuentaStr)) {
 		Cuenta cb;
-		cb.load(cuentaStr);
+		cb.cargar(cuentaStr);
 		cuentas.pushFront(cb);
 	}
 }
@@ -139,52 +162,49 @@ string Cliente::toShow() const
 }
 
 // Mtodo de generacin de datos aleatorios con manejo seguro
-void Cliente::generateRandom()
+void Cliente::generateRandom(Aleatorio& aleatorio)
 {
-	identidad.generateRandom();
-	contacto.generateRandom();
+	identidad.generateRandom(aleatorio);
+	contacto.generateRandom(aleatorio);
 
-	size_t n = rand() % 3 + 1; // Generar de 1 a 3 cuentas
+	size_t n = aleatorio.entero(3) + 1; // Generar de 1 a 3 cuentas
 
 	for (size_t i = 0; i < n; ++i) {
 		Cuenta cb;
-		cb.generateRandom();
-		cout << "Generando cuenta bancaria: " << i + 1 << '\n';
-		cout << cb.toDebug() << '\n'; // Verifica si imprime correctamente
+		cb.generateRandom(aleatorio);
 		cuentas.pushBack(cb);
-		cout << "Cuenta aadida al listado.\n";
 	}
 }
 
-void Cliente::interact()
+Tarea Cliente::interactuar(Sesion& sesion)
 {
-	int opcion;
-	do {
-		cout << "=== Menu de Cliente ===\n";
-		cout << "1. Mostrar datos\n2. Mostrar cuentas\n3. Mostrar reporte\n4. Aadir nueva cuenta\n";
-		cout << "5. Seleccionar cuenta\n6. Registrar queja\n7. Salir\n";
-		cout << "Seleccione una opcin: ";
-		cin >> opcion;
+	ostream& out = sesion.out();
+	while (true) {
+		out << "=== Menu de Cliente ===\n";
+		out << "1. Mostrar datos\n2. Mostrar cuentas\n3. Mostrar reporte\n4. Aadir nueva cuenta\n";
+		out << "5. Seleccionar cuenta\n6. Registrar queja\n7. Salir\n";
+		out << "Seleccione una opcin: ";
+		optional<string> linea = co_await sesion.leerLinea();
+		if (!linea) co_return; // Fin de la entrada
 
 		// Validar la entrada
-		if (cin.fail()) {
-			cin.clear();
-			cin.ignore();
-			cout << "Entrada invlida. Intente nuevamente.\n";
+		int opcion;
+		if (!Sesion::convertir(*linea, opcion)) {
+			out << "Entrada invlida. Intente nuevamente.\n";
 			continue;
 		}
 
 		switch (opcion) {
-		case 1: _showDatos(); break;
-		case 2: _showCuentas(); break;
-		case 3: _showReporte(); break;
-		case 4: _interactNuevaCuenta(); break;
-		case 5: _interactSeleccionarCuenta(); break;
-		case 6: _interactRegistrarQueja(); break;
-		case 7: cout << "Saliendo del men.\n"; break;
-		default: cout << "Opcin invlida. Intente nuevamente.\n";
+		case 1: _showDatos(out); break;
+		case 2: _showCuentas(out); break;
+		case 3: _showReporte(out); break;
+		case 4: co_await _interactNuevaCuenta(sesion); break;
+		case 5: co_await _interactSeleccionarCuenta(sesion); break;
+		case 6: co_await _interactRegistrarQueja(sesion); break;
+		case 7: out << "Saliendo del men.\n"; co_return;
+		default: out << "Opcin invlida. Intente nuevamente.\n";
 		}
-	} while (opcion != 7);
+	}
 }
 
 
@@ -216,106 +236,157 @@ float Cliente::_totalRecursivoDinero(const SList<Cuenta>& cuentas, SList<Cuenta>
 	return (it != cuentas.end()) ? (*it).getTarjeta().getSaldoFloat() + _totalRecursivoDinero(cuentas, ++it) : 0;
 }
 
+void Cliente::aplicarCuentas(const function<void(Cuenta&)>& operacion)
+{
+	for (auto& cuenta : cuentas)
+	{
+		operacion(cuenta);
+	}
+}
+
+bool Cliente::addCuenta(const Cuenta& cuenta)
+{
+	if (cuenta.getNumeroCuenta().empty())
+	{
+		return false;
+	}
+	ZonaMemoria zona(Subsistema::Dominio);
+	cuentas.pushBack(cuenta);
+	return true;
+}
+
+bool Cliente::setQuejas(const SStack<Queja>& quejas)
+{
+	return this->quejas.setQuejas(quejas);
+}
+
 Monto Cliente::_totalDinero()
 {
 	return Monto(_totalRecursivoDinero(cuentas, cuentas.begin()));
 }
 
-void Cliente::_showDatos()
+void Cliente::_showDatos(ostream& out)
 {
-	cout << toShow() << '\n';
+	out << toShow() << '\n';
 }
 
-void Cliente::_showCuentas()
+void Cliente::_showCuentas(ostream& out)
 {
 	for (const auto& cuenta : cuentas) {
-		cout << cuenta.toShow() << endl;
+		out << cuenta.toShow() << '\n';
 	}
 }
 
-void Cliente::_showReporte()
+void Cliente::_showReporte(ostream& out)
 {
-	cout << "=== Reporte de Cliente ===\n";
-	cout << "Numero de Cuentas: " << cuentas.size() << '\n';
-	cout << "Saldo en cada Cuenta: \n";
+	// Saldos de todas las cuentas en un mismo instante: una transferencia entre ellas no
+	// aparece a medias aunque ocurra mientras se arma el reporte
+	vector<const Cuenta*> propias;
 	for (const auto& cuenta : cuentas) {
-		cout << cuenta.getNumeroCuenta() << ": S/." << cuenta.getTarjeta().getSaldoMonto().toString() << '\n';
+		propias.push_back(&cuenta);
+	}
+	vector<InstantaneaCuenta> instantaneas = Cuenta::getInstantaneas(propias);
+
+	long long total = 0;
+	out << "=== Reporte de Cliente ===\n";
+	out << "Numero de Cuentas: " << propias.size() << '\n';
+	out << "Saldo en cada Cuenta: \n";
+	for (size_t i = 0; i < propias.size(); ++i) {
+		Monto saldo;
+		saldo.setTotalCentimos(instantaneas[i].saldo);
+		total += instantaneas[i].saldo;
+		out << propias[i]->getNumeroCuenta() << ": S/." << saldo.toString() << '\n';
 	}
-	cout << "Saldo total: " << _totalDinero().toString() << '\n';
+	Monto saldoTotal;
+	saldoTotal.setTotalCentimos(total);
+	out << "Saldo total: " << saldoTotal.toString() << '\n';
 }
 
-void Cliente::_interactNuevaCuenta()
+Tarea Cliente::_interactNuevaCuenta(Sesion& sesion)
 {
+	ostream& out = sesion.out();
+
 	// Confirmar
-	cout << "Desea aniadir una nueva cuenta? (S/N): ";
-	char opcion;
-	cin >> opcion;
+	out << "Desea aniadir una nueva cuenta? (S/N): ";
+	optional<string> linea = co_await sesion.leerLinea();
+	char opcion = 'N';
+	if (linea) {
+		Sesion::convertir(*linea, opcion);
+	}
 
 	// Validar la entrada
 	if (opcion == 'S' || opcion == 's')
 	{
 		if (_addCuenta())
 		{
-			cout << "La cuenta ha sido aniadida exitosamente.\n";
+			out << "La cuenta ha sido aniadida exitosamente.\n";
 		}
 		else
 		{
-			cout << "No se pudo aniadir la cuenta. Intente nuevamente.\n";
+			out << "No se pudo aniadir la cuenta. Intente nuevamente.\n";
 		}
 	}
 	else
 	{
-		cout << "La cuenta no fue aniadida.\n";
+		out << "La cuenta no fue aniadida.\n";
 	}
 }
 
-void Cliente::_interactSeleccionarCuenta()
+Tarea Cliente::_interactSeleccionarCuenta(Sesion& sesion)
 {
+	ostream& out = sesion.out();
 	if (cuentas.empty()) {
-		cout << "No hay cuentas disponibles para seleccionar.\n";
-		return;
+		out << "No hay cuentas disponibles para seleccionar.\n";
+		co_return;
 	}
 
-	cout << "=== Seleccin de Cuenta Bancaria ===\n";
+	out << "=== Seleccin de Cuenta Bancaria ===\n";
 	size_t index = 0;
 	for (const auto& cuenta : cuentas) {
-		cout << index << ". Cuenta: " << cuenta.getNumeroCuenta()
+		out << index << ". Cuenta: " << cuenta.getNumeroCuenta()
 			<< " | Saldo: S/." << cuenta.getTarjeta().getSaldoMonto().toString() << '\n';
 		++index;
 	}
 
-	cout << "Seleccione el ndice de la cuenta que desea gestionar (0 - " << cuentas.size() - 1 << "): ";
+	out << "Seleccione el ndice de la cuenta que desea gestionar (0 - " << cuentas.size() - 1 << "): ";
+	optional<string> linea = co_await sesion.leerLinea();
 	size_t seleccion;
-	cin >> seleccion;
 
-	if (cin.fail() || seleccion >= cuentas.size()) {
-		cin.clear();
-		cin.ignore();
-		cout << "ndice invlido. No se seleccion ninguna cuenta.\n";
-		return;
+	if (!linea || !Sesion::convertir(*linea, seleccion) || seleccion >= cuentas.size()) {
+		out << "ndice invlido. No se seleccion ninguna cuenta.\n";
+		co_return;
 	}
 
-	auto cuentaSeleccionada = cuentas.getAt(seleccion);
-	cout << "Has seleccionado la cuenta: " << cuentaSeleccionada.getNumeroCuenta() << '\n';
-	cout << "Saldo actual: S/." << cuentaSeleccionada.getTarjeta().getSaldoMonto().toString() << '\n';
-
-	cout << "Desea gestionar esta cuenta? (S/N): ";
-	char opcion;
-	cin >> opcion;
+	// Se gestiona la cuenta del cliente, no una copia
+	Cuenta* cuentaSeleccionada = nullptr;
+	index = 0;
+	for (auto& cuenta : cuentas) {
+		if (index++ == seleccion) {
+			cuentaSeleccionada = &cuenta;
+		}
+	}
+	out << "Has seleccionado la cuenta: " << cuentaSeleccionada->getNumeroCuenta() << '\n';
+	out << "Saldo actual: S/." << cuentaSeleccionada->getTarjeta().getSaldoMonto().toString() << '\n';
+
+	out << "Desea gestionar esta cuenta? (S/N): ";
+	linea = co_await sesion.leerLinea();
+	char opcion = 'N';
+	if (linea) {
+		Sesion::convertir(*linea, opcion);
+	}
 
 	if (opcion == 'S' || opcion == 's') {
-		cout << "Iniciando interaccin con la cuenta seleccionada...\n";
-		cuentaSeleccionada.interact();
+		out << "Iniciando interaccin con la cuenta seleccionada...\n";
+		co_await cuentaSeleccionada->interactuar(sesion);
 	}
 	else {
-		cout << "No se realizaron operaciones con la cuenta seleccionada.\n";
+		out << "No se realizaron operaciones con la cuenta seleccionada.\n";
 	}
 }
 
 
-void Cliente::_interactRegistrarQueja()
+Tarea Cliente::_interactRegistrarQueja(Sesion& sesion)
 {
-	quejas.loadFromFile();
-	quejas.interact();
-	quejas.saveToFile();
+	// La queja se anexa al archivo al registrarse; no hace falta cargarlo ni reescribirlo
+	co_await quejas.interactuar(sesion);
 }
\ No newline at end of file
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "Memoria.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Registro de solo agregado seguro entre hilos.
+//
+// Los elementos se guardan en segmentos que duplican su capacidad y nunca se mueven.
+// Cada push reserva una posicin con fetch_add, construye el elemento y lo marca como listo;
+// 'publicados' avanza sobre el prefijo de posiciones listas (cualquier hilo ayuda a avanzarlo).
+// Los lectores solo ven ese prefijo, por lo que nunca observan un elemento a medio construir.
+//
+// Cada segmento empieza con un bit de 'listo' por posicin y sigue con los elementos contiguos,
+// as un elemento de 16 bytes ocupa 16 bytes en el registro.
+template<class C>
+class ConcurrentLog
+{
+private:
+    static_assert(alignof(C) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "ConcurrentLog: alineacin no soportada");
+
+    static constexpr size_t BASE = 8;           // Capacidad del primer segmento (la mayora de historiales son cortos)
+    static constexpr size_t MAX_SEGMENTOS = 48; // Capacidad total: BASE * (2^48 - 1)
+
+    std::atomic<unsigned char*> segmentos[MAX_SEGMENTOS];
+    std::atomic<size_t> reservados;  // Posiciones entregadas a escritores
+    std::atomic<size_t> publicados;  // Prefijo de posiciones completamente construidas
+    Subsistema subsistema;           // Al que se atribuye la memoria de los elementos (ver Memoria.h)
+
+    static size_t _segmento(size_t indice, size_t& desplazamiento);
+    // Palabras de bits de 'listo' del segmento k y posicin de su primer elemento
+    static size_t _palabras(size_t k);
+    static size_t _inicioDatos(size_t k);
+    C* _elemento(size_t indice) const;
+    bool _listo(size_t indice) const;
+    void _marcarListo(size_t indice);
+    // Direccin donde construir el elemento 'indice'; crea su segmento si hace falta
+    C* _reservar(size_t indice);
+    void _publicar();
+    void _destruir();
+
+public:
+    // Con Subsistema::Contenedores la memoria queda en la zona de quien agrega
+    explicit ConcurrentLog(Subsistema subsistema = Subsistema::Contenedores);
+    ConcurrentLog(const ConcurrentLog<C>& other);
+    ConcurrentLog<C>& operator=(const ConcurrentLog<C>& other);
+    ~ConcurrentLog();
+
+    // Seguro entre hilos
+    void push(const C& data);
+    // Agrega varios elementos reservando sus posiciones con una sola operacin atmica
+    void push(const std::vector<C>& datos);
+    // Para quien reparte las posiciones por su cuenta (ver Cuenta): escribe en [indice, indice +
+    // cantidad), posiciones que nadie ms escribe. No se combina con push en el mismo registro
+    void colocar(size_t indice, const C& data);
+    void colocar(size_t indice, const std::vector<C>& datos);
+    bool empty() const;
+    size_t size() const;
+    const C& at(size_t indice) const;
+    void forEach(const std::function<void(const C&)>& operation) const;
+
+    // No seguro entre hilos: no debe haber escritores concurrentes
+    void clear();
+
+    // Recorre el prefijo publicado al momento de llamar a begin()
+    class Iterator
+    {
+    private:
+        const ConcurrentLog<C>* log;
+        size_t indice;
+    public:
+        Iterator(const ConcurrentLog<C>* log, size_t indice) : log(log), indice(indice) {}
+
+        Iterator& operator++() { ++indice; return *this; }
+        bool operator!=(const Iterator& other) const { return indice != other.indice; }
+        const C& operator*() const { return log->at(indice); }
+    };
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, size()); }
+};
+
+template<class C>
+constexpr size_t ConcurrentLog<C>::BASE;
+
+template<class C>
+constexpr size_t ConcurrentLog<C>::MAX_SEGMENTOS;
+
+template<class C>
+ConcurrentLog<C>::ConcurrentLog(Subsistema subsistema) : reservados(0), publicados(0), subsistema(subsistema)
+{
+    for (auto& segmento : segmentos)
+    {
+        segmento.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template<class C>
+ConcurrentLog<C>::ConcurrentLog(const ConcurrentLog<C>& other) : ConcurrentLog(other.subsistema)
+{
+    other.forEach([this](const C& data) { push(data); });
+}
+
+template<class C>
+ConcurrentLog<C>& ConcurrentLog<C>::operator=(const ConcurrentLog<C>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        other.forEach([this](const C& data) { push(data); });
+    }
+    return *this;
+}
+
+template<class C>
+ConcurrentLog<C>::~ConcurrentLog()
+{
+    _destruir();
+}
+
+// Segmento k contiene las posiciones [BASE * (2^k - 1), BASE * (2^(k+1) - 1))
+template<class C>
+size_t ConcurrentLog<C>::_segmento(size_t indice, size_t& desplazamiento)
+{
+    size_t bloque = indice / BASE + 1;
+    size_t k = 0;
+    while ((bloque >> (k + 1)) != 0)
+    {
+        ++k;
+    }
+    desplazamiento = indice - BASE * ((size_t(1) << k) - 1);
+    return k;
+}
+
+template<class C>
+size_t ConcurrentLog<C>::_palabras(size_t k)
+{
+    return ((BASE << k) + 63) / 64;
+}
+
+template<class C>
+size_t ConcurrentLog<C>::_inicioDatos(size_t k)
+{
+    size_t bytes = _palabras(k) * sizeof(std::atomic<uint64_t>);
+    return (bytes + alignof(C) - 1) / alignof(C) * alignof(C);
+}
+
+template<class C>
+C* ConcurrentLog<C>::_elemento(size_t indice) const
+{
+    size_t desplazamiento;
+    size_t k = _segmento(indice, desplazamiento);
+    return reinterpret_cast<C*>(segmentos[k].load(std::memory_order_acquire) + _inicioDatos(k)) + desplazamiento;
+}
+
+// El segmento de una posicin reservada puede no existir todava si su escritor an no lo cre
+template<class C>
+bool ConcurrentLog<C>::_listo(size_t indice) const
+{
+    size_t desplazamiento;
+    unsigned char* segmento = segmentos[_segmento(indice, desplazamiento)].load(std::memory_order_acquire);
+    if (segmento == nullptr)
+    {
+        return false;
+    }
+    const std::atomic<uint64_t>* listos = reinterpret_cast<const std::atomic<uint64_t>*>(segmento);
+    return (listos[desplazamiento / 64].load() >> (desplazamiento % 64)) & 1;
+}
+
+template<class C>
+void ConcurrentLog<C>::_marcarListo(size_t indice)
+{
+    size_t desplazamiento;
+    unsigned char* segmento = segmentos[_segmento(indice, desplazamiento)].load(std::memory_order_acquire);
+    std::atomic<uint64_t>* listos = reinterpret_cast<std::atomic<uint64_t>*>(segmento);
+    listos[desplazamiento / 64].fetch_or(uint64_t(1) << (desplazamiento % 64));
+}
+
+template<class C>
+C* ConcurrentLog<C>::_reservar(size_t indice)
+{
+    size_t desplazamiento;
+    size_t k = _segmento(indice, desplazamiento);
+    if (k >= MAX_SEGMENTOS)
+    {
+        throw std::length_error("ConcurrentLog: capacidad agotada");
+    }
+
+    unsigned char* segmento = segmentos[k].load(std::memory_order_acquire);
+    if (segmento == nullptr)
+    {
+        // Varios hilos pueden intentar crear el mismo segmento: gana el primero
+        unsigned char* nuevo = new unsigned char[_inicioDatos(k) + sizeof(C) * (BASE << k)];
+        for (size_t i = 0; i < _palabras(k); ++i)
+        {
+            new (nuevo + i * sizeof(std::atomic<uint64_t>)) std::atomic<uint64_t>(0);
+        }
+        if (segmentos[k].compare_exchange_strong(segmento, nuevo, std::memory_order_acq_rel))
+        {
+            segmento = nuevo;
+        }
+        else
+        {
+            delete[] nuevo;
+        }
+    }
+    return reinterpret_cast<C*>(segmento + _inicioDatos(k)) + desplazamiento;
+}
+
+// Avanza 'publicados' mientras la siguiente posicin est lista
+template<class C>
+void ConcurrentLog<C>::_publicar()
+{
+    size_t p = publicados.load();
+    while (p < reservados.load() && _listo(p))
+    {
+        if (publicados.compare_exchange_weak(p, p + 1))
+        {
+            ++p;
+        }
+    }
+}
+
+template<class C>
+void ConcurrentLog<C>::push(const C& data)
+{
+    ZonaMemoria zona(subsistema, subsistema != Subsistema::Contenedores);
+    size_t indice = reservados.fetch_add(1);
+    new (_reservar(indice)) C(data);
+    _marcarListo(indice);
+    _publicar();
+}
+
+template<class C>
+void ConcurrentLog<C>::push(const std::vector<C>& datos)
+{
+    if (datos.empty())
+    {
+        return;
+    }
+
+    ZonaMemoria zona(subsistema, subsistema != Subsistema::Contenedores);
+    size_t inicio = reservados.fetch_add(datos.size());
+    for (size_t i = 0; i < datos.size(); ++i)
+    {
+        new (_reservar(inicio + i)) C(datos[i]);
+        _marcarListo(inicio + i);
+    }
+    _publicar();
+}
+
+template<class C>
+void ConcurrentLog<C>::colocar(size_t indice, const C& data)
+{
+    ZonaMemoria zona(subsistema, subsistema != Subsistema::Contenedores);
+    size_t reservadas = reservados.load();
+    while (reservadas < indice + 1 && !reservados.compare_exchange_weak(reservadas, indice + 1))
+    {
+    }
+    new (_reservar(indice)) C(data);
+    _marcarListo(indice);
+    _publicar();
+}
+
+template<class C>
+void ConcurrentLog<C>::colocar(size_t indice, const std::vector<C>& datos)
+{
+    if (datos.empty())
+    {
+        return;
+    }
+
+    ZonaMemoria zona(subsistema, subsistema != Subsistema::Contenedores);
+    size_t fin = indice + datos.size();
+    size_t reservadas = reservados.load();
+    while (reservadas < fin && !reservados.compare_exchange_weak(reservadas, fin))
+    {
+    }
+    for (size_t i = 0; i < datos.size(); ++i)
+    {
+        new (_reservar(indice + i)) C(datos[i]);
+        _marcarListo(indice + i);
+    }
+    _publicar();
+}
+
+template<class C>
+bool ConcurrentLog<C>::empty() const
+{
+    return size() == 0;
+}
+
+template<class C>
+size_t ConcurrentLog<C>::size() const
+{
+    return publicados.load(std::memory_order_acquire);
+}
+
+template<class C>
+const C& ConcurrentLog<C>::at(size_t indice) const
+{
+    return *_elemento(indice);
+}
+
+template<class C>
+void ConcurrentLog<C>::forEach(const std::function<void(const C&)>& operation) const
+{
+    size_t n = size();
+    for (size_t i = 0; i < n; ++i)
+    {
+        operation(at(i));
+    }
+}
+
+template<class C>
+void ConcurrentLog<C>::clear()
+{
+    _destruir();
+    reservados.store(0);
+    publicados.store(0);
+}
+
+template<class C>
+void ConcurrentLog<C>::_destruir()
+{
+    size_t n = reservados.load();
+    for (size_t i = 0; i < n && !std::is_trivially_destructible<C>::value; ++i)
+    {
+        if (_listo(i))
+        {
+            _elemento(i)->~C();
+        }
+    }
+    for (auto& segmento : segmentos)
+    {
+        delete[] segmento.exchange(nullptr);
+    }
+}
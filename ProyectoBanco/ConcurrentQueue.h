@@ -0,0 +1,190 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Cola acotada sin bloqueos para varios productores y varios consumidores.
+//
+// Arreglo circular de celdas, cada una con un nmero de secuencia que indica de quin es el turno:
+// secuencia == posicin            -> libre para el productor de esa posicin
+// secuencia == posicin + 1        -> ocupada, lista para el consumidor de esa posicin
+// secuencia == posicin + capacidad -> libre para la siguiente vuelta
+// Productores y consumidores solo compiten por sus ndices (un compare_exchange cada uno).
+template<class C>
+class ConcurrentQueue
+{
+private:
+	struct Celda
+	{
+		std::atomic<size_t> secuencia;
+		alignas(C) unsigned char datos[sizeof(C)];
+	};
+
+	static constexpr size_t LINEA_CACHE = 64;
+
+	Celda* celdas;
+	size_t capacidad;                        // Potencia de 2
+	size_t mascara;
+	// ndices en lneas de cach distintas para que productores y consumidores no se estorben
+	alignas(LINEA_CACHE) std::atomic<size_t> final;   // Siguiente posicin a escribir
+	alignas(LINEA_CACHE) std::atomic<size_t> inicio;  // Siguiente posicin a leer
+
+	template<class T>
+	bool _push(T&& data);
+
+public:
+	// La capacidad se redondea a la siguiente potencia de 2
+	ConcurrentQueue(size_t capacidad);
+	~ConcurrentQueue();
+
+	ConcurrentQueue(const ConcurrentQueue<C>&) = delete;
+	ConcurrentQueue<C>& operator=(const ConcurrentQueue<C>&) = delete;
+
+	// Retorna false si la cola est llena
+	bool push(const C& data);
+	bool push(C&& data);
+	// Retorna false si la cola est vaca
+	bool tryPop(C& data);
+
+	// Aproximados mientras haya otros hilos usando la cola
+	bool empty() const;
+	size_t size() const;
+	size_t getCapacidad() const;
+};
+
+template<class C>
+ConcurrentQueue<C>::ConcurrentQueue(size_t capacidad) : final(0), inicio(0)
+{
+	this->capacidad = 2;
+	while (this->capacidad < capacidad)
+	{
+		this->capacidad <<= 1;
+	}
+	mascara = this->capacidad - 1;
+
+	celdas = new Celda[this->capacidad];
+	for (size_t i = 0; i < this->capacidad; ++i)
+	{
+		celdas[i].secuencia.store(i, std::memory_order_relaxed);
+	}
+}
+
+template<class C>
+ConcurrentQueue<C>::~ConcurrentQueue()
+{
+	// Destruir los elementos que nadie consumi
+	for (size_t posicion = inicio.load(); posicion != final.load(); ++posicion)
+	{
+		Celda& celda = celdas[posicion & mascara];
+		if (celda.secuencia.load() == posicion + 1)
+		{
+			reinterpret_cast<C*>(celda.datos)->~C();
+		}
+	}
+	delete[] celdas;
+}
+
+template<class C>
+template<class T>
+bool ConcurrentQueue<C>::_push(T&& data)
+{
+	size_t posicion = final.load(std::memory_order_relaxed);
+	Celda* celda;
+	while (true)
+	{
+		celda = &celdas[posicion & mascara];
+		size_t secuencia = celda->secuencia.load(std::memory_order_acquire);
+		intptr_t diferencia = static_cast<intptr_t>(secuencia) - static_cast<intptr_t>(posicion);
+
+		if (diferencia == 0)
+		{
+			// La celda est libre para esta vuelta: intentar reservar la posicin
+			if (final.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diferencia < 0)
+		{
+			return false; // Llena: la celda todava no fue consumida en la vuelta anterior
+		}
+		else
+		{
+			posicion = final.load(std::memory_order_relaxed);
+		}
+	}
+
+	new (celda->datos) C(std::forward<T>(data));
+	celda->secuencia.store(posicion + 1, std::memory_order_release);
+	return true;
+}
+
+template<class C>
+bool ConcurrentQueue<C>::push(const C& data)
+{
+	return _push(data);
+}
+
+template<class C>
+bool ConcurrentQueue<C>::push(C&& data)
+{
+	return _push(std::move(data));
+}
+
+template<class C>
+bool ConcurrentQueue<C>::tryPop(C& data)
+{
+	size_t posicion = inicio.load(std::memory_order_relaxed);
+	Celda* celda;
+	while (true)
+	{
+		celda = &celdas[posicion & mascara];
+		size_t secuencia = celda->secuencia.load(std::memory_order_acquire);
+		intptr_t diferencia = static_cast<intptr_t>(secuencia) - static_cast<intptr_t>(posicion + 1);
+
+		if (diferencia == 0)
+		{
+			if (inicio.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diferencia < 0)
+		{
+			return false; // Vaca: el productor de esta posicin todava no escribi
+		}
+		else
+		{
+			posicion = inicio.load(std::memory_order_relaxed);
+		}
+	}
+
+	C* elemento = reinterpret_cast<C*>(celda->datos);
+	data = std::move(*elemento);
+	elemento->~C();
+	celda->secuencia.store(posicion + capacidad, std::memory_order_release);
+	return true;
+}
+
+template<class C>
+bool ConcurrentQueue<C>::empty() const
+{
+	return size() == 0;
+}
+
+template<class C>
+size_t ConcurrentQueue<C>::size() const
+{
+	size_t leidos = inicio.load(std::memory_order_relaxed);
+	size_t escritos = final.load(std::memory_order_relaxed);
+	return escritos > leidos ? escritos - leidos : 0;
+}
+
+template<class C>
+size_t ConcurrentQueue<C>::getCapacidad() const
+{
+	return capacidad;
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "EpochManager.h"
+#include <atomic>
+#include <functional>
+
+// Pila sin bloqueos (pila de Treiber) para varios hilos.
+//
+// push y pop cambian la cima con un compare_exchange. Los nodos quitados se retiran al
+// EpochManager en lugar de borrarse, por lo que un hilo que todava lee la cima anterior nunca
+// accede a memoria liberada y una direccin no puede reutilizarse mientras alguien la compara
+// (problema ABA). Los elementos se copian al sacarlos: otro hilo puede estar leyndolos.
+template<class C>
+class ConcurrentStack
+{
+private:
+	struct Nodo
+	{
+		C data;
+		Nodo* siguiente;
+
+		Nodo(const C& data) : data(data), siguiente(nullptr) {}
+	};
+
+	std::atomic<Nodo*> cima;
+	std::atomic<size_t> length;
+
+public:
+	ConcurrentStack();
+	~ConcurrentStack();
+
+	ConcurrentStack(const ConcurrentStack<C>&) = delete;
+	ConcurrentStack<C>& operator=(const ConcurrentStack<C>&) = delete;
+
+	void push(const C& data);
+	// Retorna false si la pila est vaca
+	bool tryPop(C& data);
+	// Saca la cima solo si cumple 'condicion'; retorna false si est vaca o no la cumple
+	bool tryPopIf(C& data, const std::function<bool(const C&)>& condicion);
+	// Copia la cima sin sacarla; retorna false si la pila est vaca
+	bool top(C& data) const;
+
+	// Aproximados mientras haya otros hilos usando la pila
+	bool empty() const;
+	size_t size() const;
+
+	// Recorre desde la cima; los elementos agregados o sacados durante el recorrido pueden
+	// verse o no, pero nunca se lee un nodo liberado
+	void forEach(const std::function<void(const C&)>& operation) const;
+
+	void clear();
+};
+
+template<class C>
+ConcurrentStack<C>::ConcurrentStack() : cima(nullptr), length(0)
+{}
+
+template<class C>
+ConcurrentStack<C>::~ConcurrentStack()
+{
+	// Nadie ms usa la pila: los nodos que quedan se borran directamente
+	Nodo* nodo = cima.load();
+	while (nodo != nullptr)
+	{
+		Nodo* siguiente = nodo->siguiente;
+		delete nodo;
+		nodo = siguiente;
+	}
+}
+
+template<class C>
+void ConcurrentStack<C>::push(const C& data)
+{
+	Nodo* nuevo = new Nodo(data);
+	++length; // Antes de publicar: un pop concurrente no lo deja por debajo de cero
+	nuevo->siguiente = cima.load(std::memory_order_relaxed);
+	while (!cima.compare_exchange_weak(nuevo->siguiente, nuevo, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+}
+
+template<class C>
+bool ConcurrentStack<C>::tryPop(C& data)
+{
+	return tryPopIf(data, [](const C&) { return true; });
+}
+
+template<class C>
+bool ConcurrentStack<C>::tryPopIf(C& data, const std::function<bool(const C&)>& condicion)
+{
+	EpochManager::Guard guardia;
+	Nodo* nodo = cima.load(std::memory_order_acquire);
+	while (true)
+	{
+		if (nodo == nullptr || !condicion(nodo->data))
+		{
+			return false;
+		}
+		// Si otro hilo cambi la cima, 'nodo' se actualiza y se vuelve a evaluar la condicin
+		if (cima.compare_exchange_weak(nodo, nodo->siguiente, std::memory_order_acquire, std::memory_order_acquire))
+		{
+			break;
+		}
+	}
+
+	data = nodo->data;
+	--length;
+	EpochManager::instancia().retirar(nodo);
+	return true;
+}
+
+template<class C>
+bool ConcurrentStack<C>::top(C& data) const
+{
+	EpochManager::Guard guardia;
+	Nodo* nodo = cima.load(std::memory_order_acquire);
+	if (nodo == nullptr)
+	{
+		return false;
+	}
+	data = nodo->data;
+	return true;
+}
+
+template<class C>
+bool ConcurrentStack<C>::empty() const
+{
+	return cima.load(std::memory_order_acquire) == nullptr;
+}
+
+template<class C>
+size_t ConcurrentStack<C>::size() const
+{
+	return length.load(std::memory_order_relaxed);
+}
+
+template<class C>
+void ConcurrentStack<C>::forEach(const std::function<void(const C&)>& operation) const
+{
+	EpochManager::Guard guardia;
+	for (Nodo* nodo = cima.load(std::memory_order_acquire); nodo != nullptr; nodo = nodo->siguiente)
+	{
+		operation(nodo->data);
+	}
+}
+
+template<class C>
+void ConcurrentStack<C>::clear()
+{
+	C descartado;
+	while (tryPop(descartado))
+	{
+	}
+}
@@ -3,15 +3,20 @@
 #include "ISavable.h"
 #include "IDebugable.h"
 #include "IRandomizable.h"
+#include "Memoria.h"
+#include "Serializable.h"
+#include "NumeroFijo.h"
+#include "Validacion.h"
 
-class Contacto : public IDebugable, ISavable, IRandomizable
+class Contacto : public IDebugable, ISavable, IRandomizable, public Serializable<Contacto>
 {
 private:
-    string telefono;                 // Nmero de telfono de contacto
+    Telefono telefono;               // Nmero de telfono de contacto (9 dgitos)
     string correoElectronico;        // Direccin de correo electrnico de contacto
-    string departamento;             // Departamento de residencia
-    string provincia;                // Provincia de residencia
-    string distrito;                 // Distrito de residencia
+    // Vocabulario pequeo y repetido entre clientes: se guardan internados (ver PoolCadenas.h)
+    CadenaInterna departamento;      // Departamento de residencia
+    CadenaInterna provincia;         // Provincia de residencia
+    CadenaInterna distrito;          // Distrito de residencia
     string direccion;                // Direccin especfica de residencia
 
 public:
@@ -82,9 +87,24 @@ public:
     // Carga los datos desde una cadena en formato especfico
     void load(const string& datos) override;
 
-    void generateRandom() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
+
+    // Campos que se guardan, en orden (ver Serializable.h)
+    static constexpr auto esquema();
 };
 
+constexpr auto Contacto::esquema()
+{
+    return crearEsquema("Contacto", Serialization::DELIMITER_SECTION,
+        campo("telefono", &Contacto::telefono),
+        campo("correoElectronico", &Contacto::correoElectronico, &Contacto::setCorreoElectronico),
+        campo("departamento", &Contacto::departamento, &Contacto::setDepartamento),
+        campo("provincia", &Contacto::provincia, &Contacto::setProvincia),
+        campo("distrito", &Contacto::distrito, &Contacto::setDistrito),
+        campo("direccion", &Contacto::direccion, &Contacto::setDireccion));
+}
+
 // Constructor que inicializa los atributos con los valores proporcionados
 Contacto::Contacto(const std::string& telefono, const std::string& correoElectronico,
     const std::string& departamento, const std::string& provincia,
@@ -95,9 +115,9 @@ Contacto::Contacto(const std::string& telefono, const std::string& correoElectro
 
 // Constructor por defecto que inicializa atributos vacos
 Contacto::Contacto()
-    : telefono(""), correoElectronico(""),
-    departamento(""), provincia(""),
-    distrito(""), direccion("") {}
+    : telefono(), correoElectronico(""),
+    departamento(), provincia(),
+    distrito(), direccion("") {}
 
 // Constructor que carga informacin desde un string
 Contacto::Contacto(const std::string& datos)
@@ -106,7 +126,7 @@ Contacto::Contacto(const std::string& datos)
 }
 
 // Getters
-std::string Contacto::getTelefono() const { return telefono; }
+std::string Contacto::getTelefono() const { return telefono.toString(); }
 std::string Contacto::getCorreoElectronico() const { return correoElectronico; }
 std::string Contacto::getDepartamento() const { return departamento; }
 std::string Contacto::getProvincia() const { return provincia; }
@@ -116,13 +136,8 @@ std::string Contacto::getDireccion() const { return direccion; }
 // Setter para el telfono, debe tener 9 dgitos
 bool Contacto::setTelefono(const std::string& telefono)
 {
-    if (telefono.size() != 9) return false; // Debe tener 9 caracteres
-    for (char c : telefono)
-    {
-        if (c < '0' || c > '9') return false; // Solo dgitos permitidos
-    }
-    this->telefono = telefono; // Establece el telfono si es vlido
-    return true; // Retorna true si se establece con xito
+    // Debe tener 9 caracteres, solo dgitos; si no, se conserva el anterior
+    return this->telefono.asignar(telefono);
 }
 
 // Setter para el correo electrnico, debe contener '@' y '.'
@@ -130,27 +145,13 @@ bool Contacto::setCorreoElectronico(const std::string& correoElectronico)
 {
     if (correoElectronico.empty()) return false; // No debe estar vaco
 
-    bool tieneArroba = false; // Indica si hay '@'
-    bool tienePunto = false;  // Indica si hay '.'
-
-    for (size_t i = 0; i < correoElectronico.length(); ++i)
+    // '.' debe venir despus de '@'; se revisan 16 caracteres por instruccin (ver Validacion.h)
+    if (!Validacion::esCorreo(correoElectronico))
     {
-        if (correoElectronico[i] == '@')
-        {
-            tieneArroba = true; // Se encontr '@'
-        }
-        else if (tieneArroba && correoElectronico[i] == '.')
-        {
-            tienePunto = true; // '.' debe venir despus de '@'
-        }
+        return false; // Retorna false si el formato es invlido
     }
-
-    if (tieneArroba && tienePunto)
-    {
-        this->correoElectronico = correoElectronico; // Establecer el correo si es vlido
-        return true; // Retorna true si ambos estn presentes
-    }
-    return false; // Retorna false si el formato es invlido
+    this->correoElectronico = correoElectronico; // Establecer el correo si es vlido
+    return true; // Retorna true si ambos estn presentes
 }
 
 // Setter para el departamento
@@ -188,63 +189,31 @@ bool Contacto::setDireccion(const std::string& direccion)
 // Mtodo para retornar una representacin textual del objeto
 inline std::string Contacto::toDebug() const
 {
-    std::ostringstream debug; // Flujo para construir la representacin textual
-    debug << "Contacto(telefono='" << telefono << "'"
-        << ", correoElectronico='" << correoElectronico << "'"
-        << ", departamento='" << departamento << "'"
-        << ", provincia='" << provincia << "'"
-        << ", distrito='" << distrito << "'"
-        << ", direccion='" << direccion << "')"; // Construccin de la cadena de salida
-    return debug.str(); // Retorna la representacin textual
+    return depurar(); // Generada a partir del esquema
 }
 
 // Mtodo para guardar la informacin en un formato especfico
 std::string Contacto::toSave() const
 {
-    std::ostringstream out; // Flujo de salida para guardar datos
-    out << telefono << Serialization::DELIMITER_SECTION
-        << correoElectronico << Serialization::DELIMITER_SECTION
-        << departamento << Serialization::DELIMITER_SECTION
-        << provincia << Serialization::DELIMITER_SECTION
-        << distrito << Serialization::DELIMITER_SECTION
-        << direccion; // Guardar los atributos separados por el delimitador
-    return out.str(); // Retorna la cadena en formato de guardado
+    return guardar(); // Los atributos separados por el delimitador del esquema
 }
 
 // Mtodo para cargar informacin desde un string
 void Contacto::load(const std::string& data)
 {
-    std::istringstream in(data); // Flujo de entrada para cargar datos
-    if (!std::getline(in, telefono, Serialization::DELIMITER_SECTION) ||
-        !std::getline(in, correoElectronico, Serialization::DELIMITER_SECTION) ||
-        !std::getline(in, departamento, Serialization::DELIMITER_SECTION) ||
-        !std::getline(in, provincia, Serialization::DELIMITER_SECTION) ||
-        !std::getline(in, distrito, Serialization::DELIMITER_SECTION) ||
-        !std::getline(in, direccion, Serialization::DELIMITER_SECTION))
-    {
-        throw std::runtime_error("Error al cargar los datos: datos insuficientes o mal formateados.");
-    }
-
-    // Validar y asignar los atributos usando los setters
-    if (!setTelefono(telefono) ||
-        !setCorreoElectronico(correoElectronico) ||
-        !setDepartamento(departamento) ||
-        !setProvincia(provincia) ||
-        !setDistrito(distrito) ||
-        !setDireccion(direccion))
-    {
-        throw std::runtime_error("Error al asignar datos al contacto: formato invlido.");
-    }
+    ZonaMemoria zona(Subsistema::Identidades);
+    cargar(data); // Valida cada atributo con su setter
 }
 
 // Mtodo para generar correo electrnico aleatorio
-void Contacto::generateRandom() {
+void Contacto::generateRandom(Aleatorio& aleatorio) {
+    ZonaMemoria zona(Subsistema::Identidades);
     // Generar un telfono mvil aleatorio (empezando con 9, seguido de 8 dgitos aleatorios)
-    telefono.clear();
-    telefono += "9"; // El primer dgito de un nmero celular en Per siempre es 9
+    uint64_t numeroTelefono = 9; // El primer dgito de un nmero celular en Per siempre es 9
     for (int i = 0; i < 8; ++i) {
-        telefono += '0' + (rand() % 10); // Genera un dgito aleatorio entre 0 y 9
+        numeroTelefono = numeroTelefono * 10 + aleatorio.entero(10); // Agrega un dgito aleatorio entre 0 y 9
     }
+    telefono.setValor(numeroTelefono);
 
     // Generar un correo electrnico aleatorio usando palabras y nmeros
     const string palabras[] = {
@@ -253,11 +222,11 @@ void Contacto::generateRandom() {
     };
 
     // Elegir dos palabras aleatorias de las que ya no contienen caracteres especiales
-    string palabra1 = palabras[rand() % (sizeof(palabras) / sizeof(palabras[0]))];
-    string palabra2 = palabras[rand() % (sizeof(palabras) / sizeof(palabras[0]))];
+    string palabra1 = palabras[aleatorio.entero(sizeof(palabras) / sizeof(palabras[0]))];
+    string palabra2 = palabras[aleatorio.entero(sizeof(palabras) / sizeof(palabras[0]))];
 
     // Generar un nmero aleatorio para agregar al correo
-    int numero = rand() % 10000; // Nmero aleatorio de 4 dgitos
+    int numero = aleatorio.entero(10000); // Nmero aleatorio de 4 dgitos
 
     // Crear el correo electrnico
     correoElectronico = palabra1 + palabra2 + std::to_string(numero) + "@gmail.com";
@@ -275,12 +244,12 @@ void Contacto::generateRandom() {
     };
 
     // Generamos aleatoriamente un departamento, una provincia y un distrito
-    departamento = departamentos[rand() % (sizeof(departamentos) / sizeof(departamentos[0]))];
-    provincia = provincias[rand() % (sizeof(provincias) / sizeof(provincias[0]))];
-    distrito = distritos[rand() % (sizeof(distritos) / sizeof(distritos[0]))];
+    departamento = departamentos[aleatorio.entero(sizeof(departamentos) / sizeof(departamentos[0]))];
+    provincia = provincias[aleatorio.entero(sizeof(provincias) / sizeof(provincias[0]))];
+    distrito = distritos[aleatorio.entero(sizeof(distritos) / sizeof(distritos[0]))];
 
     // Generar una direccin aleatoria, puede incluir un nmero de casa
     stringstream direccionStream;
-    direccionStream << "Calle " << rand() % 100 + 1 << " (" << (rand() % 3 == 0 ? "Avenida" : "Jiron") << ")";
+    direccionStream << "Calle " << aleatorio.entero(100) + 1 << " (" << (aleatorio.entero(3) == 0 ? "Avenida" : "Jiron") << ")";
     direccion = direccionStream.str();
 }
\ No newline at end of file
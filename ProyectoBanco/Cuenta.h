@@ -2,72 +2,238 @@
 
 #include "IInteractive.h"
 #include "SQueue.h"
+#include "ConcurrentLog.h"
 #include "AVLTree.h"
 #include "Tarjeta.h"
 #include "Transaccion.h"
+#include "BloqueHistorial.h"
+#include "Operacion.h"
+#include "SeqLock.h"
+#include "EpochManager.h"
+#include "Metricas.h"
+#include "Memoria.h"
+#include "NumeroFijo.h"
+
+// Estado de una cuenta en un instante: el saldo y cuntas transacciones del historial lo
+// produjeron. El historial solo crece, as que ese prefijo se puede recorrer despus sin copiarlo.
+// La cuenta publica cada estado como una InstantaneaCuenta inmutable (ver Cuenta::_publicar)
+struct InstantaneaCuenta
+{
+    long long saldo = 0;        // Cntimos
+    size_t transacciones = 0;   // Prefijo del historial que corresponde a 'saldo'
+};
 
 class Cuenta : public IDebugable, ISavable, IShowable, IRandomizable, IInteractive
 {
 private:
     Fecha fechaActual;              // Fecha actual en la cuenta
-    string numeroCuenta;            // Nmero de la cuenta bancaria
-    Tarjeta tarjeta;    // Tarjeta de dbito asociada
-    SQueue<Transaccion> historial;  // Historial de transacciones
+    NumeroCuenta numeroCuenta;      // Nmero de la cuenta bancaria (12 dgitos)
+    Tarjeta tarjeta;    // Tarjeta de dbito asociada; su saldo es el inicial, el vigente est en 'estado'
+    ConcurrentLog<RegistroTransaccion> historial{ Subsistema::Historiales };  // Historial compacto; cada posicin la escribe quien la gan en 'estado'
+    atomic<InstantaneaCuenta*> estado;  // Saldo y largo del historial vigentes; cada movimiento publica uno nuevo
+    SeqLock transferencias;         // Solo lo toman las transferencias, para que getInstantaneas las vea completas
+
+    // Publica el estado siguiente con un compare_exchange y retira el anterior al EpochManager.
+    // calcular(saldo, cantidad) recibe el saldo vigente, lo actualiza y pone en 'cantidad' las
+    // transacciones a agregar; retorna false para no publicar nada. Se repite si otro hilo public
+    // entretanto. En 'posicion' queda la primera posicin del historial ganada, que el llamador
+    // escribe con historial.colocar
+    template<class Calcular>
+    bool _publicar(Calcular calcular, size_t& posicion);
+    // Reemplaza el estado sin calcularlo: al armar o cargar la cuenta
+    void _reiniciarEstado(long long saldo);
+    // Espera a que el historial publique las primeras 'transacciones' posiciones (sus escritores
+    // ya ganaron el estado y solo les falta copiar el registro)
+    void _esperarHistorial(size_t transacciones) const;
+    bool _activa() const;
 
     // Mtodos privados de operaciones
     bool _addDeposito(const Fecha& fecha, const float& monto);
     bool _addRetiro(const Fecha& fecha, const float& monto);
     float _totalRecursivoDepositos(const SQueue<Transaccion>& depositos, SQueue<Transaccion>::Iterator it) const;
     float _totalRecursivoRetiros(const SQueue<Transaccion>& retiros, SQueue<Transaccion>::Iterator it) const;
-    Monto _totalDepositos(size_t& numeroDepositos) const;
-    Monto _totalRetiros(size_t& numeroRetiros) const;
+    Monto _totalDepositos(const InstantaneaCuenta& instantanea, size_t& numeroDepositos) const;
+    Monto _totalRetiros(const InstantaneaCuenta& instantanea, size_t& numeroRetiros) const;
 
     // Mtodos de visualizacin privados
-    void _showDatos() const;
-    void _showHistorial() const;
-    void _showReporte() const;
+    void _showDatos(ostream& out) const;
+    void _showHistorial(ostream& out) const;
+    void _showReporte(ostream& out) const;
 
     // Mtodos de interaccin privados
-    void _interactDepositar();
-    void _interactRetirar();
+    Tarea _interactDepositar(Sesion& sesion);
+    Tarea _interactRetirar(Sesion& sesion);
 
 public:
     // Constructores y destructor
     Cuenta(const Fecha& fechaActual, string& numeroCuenta, const Tarjeta& tarjeta);
     Cuenta(const Fecha& fechaActual, const string& datos);
     Cuenta();
-    ~Cuenta() = default;
+    // Copia el saldo y el historial de un mismo instante de 'other'
+    Cuenta(const Cuenta& other);
+    Cuenta& operator=(const Cuenta& other);
+    ~Cuenta();
 
     // Getters
     Fecha getFechaActual() const;
     string getNumeroCuenta() const;
+    // Nmero de cuenta como entero de 12 dgitos (clave de los ndices)
+    NumeroCuenta getNumeroCuentaNumerico() const;
+    // Copia de la tarjeta con el saldo vigente
     Tarjeta getTarjeta() const;
+    // Saldo actual en cntimos (sin copiar la tarjeta)
+    long long getSaldoCentimos() const;
     SQueue<Transaccion> getHistorial() const;
+    // Recorre los registros del historial sin copiarlos
+    void recorrerHistorial(const function<void(const RegistroTransaccion&)>& operacion) const;
+    // Saldo e historial de un mismo instante; no bloquea a quienes depositan o retiran ni los espera
+    InstantaneaCuenta getInstantanea() const;
+    // Instantneas de varias cuentas en un mismo instante (una transferencia entre ellas se ve
+    // completa o no se ve)
+    static vector<InstantaneaCuenta> getInstantaneas(const vector<const Cuenta*>& cuentas);
+    // Historial hasta el instante de la instantnea
+    SQueue<Transaccion> getHistorial(const InstantaneaCuenta& instantanea) const;
+    void recorrerHistorial(const InstantaneaCuenta& instantanea, const function<void(const RegistroTransaccion&)>& operacion) const;
+    // Codifica el historial en un bloque comprimido
+    BloqueHistorial comprimirHistorial() const;
 
     // Setters
     bool setFechaActual(const Fecha& fecha);
     bool setNumeroCuenta(const string& numeroCuenta);
+    // El saldo de la tarjeta pasa a ser el saldo vigente
     bool setTarjeta(const Tarjeta& Tarjeta);
+    // Los setHistorial, load y generateRandom no son seguros entre hilos: solo al armar o cargar
+    // la cuenta, mientras nadie ms la usa (vacan el registro del historial)
     bool setHistorial(const SQueue<Transaccion>& historial);
+    // Reemplaza el historial por el contenido de un bloque comprimido
+    bool setHistorial(const BloqueHistorial& bloque);
+    // Reemplaza el historial por registros compactos (en orden cronolgico)
+    bool setHistorial(const vector<RegistroTransaccion>& registros);
+
+    // Operaciones seguras entre hilos y sin bloqueos: el movimiento se registra solo si el saldo
+    // cambi, y el saldo y su posicin en el historial se publican juntos
+    bool depositar(const Fecha& fecha, const Monto& monto);
+    bool retirar(const Fecha& fecha, const Monto& monto);
+    // Mueve el monto a otra cuenta y registra el retiro y el depsito correspondientes; las
+    // instantneas la ven completa. Quien necesite serializarla con otras usa MotorTransferencias
+    bool transferir(Cuenta& destino, const Fecha& fecha, const Monto& monto);
+    // Aplica en orden las operaciones operaciones[indices[0..cantidad)] de esta cuenta con un solo
+    // estado publicado y un solo agregado al historial; escribe el estado de cada una
+    size_t aplicarLote(const vector<Operacion>& operaciones, const size_t* indices, size_t cantidad,
+        vector<EstadoOperacion>& estados);
 
     // Mtodos de interfaces
     string toDebug() const override;
     string toSave() const override;
     void load(const string& data) override;
+    // Versiones no virtuales que usa Cliente al guardar y cargar en bloque: agregan al final de
+    // 'destino' y leen de una vista, sin cadenas intermedias por cada transaccin
+    void guardarEn(string& destino) const;
+    void cargar(string_view datos);
     string toShow() const override;
-    void generateRandom() override;
-    void interact() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
+    Tarea interactuar(Sesion& sesion) override;
+    using IInteractive::interact;
 };
 // Constructores
 Cuenta::Cuenta(const Fecha& fechaActual, string& numeroCuenta, const Tarjeta& tarjeta)
-    : fechaActual(fechaActual), numeroCuenta(numeroCuenta), tarjeta(tarjeta) {}
+    : fechaActual(fechaActual), numeroCuenta(numeroCuenta), tarjeta(tarjeta),
+    estado(new InstantaneaCuenta{ tarjeta.getSaldoCentimos(), 0 }) {}
 
-Cuenta::Cuenta(const Fecha& fechaActual, const string& datos) : fechaActual(fechaActual) {
+Cuenta::Cuenta(const Fecha& fechaActual, const string& datos)
+    : fechaActual(fechaActual), estado(new InstantaneaCuenta()) {
     load(datos);
 }
 
 Cuenta::Cuenta()
-    : numeroCuenta(""), tarjeta(Tarjeta()), fechaActual(Fecha()) {}
+    : numeroCuenta(), tarjeta(Tarjeta()), fechaActual(Fecha()), estado(new InstantaneaCuenta()) {}
+
+Cuenta::Cuenta(const Cuenta& other)
+    : fechaActual(other.fechaActual), numeroCuenta(other.numeroCuenta), tarjeta(other.tarjeta),
+    estado(new InstantaneaCuenta(other.getInstantanea())) {
+    other.recorrerHistorial(*estado.load(), [this](const RegistroTransaccion& registro) {
+        historial.push(registro);
+        });
+}
+
+Cuenta& Cuenta::operator=(const Cuenta& other) {
+    if (this != &other) {
+        InstantaneaCuenta instantanea = other.getInstantanea();
+        fechaActual = other.fechaActual;
+        numeroCuenta = other.numeroCuenta;
+        tarjeta = other.tarjeta;
+        historial.clear();
+        other.recorrerHistorial(instantanea, [this](const RegistroTransaccion& registro) {
+            historial.push(registro);
+            });
+        _reiniciarEstado(instantanea.saldo);
+    }
+    return *this;
+}
+
+// Nadie ms usa la cuenta: el estado vigente se borra directamente (los anteriores ya se retiraron)
+Cuenta::~Cuenta() {
+    delete estado.load();
+}
+
+// Estado
+template<class Calcular>
+bool Cuenta::_publicar(Calcular calcular, size_t& posicion) {
+    // Dentro de la seccin ningn estado retirado se libera: 'actual' sigue siendo legible aunque
+    // otro hilo lo reemplace, y su direccin no puede reutilizarse entre la lectura y el intercambio
+    EpochManager::Guard guardia;
+    InstantaneaCuenta* actual = estado.load(memory_order_acquire);
+    InstantaneaCuenta* nuevo = nullptr;
+    while (true) {
+        long long saldo = actual->saldo;
+        size_t cantidad = 0;
+        if (!calcular(saldo, cantidad)) {
+            delete nuevo; // Nunca se public
+            return false;
+        }
+        if (cantidad == 0 && saldo == actual->saldo) {
+            delete nuevo; // Nada que publicar
+            posicion = actual->transacciones;
+            return true;
+        }
+        if (nuevo == nullptr) {
+            nuevo = EpochManager::instancia().reutilizar<InstantaneaCuenta>();
+        }
+        if (nuevo == nullptr) {
+            ZonaMemoria zona(Subsistema::Dominio);
+            nuevo = new InstantaneaCuenta();
+        }
+        nuevo->saldo = saldo;
+        nuevo->transacciones = actual->transacciones + cantidad;
+        if (estado.compare_exchange_weak(actual, nuevo, memory_order_acq_rel, memory_order_acquire)) {
+            break;
+        }
+    }
+    posicion = actual->transacciones;
+    // El estado reemplazado vuelve a usarse como estado nuevo de una publicacin posterior
+    // de este hilo: en rgimen las publicaciones no reservan memoria
+    EpochManager::instancia().reciclar(actual);
+    return true;
+}
+
+void Cuenta::_reiniciarEstado(long long saldo) {
+    ZonaMemoria zona(Subsistema::Dominio);
+    InstantaneaCuenta* anterior = estado.exchange(new InstantaneaCuenta{ saldo, historial.size() });
+    if (anterior != nullptr) {
+        EpochManager::instancia().retirar(anterior);
+    }
+}
+
+void Cuenta::_esperarHistorial(size_t transacciones) const {
+    while (historial.size() < transacciones) {
+        this_thread::yield();
+    }
+}
+
+bool Cuenta::_activa() const {
+    return tarjeta.getEstado() == Tarjeta::EstadoTarjeta::Activa;
+}
 
 // Getters
 Fecha Cuenta::getFechaActual() const {
@@ -75,15 +241,94 @@ Fecha Cuenta::getFechaActual() const {
 }
 
 string Cuenta::getNumeroCuenta() const {
+    return numeroCuenta.toString();
+}
+
+NumeroCuenta Cuenta::getNumeroCuentaNumerico() const {
     return numeroCuenta;
 }
 
 Tarjeta Cuenta::getTarjeta() const {
-    return tarjeta;
+    Tarjeta copia = tarjeta;
+    copia.setSaldoCentimos(getSaldoCentimos());
+    return copia;
+}
+
+long long Cuenta::getSaldoCentimos() const {
+    EpochManager::Guard guardia;
+    return estado.load(memory_order_acquire)->saldo;
 }
 
 SQueue<Transaccion> Cuenta::getHistorial() const {
-    return historial;
+    SQueue<Transaccion> copia;
+    historial.forEach([&copia](const RegistroTransaccion& registro) {
+        copia.push(Transaccion(registro));
+        });
+    return copia;
+}
+
+void Cuenta::recorrerHistorial(const function<void(const RegistroTransaccion&)>& operacion) const {
+    historial.forEach(operacion);
+}
+
+// Un solo estado publicado: basta copiarlo, sin cerrojos ni reintentos
+InstantaneaCuenta Cuenta::getInstantanea() const {
+    InstantaneaCuenta instantanea;
+    {
+        EpochManager::Guard guardia;
+        instantanea = *estado.load(memory_order_acquire);
+    }
+    _esperarHistorial(instantanea.transacciones);
+    return instantanea;
+}
+
+// Una transferencia publica dos estados; 'transferencias' cambia mientras tanto y entonces se
+// vuelven a leer. Los depsitos y retiros sueltos no lo tocan
+vector<InstantaneaCuenta> Cuenta::getInstantaneas(const vector<const Cuenta*>& cuentas) {
+    vector<InstantaneaCuenta> instantaneas(cuentas.size());
+    vector<uint64_t> inicios(cuentas.size());
+    bool valida = false;
+    while (!valida) {
+        for (size_t i = 0; i < cuentas.size(); ++i) {
+            inicios[i] = cuentas[i]->transferencias.iniciarLectura();
+        }
+        {
+            EpochManager::Guard guardia;
+            for (size_t i = 0; i < cuentas.size(); ++i) {
+                instantaneas[i] = *cuentas[i]->estado.load(memory_order_acquire);
+            }
+        }
+        valida = true;
+        for (size_t i = 0; i < cuentas.size() && valida; ++i) {
+            valida = cuentas[i]->transferencias.validarLectura(inicios[i]);
+        }
+    }
+    for (size_t i = 0; i < cuentas.size(); ++i) {
+        cuentas[i]->_esperarHistorial(instantaneas[i].transacciones);
+    }
+    return instantaneas;
+}
+
+SQueue<Transaccion> Cuenta::getHistorial(const InstantaneaCuenta& instantanea) const {
+    SQueue<Transaccion> copia;
+    recorrerHistorial(instantanea, [&copia](const RegistroTransaccion& registro) {
+        copia.push(Transaccion(registro));
+        });
+    return copia;
+}
+
+void Cuenta::recorrerHistorial(const InstantaneaCuenta& instantanea, const function<void(const RegistroTransaccion&)>& operacion) const {
+    for (size_t i = 0; i < instantanea.transacciones && i < historial.size(); ++i) {
+        operacion(historial.at(i));
+    }
+}
+
+BloqueHistorial Cuenta::comprimirHistorial() const {
+    BloqueHistorial bloque;
+    for (const auto& registro : historial) {
+        bloque.agregar(registro);
+    }
+    return bloque;
 }
 
 // Setters
@@ -93,41 +338,169 @@ bool Cuenta::setFechaActual(const Fecha& fecha) {
 }
 
 bool Cuenta::setNumeroCuenta(const string& numeroCuenta) {
-    if (numeroCuenta.size() != 12) {
-        return false;
-    }
-    for (char c : numeroCuenta) {
-        if (c < '0' || c > '9') return false; // Solo dgitos permitidos
-    }
-    this->numeroCuenta = numeroCuenta;
-    return true;
+    // 12 dgitos; si no es vlido se conserva el anterior
+    return this->numeroCuenta.asignar(numeroCuenta);
 }
 
 bool Cuenta::setTarjeta(const Tarjeta& Tarjeta) {
     this->tarjeta = Tarjeta;
-    return true;
+    size_t posicion;
+    long long saldo = Tarjeta.getSaldoCentimos();
+    return _publicar([saldo](long long& vigente, size_t&) {
+        vigente = saldo;
+        return true;
+        }, posicion);
 }
 
 bool Cuenta::setHistorial(const SQueue<Transaccion>& historial) {
-    this->historial = historial;
+    long long saldo = getSaldoCentimos();
+    this->historial.clear();
+    for (const auto& transaccion : historial) {
+        this->historial.push(transaccion.toRegistro());
+    }
+    _reiniciarEstado(saldo);
+    return true;
+}
+
+bool Cuenta::setHistorial(const BloqueHistorial& bloque) {
+    vector<RegistroTransaccion> registros;
+    bloque.decodificar(registros);
+    return setHistorial(registros);
+}
+
+bool Cuenta::setHistorial(const vector<RegistroTransaccion>& registros) {
+    long long saldo = getSaldoCentimos();
+    historial.clear();
+    historial.push(registros);
+    _reiniciarEstado(saldo);
     return true;
 }
 
 // Mtodos de operaciones
 bool Cuenta::_addDeposito(const Fecha& fecha, const float& monto) {
     if (monto <= 0) return false;
-    historial.push(Transaccion(monto, fecha, TipoTransaccion::Deposito));
-    tarjeta.depositar(monto);
-    return true;
+    return depositar(fecha, Monto(monto));
 }
 
 bool Cuenta::_addRetiro(const Fecha& fecha, const float& monto) {
-    if (monto <= 0 || monto > tarjeta.getSaldoFloat()) return false;
-    historial.push(Transaccion(monto, fecha, TipoTransaccion::Retiro));
-    tarjeta.retirar(monto);
+    if (monto <= 0) return false;
+    return retirar(fecha, Monto(monto));
+}
+
+bool Cuenta::depositar(const Fecha& fecha, const Monto& monto) {
+    static Histograma latencia("Cuenta.depositar");
+    Cronometro cronometro(latencia);
+    long long centimos = monto.getTotalCentimos();
+    if (!_activa() || centimos <= 0) return false;
+    size_t posicion;
+    _publicar([centimos](long long& saldo, size_t& cantidad) {
+        saldo += centimos;
+        cantidad = 1;
+        return true;
+        }, posicion);
+    historial.colocar(posicion, RegistroTransaccion::crear(monto, fecha, TipoTransaccion::Deposito));
+    return true;
+}
+
+bool Cuenta::retirar(const Fecha& fecha, const Monto& monto) {
+    static Histograma latencia("Cuenta.retirar");
+    Cronometro cronometro(latencia);
+    long long centimos = monto.getTotalCentimos();
+    if (!_activa() || centimos <= 0) return false;
+    // El saldo se verifica contra el estado vigente; si otro hilo public antes, se vuelve a verificar
+    size_t posicion;
+    bool alcanza = _publicar([centimos](long long& saldo, size_t& cantidad) {
+        if (saldo < centimos) return false;
+        saldo -= centimos;
+        cantidad = 1;
+        return true;
+        }, posicion);
+    if (!alcanza) return false;
+    historial.colocar(posicion, RegistroTransaccion::crear(monto, fecha, TipoTransaccion::Retiro));
+    return true;
+}
+
+bool Cuenta::transferir(Cuenta& destino, const Fecha& fecha, const Monto& monto) {
+    static Histograma latencia("Cuenta.transferir");
+    Cronometro cronometro(latencia);
+    long long centimos = monto.getTotalCentimos();
+    if (&destino == this || centimos <= 0 || !_activa() || !destino._activa()) return false;
+
+    // Para getInstantaneas ambas cuentas cambian juntas; se bloquean en orden de direccin para
+    // que dos transferencias cruzadas no se esperen mutuamente. Los depsitos y retiros sueltos
+    // de las dos cuentas siguen sin esperar
+    SeqLock::Escritura primera(this < &destino ? transferencias : destino.transferencias);
+    SeqLock::Escritura segunda(this < &destino ? destino.transferencias : transferencias);
+    size_t posicionRetiro, posicionDeposito;
+    bool alcanza = _publicar([centimos](long long& saldo, size_t& cantidad) {
+        if (saldo < centimos) return false;
+        saldo -= centimos;
+        cantidad = 1;
+        return true;
+        }, posicionRetiro);
+    if (!alcanza) return false;
+    destino._publicar([centimos](long long& saldo, size_t& cantidad) {
+        saldo += centimos;
+        cantidad = 1;
+        return true;
+        }, posicionDeposito);
+    historial.colocar(posicionRetiro, RegistroTransaccion::crear(monto, fecha, TipoTransaccion::Retiro));
+    destino.historial.colocar(posicionDeposito, RegistroTransaccion::crear(monto, fecha, TipoTransaccion::Deposito));
     return true;
 }
 
+size_t Cuenta::aplicarLote(const vector<Operacion>& operaciones, const size_t* indices, size_t cantidad,
+    vector<EstadoOperacion>& estados) {
+    static Histograma latencia("Cuenta.aplicarLote");
+    Cronometro cronometro(latencia);
+    if (!_activa()) {
+        for (size_t k = 0; k < cantidad; ++k) {
+            estados[indices[k]] = EstadoOperacion::TarjetaInactiva;
+        }
+        return 0;
+    }
+
+    // Se simula el lote sobre el saldo vigente; si otro hilo public un estado entretanto, se
+    // vuelve a simular sobre el nuevo
+    vector<RegistroTransaccion> aplicadas;
+    aplicadas.reserve(cantidad);
+    size_t posicion;
+    _publicar([&](long long& saldo, size_t& nuevas) {
+        aplicadas.clear();
+        for (size_t k = 0; k < cantidad; ++k) {
+            const Transaccion& transaccion = operaciones[indices[k]].transaccion;
+            long long centimos = transaccion.getMontoMonto().getTotalCentimos();
+            EstadoOperacion& estado = estados[indices[k]];
+
+            if (centimos <= 0) {
+                estado = EstadoOperacion::MontoInvalido;
+            }
+            else if (transaccion.getTipo() == TipoTransaccion::Deposito) {
+                saldo += centimos;
+                estado = EstadoOperacion::Aplicada;
+            }
+            else if (transaccion.getTipo() != TipoTransaccion::Retiro) {
+                estado = EstadoOperacion::TipoInvalido;
+            }
+            else if (saldo < centimos) {
+                estado = EstadoOperacion::SaldoInsuficiente;
+            }
+            else {
+                saldo -= centimos;
+                estado = EstadoOperacion::Aplicada;
+            }
+            if (estado == EstadoOperacion::Aplicada) {
+                aplicadas.push_back(transaccion.toRegistro());
+            }
+        }
+        nuevas = aplicadas.size();
+        return true;
+        }, posicion);
+
+    historial.colocar(posicion, aplicadas);
+    return aplicadas.size();
+}
+
 float Cuenta::_totalRecursivoDepositos(const SQueue<Transaccion>& depositos, SQueue<Transaccion>::Iterator it) const {
     return (it != depositos.end()) ? (*it).getMontoFloat() + _totalRecursivoDepositos(depositos, ++it) : 0;
 }
@@ -136,58 +509,63 @@ float Cuenta::_totalRecursivoRetiros(const SQueue<Transaccion>& retiros, SQueue<
     return (it != retiros.end()) ? (*it).getMontoFloat() + _totalRecursivoRetiros(retiros, ++it) : 0;
 }
 
-Monto Cuenta::_totalDepositos(size_t& numeroDepositos) const {
-    auto depositos = historial.filter([](const Transaccion& t) { return t.getTipo() == TipoTransaccion::Deposito; });
+Monto Cuenta::_totalDepositos(const InstantaneaCuenta& instantanea, size_t& numeroDepositos) const {
+    auto depositos = getHistorial(instantanea).filter([](const Transaccion& t) { return t.getTipo() == TipoTransaccion::Deposito; });
     numeroDepositos = depositos.size();
     return Monto(_totalRecursivoDepositos(depositos, depositos.begin()));
 }
 
-Monto Cuenta::_totalRetiros(size_t& numeroRetiros) const {
-    auto retiros = historial.filter([](const Transaccion& t) { return t.getTipo() == TipoTransaccion::Retiro; });
+Monto Cuenta::_totalRetiros(const InstantaneaCuenta& instantanea, size_t& numeroRetiros) const {
+    auto retiros = getHistorial(instantanea).filter([](const Transaccion& t) { return t.getTipo() == TipoTransaccion::Retiro; });
     numeroRetiros = retiros.size();
     return Monto(_totalRecursivoRetiros(retiros, retiros.begin()));
 }
 
 // Visualizacin
-void Cuenta::_showDatos() const {
-    cout << toShow();
+void Cuenta::_showDatos(ostream& out) const {
+    out << toShow();
 }
 
-void Cuenta::_showHistorial() const {
-    for (Transaccion transaccion : historial) {
-        cout << transaccion.toShow() << endl;
+void Cuenta::_showHistorial(ostream& out) const {
+    for (const auto& registro : historial) {
+        out << Transaccion(registro).toShow() << '\n';
     }
 }
 
-void Cuenta::_showReporte() const {
+void Cuenta::_showReporte(ostream& out) const {
+    // Totales y saldo del mismo instante aunque otros hilos sigan operando la cuenta
+    InstantaneaCuenta instantanea = getInstantanea();
+    Monto saldo;
+    saldo.setTotalCentimos(instantanea.saldo);
+
     size_t numeroDepositos, numeroRetiros;
-    cout << "=== Reporte de Cuenta ===\n";
-    cout << "Total Depositos: " << _totalDepositos(numeroDepositos).toString() << '\n';
-    cout << "Total Retiros: " << _totalRetiros(numeroRetiros).toString() << '\n';
-    cout << "Numero Depositos: " << numeroDepositos << '\n';
-    cout << "Numero Retiros: " << numeroRetiros << '\n';
-    cout << "Saldo Actual: " << tarjeta.getSaldoMonto().toString() << '\n';
+    out << "=== Reporte de Cuenta ===\n";
+    out << "Total Depositos: " << _totalDepositos(instantanea, numeroDepositos).toString() << '\n';
+    out << "Total Retiros: " << _totalRetiros(instantanea, numeroRetiros).toString() << '\n';
+    out << "Numero Depositos: " << numeroDepositos << '\n';
+    out << "Numero Retiros: " << numeroRetiros << '\n';
+    out << "Saldo Actual: " << saldo.toString() << '\n';
 }
 
 // Interaccin
-void Cuenta::_interactDepositar() {
+Tarea Cuenta::_interactDepositar(Sesion& sesion) {
     float monto;
-    cout << "Ingrese monto a depositar: ";
-    cin >> monto;
-    if (_addDeposito(fechaActual, monto))
-        cout << "Deposito exitoso.\n";
+    sesion.out() << "Ingrese monto a depositar: ";
+    optional<string> linea = co_await sesion.leerLinea();
+    if (linea && Sesion::convertir(*linea, monto) && _addDeposito(fechaActual, monto))
+        sesion.out() << "Deposito exitoso.\n";
     else
-        cout << "Deposito fallido.\n";
+        sesion.out() << "Deposito fallido.\n";
 }
 
-void Cuenta::_interactRetirar() {
+Tarea Cuenta::_interactRetirar(Sesion& sesion) {
     float monto;
-    cout << "Ingrese monto a retirar: ";
-    cin >> monto;
-    if (_addRetiro(fechaActual, monto))
-        cout << "Retiro exitoso.\n";
+    sesion.out() << "Ingrese monto a retirar: ";
+    optional<string> linea = co_await sesion.leerLinea();
+    if (linea && Sesion::convertir(*linea, monto) && _addRetiro(fechaActual, monto))
+        sesion.out() << "Retiro exitoso.\n";
     else
-        cout << "Retiro fallido.\n";
+        sesion.out() << "Retiro fallido.\n";
 }
 
 // Interfaces
@@ -195,7 +573,7 @@ string Cuenta::toDebug() const {
     ostringstream out;
     out << "CuentaBancaria(numCuenta=" << numeroCuenta
         << ", fechaActual=" << fechaActual.toStringDDMMAAAA()
-        << ", saldo=" << tarjeta.getSaldoMonto().toDebug() << ")";
+        << ", saldo=" << getTarjeta().getSaldoMonto().toDebug() << ")";
     //    << ", historial=";
 
     //// Recorremos el historial con un bucle simplificado
@@ -215,48 +593,78 @@ string Cuenta::toDebug() const {
 }
 
 string Cuenta::toSave() const {
-    ostringstream out;
-    out << numeroCuenta << Serialization::DELIMITER_SECTION << tarjeta.toSave() << Serialization::DELIMITER_SECTION;
-    for (Transaccion transaccion : historial) {
-        out << transaccion.toSave() << Serialization::DELIMITER_SECTION;
-    }
-    return out.str();
+    string out;
+    guardarEn(out);
+    return out;
 }
 
 void Cuenta::load(const string& data) {
-    istringstream in(data);
-    string cuentaStr, tarjetaData, transaccionData;
+    cargar(data);
+}
+
+void Cuenta::guardarEn(string& destino) const {
+    static Histograma latencia("Cuenta.toSave");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Serializacion);
+    // El saldo guardado es el del mismo instante que el historial guardado
+    InstantaneaCuenta instantanea = getInstantanea();
+    Tarjeta copia = tarjeta;
+    copia.setSaldoCentimos(instantanea.saldo);
+    numeroCuenta.escribirEn(destino);
+    destino += Serialization::DELIMITER_SECTION;
+    destino += copia.toSave();
+    destino += Serialization::DELIMITER_SECTION;
+    for (size_t i = 0; i < instantanea.transacciones; ++i) {
+        Transaccion(historial.at(i)).guardarEn(destino);
+        destino += Serialization::DELIMITER_SECTION;
+    }
+}
+
+void Cuenta::cargar(string_view datos) {
+    static Histograma latencia("Cuenta.load");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Dominio);
+    size_t posicion = 0;
+    string_view cuentaStr, tarjetaData, transaccionData;
 
-    if (!getline(in, cuentaStr, Serialization::DELIMITER_SECTION) ||
-        !getline(in, tarjetaData, Serialization::DELIMITER_SECTION)) {
+    if (!leerCampo(datos, posicion, Serialization::DELIMITER_SECTION, cuentaStr) ||
+        !leerCampo(datos, posicion, Serialization::DELIMITER_SECTION, tarjetaData)) {
         throw runtime_error("Datos incompletos para cargar la cuenta bancaria.");
     }
 
-    numeroCuenta = cuentaStr;
-    tarjeta.load(tarjetaData);
+    // Una cuenta sin nmero se guarda con el campo vaco
+    numeroCuenta.clear();
+    if (!cuentaStr.empty() && !numeroCuenta.asignar(cuentaStr)) {
+        throw runtime_error("Nmero de cuenta invlido.");
+    }
+    tarjeta.load(string(tarjetaData));
 
-    while (getline(in, transaccionData, Serialization::DELIMITER_SECTION)) {
-        Transaccion t;
-        t.load(transaccionData);
-        historial.push(t);
+    Transaccion t;
+    while (leerCampo(datos, posicion, Serialization::DELIMITER_SECTION, transaccionData)) {
+        t.cargar(transaccionData);
+        historial.push(t.toRegistro());
     }
+    _reiniciarEstado(tarjeta.getSaldoCentimos());
 }
 
 string Cuenta::toShow() const {
     ostringstream out;
-    out << "Cuenta N: " << numeroCuenta << "\nSaldo: " << tarjeta.getSaldoMonto().toString() << "\n";
+    Monto saldo;
+    saldo.setTotalCentimos(getSaldoCentimos());
+    out << "Cuenta N: " << numeroCuenta << "\nSaldo: " << saldo.toString() << "\n";
     return out.str();
 }
 
-void Cuenta::generateRandom() {
+void Cuenta::generateRandom(Aleatorio& aleatorio) {
     // Generar nmero de cuenta aleatorio de 12 dgitos
-    numeroCuenta.clear();
+    uint64_t numero = 0;
     for (int i = 0; i < 12; ++i) {
-        numeroCuenta += '0' + (rand() % 10);
+        numero = numero * 10 + aleatorio.entero(10);
     }
+    numeroCuenta.setValor(numero);
 
     // Generar datos aleatorios para la tarjeta de dbito
-    tarjeta.generateRandom();
+    tarjeta.generateRandom(aleatorio);
 
     // Limpiar historial
     historial.clear();
@@ -270,44 +678,45 @@ void Cuenta::generateRandom() {
     AVLTree<Transaccion> historialTree(compare);
 
     // Generar entre 1 y 10 transacciones aleatorias
-    size_t n = 1 + rand() % 10;
+    size_t n = 1 + aleatorio.entero(10);
     for (size_t i = 0; i < n; ++i) {
         Transaccion t;
-        t.generateRandom();
+        t.generateRandom(aleatorio);
         historialTree.insert(t); // Insertar en el rbol AVL
     }
 
     // Transferir las transacciones ordenadas desde el rbol AVL al historial (deque o lista)
     while (!historialTree.empty()) {
-        historial.push(historialTree.getBack());  // Obtener el ltimo elemento (ms antiguo)
+        historial.push(historialTree.getBack().toRegistro());  // Obtener el ltimo elemento (ms antiguo)
         historialTree.popBack();                  // Eliminar el ltimo elemento del rbol
     }
+    _reiniciarEstado(tarjeta.getSaldoCentimos());
 }
 
-void Cuenta::interact() {
-    int opcion;
-    do {
-        cout << "=== Menu de Cuenta ===\n";
-        cout << "1. Mostrar datos\n2. Mostrar historial\n3. Mostrar reporte\n4. Depositar\n5. Retirar\n6. Salir\n";
-        cout << "Seleccione una opcin: ";
-        cin >> opcion;
-
-        if (cin.fail()) {
-            cin.clear();
-            cin.ignore();
-            cout << "Entrada invlida. Intente nuevamente.\n";
+Tarea Cuenta::interactuar(Sesion& sesion) {
+    ostream& out = sesion.out();
+    while (true) {
+        out << "=== Menu de Cuenta ===\n";
+        out << "1. Mostrar datos\n2. Mostrar historial\n3. Mostrar reporte\n4. Depositar\n5. Retirar\n6. Salir\n";
+        out << "Seleccione una opcin: ";
+        optional<string> linea = co_await sesion.leerLinea();
+        if (!linea) co_return; // Fin de la entrada
+
+        int opcion;
+        if (!Sesion::convertir(*linea, opcion)) {
+            out << "Entrada invlida. Intente nuevamente.\n";
             continue;
         }
 
         switch (opcion) {
-        case 1: _showDatos(); break;
-        case 2: _showHistorial(); break;
-        case 3: _showReporte(); break;
-        case 4: _interactDepositar(); break;
-        case 5: _interactRetirar(); break;
-        case 6: cout << "Saliendo del men.\n"; break;
-        default: cout << "Opcin invlida. Intente nuevamente.\n";
+        case 1: _showDatos(out); break;
+        case 2: _showHistorial(out); break;
+        case 3: _showReporte(out); break;
+        case 4: co_await _interactDepositar(sesion); break;
+        case 5: co_await _interactRetirar(sesion); break;
+        case 6: out << "Saliendo del men.\n"; co_return;
+        default: out << "Opcin invlida. Intente nuevamente.\n";
         }
-    } while (opcion != 6);
+    }
 }
 
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// Recuperacin de memoria por pocas para estructuras sin bloqueos.
+//
+// Un hilo que va a leer nodos compartidos abre una EpochManager::Guard, que publica la poca
+// global que observ. Los nodos quitados de la estructura no se liberan de inmediato: se
+// retiran junto con la poca actual y se liberan cuando la poca global avanz dos veces,
+// porque para entonces ningn hilo puede seguir dentro de una seccin que los haya visto.
+// La poca solo avanza cuando todos los hilos dentro de una seccin ya observaron la actual.
+class EpochManager
+{
+private:
+	struct Retirado
+	{
+		void* puntero;
+		void (*borrar)(void*);   // Tambin identifica el tipo del nodo (ver _borrar)
+		uint64_t epoca;
+		bool reciclable;
+	};
+
+	// Nodo liberado que se guarda para reutilizarlo en lugar de borrarlo
+	struct Reciclado
+	{
+		void* puntero;
+		void (*borrar)(void*);
+	};
+
+	// Un registro por hilo; los registros nunca se liberan mientras exista el administrador,
+	// se reutilizan cuando su hilo termina (con los nodos retirados que quedaron pendientes)
+	struct Registro
+	{
+		std::atomic<uint64_t> epoca{ 0 };     // 0 si el hilo no est dentro de una seccin
+		std::atomic<bool> enUso{ false };
+		size_t profundidad = 0;               // Secciones anidadas del hilo dueo
+		std::vector<Retirado> retirados;      // Solo los toca el hilo dueo
+		std::vector<Reciclado> reciclados;    // Solo los toca el hilo dueo
+		Registro* siguiente = nullptr;
+	};
+
+	// Libera el registro del hilo cuando este termina
+	struct Liberador
+	{
+		Registro* registro = nullptr;
+		~Liberador();
+	};
+
+	static constexpr size_t UMBRAL_RECOLECCION = 64; // Retiros entre intentos de liberar
+	static constexpr size_t MAX_RECICLADOS = 256;    // Nodos reciclables guardados por registro
+
+	std::atomic<uint64_t> epocaGlobal;
+	std::atomic<Registro*> registros;
+
+	static thread_local Liberador liberador;
+
+	EpochManager();
+	Registro& _registro();
+	bool _intentarAvanzar();
+	void _recolectar(Registro& registro);
+	void _retirar(void* puntero, void (*borrar)(void*), bool reciclable);
+	template<class T>
+	static void _borrar(void* puntero);
+
+public:
+	~EpochManager();
+
+	EpochManager(const EpochManager&) = delete;
+	EpochManager& operator=(const EpochManager&) = delete;
+
+	// Administrador compartido por todas las estructuras del programa
+	static EpochManager& instancia();
+
+	// Seccin en la que es seguro leer nodos compartidos; se puede anidar
+	class Guard
+	{
+	private:
+		Registro& registro;
+
+	public:
+		Guard();
+		~Guard();
+
+		Guard(const Guard&) = delete;
+		Guard& operator=(const Guard&) = delete;
+	};
+
+	// Libera 'puntero' cuando ningn hilo pueda seguir leyndolo
+	template<class T>
+	void retirar(T* puntero);
+	// Como retirar, pero cuando ningn hilo pueda leerlo el nodo se guarda en el registro del
+	// hilo para que reutilizar<T> lo entregue en lugar de reservar memoria nueva
+	template<class T>
+	void reciclar(T* puntero);
+	// Un nodo de tipo T reciclado por este hilo (con su ltimo valor), o nullptr si no hay
+	template<class T>
+	T* reutilizar();
+
+	uint64_t getEpoca() const;
+};
+
+thread_local EpochManager::Liberador EpochManager::liberador;
+
+EpochManager::EpochManager() : epocaGlobal(1), registros(nullptr)
+{}
+
+EpochManager::~EpochManager()
+{
+	// Al destruirse ya no hay hilos usando estructuras: se libera todo lo pendiente
+	Registro* registro = registros.load();
+	while (registro != nullptr)
+	{
+		for (const Retirado& retirado : registro->retirados)
+		{
+			retirado.borrar(retirado.puntero);
+		}
+		for (const Reciclado& reciclado : registro->reciclados)
+		{
+			reciclado.borrar(reciclado.puntero);
+		}
+		Registro* siguiente = registro->siguiente;
+		delete registro;
+		registro = siguiente;
+	}
+}
+
+EpochManager::Liberador::~Liberador()
+{
+	if (registro != nullptr)
+	{
+		// Los retirados pendientes quedan en el registro para quien lo reutilice
+		EpochManager::instancia()._recolectar(*registro);
+		registro->enUso.store(false, std::memory_order_release);
+	}
+}
+
+EpochManager& EpochManager::instancia()
+{
+	static EpochManager manager;
+	return manager;
+}
+
+EpochManager::Registro& EpochManager::_registro()
+{
+	if (liberador.registro != nullptr)
+	{
+		return *liberador.registro;
+	}
+
+	// Reutilizar el registro de un hilo que ya termin
+	for (Registro* registro = registros.load(std::memory_order_acquire); registro != nullptr; registro = registro->siguiente)
+	{
+		bool libre = false;
+		if (registro->enUso.compare_exchange_strong(libre, true, std::memory_order_acquire))
+		{
+			liberador.registro = registro;
+			return *registro;
+		}
+	}
+
+	// Agregar uno nuevo al inicio de la lista
+	Registro* nuevo = new Registro();
+	nuevo->enUso.store(true, std::memory_order_relaxed);
+	nuevo->siguiente = registros.load(std::memory_order_relaxed);
+	while (!registros.compare_exchange_weak(nuevo->siguiente, nuevo, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+	liberador.registro = nuevo;
+	return *nuevo;
+}
+
+bool EpochManager::_intentarAvanzar()
+{
+	uint64_t actual = epocaGlobal.load();
+	for (Registro* registro = registros.load(std::memory_order_acquire); registro != nullptr; registro = registro->siguiente)
+	{
+		uint64_t epoca = registro->epoca.load();
+		if (epoca != 0 && epoca != actual)
+		{
+			return false; // Un hilo sigue dentro de una seccin de la poca anterior
+		}
+	}
+	return epocaGlobal.compare_exchange_strong(actual, actual + 1);
+}
+
+void EpochManager::_recolectar(Registro& registro)
+{
+	_intentarAvanzar();
+	uint64_t actual = epocaGlobal.load();
+
+	size_t conservados = 0;
+	for (size_t i = 0; i < registro.retirados.size(); ++i)
+	{
+		const Retirado& retirado = registro.retirados[i];
+		if (retirado.epoca + 2 <= actual)
+		{
+			if (retirado.reciclable && registro.reciclados.size() < MAX_RECICLADOS)
+			{
+				registro.reciclados.push_back({ retirado.puntero, retirado.borrar });
+			}
+			else
+			{
+				retirado.borrar(retirado.puntero);
+			}
+		}
+		else
+		{
+			registro.retirados[conservados++] = retirado;
+		}
+	}
+	registro.retirados.resize(conservados);
+}
+
+EpochManager::Guard::Guard() : registro(EpochManager::instancia()._registro())
+{
+	if (registro.profundidad++ == 0)
+	{
+		// Publicar la poca observada antes de leer cualquier nodo (seq_cst con la lectura
+		// de _intentarAvanzar: o el hilo que avanza ve esta poca, o este hilo ve la nueva)
+		EpochManager& manager = EpochManager::instancia();
+		uint64_t epoca = manager.epocaGlobal.load();
+		registro.epoca.store(epoca);
+		while (epoca != manager.epocaGlobal.load())
+		{
+			epoca = manager.epocaGlobal.load();
+			registro.epoca.store(epoca);
+		}
+	}
+}
+
+EpochManager::Guard::~Guard()
+{
+	if (--registro.profundidad == 0)
+	{
+		registro.epoca.store(0, std::memory_order_release);
+	}
+}
+
+void EpochManager::_retirar(void* puntero, void (*borrar)(void*), bool reciclable)
+{
+	Registro& registro = _registro();
+	registro.retirados.push_back({ puntero, borrar, epocaGlobal.load(), reciclable });
+	if (registro.retirados.size() % UMBRAL_RECOLECCION == 0)
+	{
+		_recolectar(registro);
+	}
+}
+
+template<class T>
+void EpochManager::_borrar(void* puntero)
+{
+	delete static_cast<T*>(puntero);
+}
+
+template<class T>
+void EpochManager::retirar(T* puntero)
+{
+	_retirar(puntero, &_borrar<T>, false);
+}
+
+template<class T>
+void EpochManager::reciclar(T* puntero)
+{
+	_retirar(puntero, &_borrar<T>, true);
+}
+
+template<class T>
+T* EpochManager::reutilizar()
+{
+	// El borrador de cada tipo es una funcin distinta: sirve para reconocer los nodos de T
+	std::vector<Reciclado>& reciclados = _registro().reciclados;
+	for (size_t i = reciclados.size(); i-- > 0;)
+	{
+		if (reciclados[i].borrar == &_borrar<T>)
+		{
+			T* nodo = static_cast<T*>(reciclados[i].puntero);
+			reciclados[i] = reciclados.back();
+			reciclados.pop_back();
+			return nodo;
+		}
+	}
+	return nullptr;
+}
+
+uint64_t EpochManager::getEpoca() const
+{
+	return epocaGlobal.load();
+}
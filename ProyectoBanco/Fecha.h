@@ -3,7 +3,6 @@
 #include "ISavable.h"
 #include "IDebugable.h"
 #include "IRandomizable.h"
-#include <functional>
 
 // Componente Fecha
 class Fecha : public ISavable, IDebugable, IRandomizable {
@@ -16,9 +15,7 @@ private:
     int diasDelMes(const int& mes, const int& anio) const;
 
     // Formatea un nmero a dos dgitos
-    function<string(int)> formatearDosDigitos = [](int numero) -> string {
-        return (numero < 10 ? "0" : "") + to_string(numero);
-        };
+    static string formatearDosDigitos(int numero);
 
 public:
     Fecha(const int& dia, const int& mes, const int& anio);
@@ -44,10 +41,15 @@ public:
     bool sumarMeses(const int& meses);
     bool sumarAnios(const int& anios);
 
+    // Nmero de das desde el 01/01/1970 (negativo para fechas anteriores)
+    int toNumeroDia() const;
+    bool setNumeroDia(const int& numeroDia);
+
     string toDebug() const override;
     string toSave() const override;
     void load(const string& data) override;
-    void generateRandom() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
 };
 
 // Constructor que establece la fecha con da, mes y ao
@@ -65,6 +67,10 @@ Fecha::Fecha(const string& datos) {
 // Constructor por defecto, establece la fecha a 01/01/2024
 Fecha::Fecha() : dia(1), mes(1), anio(2024) {}
 
+string Fecha::formatearDosDigitos(int numero) {
+    return (numero < 10 ? "0" : "") + to_string(numero);
+}
+
 int Fecha::getDia() const {
     return dia;
 }
@@ -186,6 +192,37 @@ bool Fecha::sumarAnios(const int& anios) {
     return true;
 }
 
+int Fecha::toNumeroDia() const {
+    // Conversin de calendario civil a das (aos que empiezan en marzo)
+    int y = anio - (mes <= 2 ? 1 : 0);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int anioDeEra = y - era * 400;
+    int diaDelAnio = (153 * (mes > 2 ? mes - 3 : mes + 9) + 2) / 5 + dia - 1;
+    int diaDeEra = anioDeEra * 365 + anioDeEra / 4 - anioDeEra / 100 + diaDelAnio;
+    return era * 146097 + diaDeEra - 719468;
+}
+
+bool Fecha::setNumeroDia(const int& numeroDia) {
+    int z = numeroDia + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int diaDeEra = z - era * 146097;
+    int anioDeEra = (diaDeEra - diaDeEra / 1460 + diaDeEra / 36524 - diaDeEra / 146096) / 365;
+    int diaDelAnio = diaDeEra - (365 * anioDeEra + anioDeEra / 4 - anioDeEra / 100);
+    int mesDesdeMarzo = (5 * diaDelAnio + 2) / 153;
+
+    int nuevoDia = diaDelAnio - (153 * mesDesdeMarzo + 2) / 5 + 1;
+    int nuevoMes = mesDesdeMarzo < 10 ? mesDesdeMarzo + 3 : mesDesdeMarzo - 9;
+    int nuevoAnio = anioDeEra + era * 400 + (nuevoMes <= 2 ? 1 : 0);
+
+    if (nuevoAnio < 0) {
+        return false;
+    }
+    anio = nuevoAnio;
+    mes = nuevoMes;
+    dia = nuevoDia;
+    return true;
+}
+
 string Fecha::toDebug() const {
     ostringstream debug;
     debug << "Fecha(dia='" << dia << "', mes='" << mes << "', anio='" << anio << "')";
@@ -213,8 +250,8 @@ void Fecha::load(const string& data) {
     }
 }
 
-void Fecha::generateRandom() {
+void Fecha::generateRandom(Aleatorio& aleatorio) {
     anio = 2024;
-    mes = 1 + (rand() % 12);
-    dia = 1 + (rand() % diasDelMes(mes, anio));
+    mes = 1 + aleatorio.entero(12);
+    dia = 1 + aleatorio.entero(diasDelMes(mes, anio));
 }
\ No newline at end of file
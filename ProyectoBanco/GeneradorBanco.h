@@ -0,0 +1,532 @@
+#pragma once
+
+#include "MGeneral.h"
+#include "Aleatorio.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Parmetros de las distribuciones de un banco sinttico
+struct PerfilBanco : public IDebugable
+{
+	size_t minCuentas = 1;              // Cuentas por cliente, uniforme en [minCuentas, maxCuentas]
+	size_t maxCuentas = 3;
+	double exponenteActividad = 2.0;    // Transacciones por cuenta con distribucin de Zipf en
+	uint32_t maxTransacciones = 1000;   // [1, maxTransacciones]: pocas cuentas muy activas
+	double medianaMonto = 50.0;         // Montos log-normales (cola pesada), en soles
+	double dispersionMonto = 1.2;       // Desviacin del logaritmo del monto
+	double montoMaximo = 50000.0;       // Tope de cada monto, en soles
+	double proporcionDepositos = 0.6;   // Probabilidad de que una transaccin sea depsito
+	Fecha fechaInicio = Fecha(1, 1, 2020);  // Rango de fechas de las transacciones y quejas
+	Fecha fechaFin = Fecha(31, 12, 2024);
+	double tasaQuejas = 0.02;           // Probabilidad de que un cliente tenga quejas
+	size_t maxQuejas = 3;               // Quejas de un cliente que se queja, uniforme en [1, maxQuejas]
+
+	// Verifica que los rangos sean coherentes y que el saldo de una cuenta quepa en un Monto
+	bool valido() const;
+
+	string toDebug() const override;
+};
+
+bool PerfilBanco::valido() const
+{
+	return minCuentas <= maxCuentas && maxTransacciones > 0 && exponenteActividad > 0 &&
+		medianaMonto >= 0.01 && dispersionMonto >= 0 && montoMaximo >= medianaMonto &&
+		montoMaximo * maxTransacciones <= INT_MAX &&
+		proporcionDepositos >= 0 && proporcionDepositos <= 1 &&
+		fechaInicio.toNumeroDia() <= fechaFin.toNumeroDia() &&
+		tasaQuejas >= 0 && tasaQuejas <= 1 && maxQuejas > 0;
+}
+
+string PerfilBanco::toDebug() const
+{
+	ostringstream debug;
+	debug << "PerfilBanco(cuentas=" << minCuentas << ".." << maxCuentas
+		<< ", exponenteActividad=" << exponenteActividad
+		<< ", maxTransacciones=" << maxTransacciones
+		<< ", medianaMonto=" << medianaMonto
+		<< ", dispersionMonto=" << dispersionMonto
+		<< ", montoMaximo=" << montoMaximo
+		<< ", proporcionDepositos=" << proporcionDepositos
+		<< ", fechas=" << fechaInicio.toStringDDMMAAAA() << ".." << fechaFin.toStringDDMMAAAA()
+		<< ", tasaQuejas=" << tasaQuejas
+		<< ", maxQuejas=" << maxQuejas << ")";
+	return debug.str();
+}
+
+// Resultado de generar un banco sinttico
+struct ResultadoGeneracion : public IDebugable
+{
+	size_t registrados = 0;    // Clientes generados y registrados (o escritos)
+	size_t duplicados = 0;     // Clientes descartados porque su DNI ya estaba registrado
+	size_t cuentas = 0;        // Cuentas de los clientes registrados
+	size_t transacciones = 0;  // Transacciones en los historiales de esas cuentas
+	size_t quejas = 0;         // Quejas de los clientes registrados
+	size_t bytes = 0;          // Bytes escritos (solo al escribir un volcado)
+	double segundos = 0;
+
+	double clientesPorSegundo() const;
+	double transaccionesPorSegundo() const;
+
+	string toDebug() const override;
+};
+
+double ResultadoGeneracion::clientesPorSegundo() const
+{
+	return segundos > 0 ? (registrados + duplicados) / segundos : 0;
+}
+
+double ResultadoGeneracion::transaccionesPorSegundo() const
+{
+	return segundos > 0 ? transacciones / segundos : 0;
+}
+
+string ResultadoGeneracion::toDebug() const
+{
+	ostringstream debug;
+	debug << "ResultadoGeneracion(registrados=" << registrados
+		<< ", duplicados=" << duplicados
+		<< ", cuentas=" << cuentas
+		<< ", transacciones=" << transacciones
+		<< ", quejas=" << quejas
+		<< ", bytes=" << bytes
+		<< ", segundos=" << segundos
+		<< ", clientesPorSegundo=" << clientesPorSegundo() << ")";
+	return debug.str();
+}
+
+// Formato en el que GeneradorBanco::escribir vuelca los clientes
+enum class FormatoVolcado
+{
+	Texto,   // Un Cliente::toSave por lnea (el formato que lee ImportadorClientes)
+	Binario  // Solo las cuentas: nmero, saldo e historial comprimido (ver leerBinario)
+};
+
+// Generador de bancos sintticos (clientes con sus cuentas, tarjetas, historiales y quejas)
+// repetible y con distribuciones configurables (ver PerfilBanco).
+//
+// El cliente de ndice i se genera siempre con Aleatorio::derivar(semilla, i), as que cada
+// cliente depende solo de la semilla, del perfil y de su ndice: los clientes se generan en
+// paralelo por lotes y se registran (o escriben) en orden de ndice, y el banco resultante es
+// el mismo con cualquier cantidad de hilos. Escribir un volcado de texto e importarlo da los
+// mismos clientes y cuentas que generarlo en memoria.
+//
+// Formato binario (enteros en el orden de bytes de la mquina):
+//   cabecera:   "PBVOLCAD" | version u32
+//   por cuenta: numeroCuenta char[12] | saldo i64 (cntimos) | BloqueHistorial::guardar
+class GeneradorBanco
+{
+private:
+	// Cliente generado en paralelo, antes de registrarlo o escribirlo
+	struct ClienteGenerado
+	{
+		Cliente* cliente = nullptr;  // Nulo si ya se serializ en 'datos'
+		DNI dni;
+		SStack<Queja> quejas;
+		size_t cuentas = 0;
+		size_t transacciones = 0;
+		string datos;                // Cliente serializado (solo al escribir)
+		string datosQuejas;          // Quejas serializadas, una por lnea (solo al escribir)
+	};
+
+	uint64_t semilla;
+	size_t hilos;        // Hilos de generacin (0 = todos los ncleos)
+	size_t tamanioLote;  // Clientes que se generan antes de registrarlos
+	PerfilBanco perfil;
+	DistribucionZipf actividad;  // Transacciones por cuenta segn el perfil
+
+	static constexpr char MAGIA[9] = "PBVOLCAD";
+	static constexpr uint32_t VERSION = 1;
+	static constexpr size_t LONGITUD_CUENTA = 12;
+	static constexpr size_t DNIS_POSIBLES = 100000000;  // DNI de 8 dgitos
+
+	Fecha _generarFecha(Aleatorio& aleatorio) const;
+	long long _generarMonto(Aleatorio& aleatorio) const;
+	Cuenta _generarCuenta(const Fecha& fechaActual, Aleatorio& aleatorio, size_t& transacciones) const;
+	void _generar(const Fecha& fechaActual, uint64_t indice, ClienteGenerado& generado) const;
+	static void _serializar(ClienteGenerado& generado, FormatoVolcado formato);
+	// Genera los clientes de ndices [desde, desde + lote.size()); si 'formato' no es nulo
+	// tambin los serializa (y libera) en paralelo
+	void _generarLote(const Fecha& fechaActual, uint64_t desde, vector<ClienteGenerado>& lote,
+		ThreadPool* pool, const FormatoVolcado* formato) const;
+	unique_ptr<ThreadPool> _crearPool() const;
+
+public:
+	GeneradorBanco(uint64_t semilla, size_t hilos = 0, size_t tamanioLote = 1 << 14);
+
+	uint64_t getSemilla() const;
+	size_t getHilos() const;
+	size_t getTamanioLote() const;
+	PerfilBanco getPerfil() const;
+
+	bool setSemilla(uint64_t semilla);
+	bool setHilos(size_t hilos);
+	bool setTamanioLote(size_t tamanioLote);
+	// Retorna false (y conserva el perfil anterior) si el perfil no es vlido
+	bool setPerfil(const PerfilBanco& perfil);
+
+	// Cliente de ndice 'indice' con sus quejas (el llamador toma posesin del puntero)
+	Cliente* generarCliente(const Fecha& fechaActual, uint64_t indice) const;
+
+	// Genera clientes con los ndices 0, 1, 2... y los registra hasta que 'registro' tenga
+	// 'clientes' clientes; los de DNI repetido se descartan y se sigue con el ndice siguiente
+	ResultadoGeneracion generar(MGeneral& registro, size_t clientes) const;
+
+	// Genera 'clientes' clientes de DNI distinto y los escribe en 'out' lote por lote, sin
+	// registrarlos: la memoria usada depende de 'tamanioLote' y no de la cantidad de clientes.
+	// Si 'quejas' no es nulo, las quejas se escriben ah con el formato de Quejas.txt.
+	ResultadoGeneracion escribir(ostream& out, size_t clientes, FormatoVolcado formato, ostream* quejas = nullptr) const;
+
+	// Lee un volcado binario y llama a 'operacion' con cada cuenta; retorna false si el
+	// volcado est mal formado
+	static bool leerBinario(istream& in, const function<void(const string&, long long, const BloqueHistorial&)>& operacion);
+};
+
+constexpr char GeneradorBanco::MAGIA[9];
+constexpr uint32_t GeneradorBanco::VERSION;
+
+GeneradorBanco::GeneradorBanco(uint64_t semilla, size_t hilos, size_t tamanioLote)
+	: semilla(semilla), hilos(hilos), tamanioLote(1 << 14)
+{
+	setTamanioLote(tamanioLote);
+	setPerfil(PerfilBanco());
+}
+
+uint64_t GeneradorBanco::getSemilla() const
+{
+	return semilla;
+}
+
+size_t GeneradorBanco::getHilos() const
+{
+	return hilos;
+}
+
+size_t GeneradorBanco::getTamanioLote() const
+{
+	return tamanioLote;
+}
+
+PerfilBanco GeneradorBanco::getPerfil() const
+{
+	return perfil;
+}
+
+bool GeneradorBanco::setSemilla(uint64_t semilla)
+{
+	this->semilla = semilla;
+	return true;
+}
+
+bool GeneradorBanco::setHilos(size_t hilos)
+{
+	this->hilos = hilos;
+	return true;
+}
+
+bool GeneradorBanco::setTamanioLote(size_t tamanioLote)
+{
+	if (tamanioLote == 0)
+	{
+		return false;
+	}
+	this->tamanioLote = tamanioLote;
+	return true;
+}
+
+bool GeneradorBanco::setPerfil(const PerfilBanco& perfil)
+{
+	if (!perfil.valido())
+	{
+		return false;
+	}
+	this->perfil = perfil;
+	actividad = DistribucionZipf(perfil.maxTransacciones, perfil.exponenteActividad);
+	return true;
+}
+
+Fecha GeneradorBanco::_generarFecha(Aleatorio& aleatorio) const
+{
+	int primero = perfil.fechaInicio.toNumeroDia();
+	uint32_t dias = static_cast<uint32_t>(perfil.fechaFin.toNumeroDia() - primero + 1);
+	Fecha fecha;
+	fecha.setNumeroDia(primero + static_cast<int>(aleatorio.entero(dias)));
+	return fecha;
+}
+
+long long GeneradorBanco::_generarMonto(Aleatorio& aleatorio) const
+{
+	double soles = exp(log(perfil.medianaMonto) + perfil.dispersionMonto * aleatorio.normal());
+	long long centimos = llround(min(soles, perfil.montoMaximo) * 100);
+	return max<long long>(1, centimos);
+}
+
+Cuenta GeneradorBanco::_generarCuenta(const Fecha& fechaActual, Aleatorio& aleatorio, size_t& transacciones) const
+{
+	string numero;
+	for (size_t i = 0; i < LONGITUD_CUENTA; ++i)
+	{
+		numero += static_cast<char>('0' + aleatorio.entero(10));
+	}
+
+	Tarjeta tarjeta;
+	tarjeta.generateRandom(aleatorio);
+	tarjeta.setSaldo(0);
+
+	// Das de las transacciones en orden cronolgico
+	vector<int> dias(actividad(aleatorio));
+	int primero = perfil.fechaInicio.toNumeroDia();
+	uint32_t rango = static_cast<uint32_t>(perfil.fechaFin.toNumeroDia() - primero + 1);
+	for (int& dia : dias)
+	{
+		dia = primero + static_cast<int>(aleatorio.entero(rango));
+	}
+	sort(dias.begin(), dias.end());
+
+	// El saldo final es el resultado del historial; un retiro que el saldo no cubre se
+	// registra como depsito para que el saldo nunca sea negativo
+	vector<RegistroTransaccion> historial;
+	historial.reserve(dias.size());
+	long long saldo = 0;
+	for (int dia : dias)
+	{
+		long long centimos = _generarMonto(aleatorio);
+		bool deposito = aleatorio.real() < perfil.proporcionDepositos || centimos > saldo;
+		saldo += deposito ? centimos : -centimos;
+
+		TipoTransaccion tipo = deposito ? TipoTransaccion::Deposito : TipoTransaccion::Retiro;
+		historial.push_back({ centimos, dia, static_cast<uint8_t>(tipo), 0, 0 });
+	}
+	if (saldo > 0)
+	{
+		Monto total;
+		total.setTotalCentimos(saldo);
+		tarjeta.depositar(total);
+	}
+
+	Cuenta cuenta(fechaActual, numero, tarjeta);
+	cuenta.setHistorial(historial);
+	transacciones += dias.size();
+	return cuenta;
+}
+
+void GeneradorBanco::_generar(const Fecha& fechaActual, uint64_t indice, ClienteGenerado& generado) const
+{
+	Aleatorio aleatorio = Aleatorio::derivar(semilla, indice);
+
+	Identidad identidad;
+	identidad.generateRandom(aleatorio);
+	Contacto contacto;
+	contacto.generateRandom(aleatorio);
+	generado.cliente = new Cliente(fechaActual, identidad, contacto);
+	generado.dni = identidad.getDNINumerico();
+
+	generado.cuentas = perfil.minCuentas + aleatorio.entero(static_cast<uint32_t>(perfil.maxCuentas - perfil.minCuentas + 1));
+	for (size_t i = 0; i < generado.cuentas; ++i)
+	{
+		generado.cliente->addCuenta(_generarCuenta(fechaActual, aleatorio, generado.transacciones));
+	}
+
+	if (aleatorio.real() < perfil.tasaQuejas)
+	{
+		size_t cantidad = 1 + aleatorio.entero(static_cast<uint32_t>(perfil.maxQuejas));
+		for (size_t i = 0; i < cantidad; ++i)
+		{
+			Queja queja;
+			queja.generateRandom(aleatorio);
+			queja.setCliente(identidad.getPrimerApellido() + ", " + identidad.getNombres());
+			queja.setFechaEmision(_generarFecha(aleatorio));
+			generado.quejas.push(queja);
+		}
+	}
+}
+
+void GeneradorBanco::_serializar(ClienteGenerado& generado, FormatoVolcado formato)
+{
+	if (formato == FormatoVolcado::Texto)
+	{
+		generado.datos = generado.cliente->toSave();
+		generado.datos += '\n';
+	}
+	else
+	{
+		ostringstream out(ios::binary);
+		generado.cliente->aplicarCuentas([&out](Cuenta& cuenta) {
+			string numero = cuenta.getNumeroCuenta();
+			long long saldo = cuenta.getSaldoCentimos();
+			numero.resize(LONGITUD_CUENTA, '0');
+			out.write(numero.data(), LONGITUD_CUENTA);
+			out.write(reinterpret_cast<const char*>(&saldo), sizeof(saldo));
+			cuenta.comprimirHistorial().guardar(out);
+			});
+		generado.datos = out.str();
+	}
+
+	for (const Queja& queja : generado.quejas)
+	{
+		generado.datosQuejas += queja.toSave();
+		generado.datosQuejas += '\n';
+	}
+
+	delete generado.cliente;
+	generado.cliente = nullptr;
+}
+
+void GeneradorBanco::_generarLote(const Fecha& fechaActual, uint64_t desde, vector<ClienteGenerado>& lote,
+	ThreadPool* pool, const FormatoVolcado* formato) const
+{
+	auto generarTramo = [&](size_t inicio, size_t fin) {
+		for (size_t i = inicio; i < fin; ++i)
+		{
+			_generar(fechaActual, desde + i, lote[i]);
+			if (formato != nullptr)
+			{
+				_serializar(lote[i], *formato);
+			}
+		}
+		};
+
+	if (pool == nullptr)
+	{
+		generarTramo(0, lote.size());
+	}
+	else
+	{
+		pool->parallelFor(0, lote.size(), 64, generarTramo);
+	}
+}
+
+unique_ptr<ThreadPool> GeneradorBanco::_crearPool() const
+{
+	// Con un solo hilo no vale la pena levantar un ThreadPool
+	return unique_ptr<ThreadPool>(hilos == 1 ? nullptr : new ThreadPool(hilos));
+}
+
+Cliente* GeneradorBanco::generarCliente(const Fecha& fechaActual, uint64_t indice) const
+{
+	ClienteGenerado generado;
+	_generar(fechaActual, indice, generado);
+	generado.cliente->setQuejas(generado.quejas);
+	return generado.cliente;
+}
+
+ResultadoGeneracion GeneradorBanco::generar(MGeneral& registro, size_t clientes) const
+{
+	ResultadoGeneracion resultado;
+	auto inicio = chrono::steady_clock::now();
+	unique_ptr<ThreadPool> pool = _crearPool();
+
+	Fecha fechaActual = registro.getFechaActual();
+	uint64_t siguiente = 0;
+	vector<ClienteGenerado> lote;
+	while (registro.getNumeroClientes() < clientes)
+	{
+		// Nunca se generan ms clientes de los que faltan, as que ninguno se desperdicia
+		// salvo los duplicados
+		lote.assign(min(clientes - registro.getNumeroClientes(), tamanioLote), ClienteGenerado());
+		_generarLote(fechaActual, siguiente, lote, pool.get(), nullptr);
+		siguiente += lote.size();
+
+		for (ClienteGenerado& generado : lote)
+		{
+			generado.cliente->setQuejas(generado.quejas);
+			if (registro.addCliente(generado.cliente))
+			{
+				++resultado.registrados;
+				resultado.cuentas += generado.cuentas;
+				resultado.transacciones += generado.transacciones;
+				resultado.quejas += generado.quejas.size();
+			}
+			else
+			{
+				delete generado.cliente;
+				++resultado.duplicados;
+			}
+		}
+	}
+
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+	return resultado;
+}
+
+ResultadoGeneracion GeneradorBanco::escribir(ostream& out, size_t clientes, FormatoVolcado formato, ostream* quejas) const
+{
+	ResultadoGeneracion resultado;
+	auto inicio = chrono::steady_clock::now();
+	unique_ptr<ThreadPool> pool = _crearPool();
+
+	if (formato == FormatoVolcado::Binario)
+	{
+		out.write(MAGIA, 8);
+		out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+		resultado.bytes += 8 + sizeof(VERSION);
+	}
+
+	// Sin registro, los DNI ya escritos se marcan en un mapa de bits (12.5 MB para los 10^8 posibles)
+	vector<bool> escritos(DNIS_POSIBLES, false);
+	Fecha fechaActual;
+	uint64_t siguiente = 0;
+	vector<ClienteGenerado> lote;
+	while (resultado.registrados < clientes && out)
+	{
+		lote.assign(min(clientes - resultado.registrados, tamanioLote), ClienteGenerado());
+		_generarLote(fechaActual, siguiente, lote, pool.get(), &formato);
+		siguiente += lote.size();
+
+		for (const ClienteGenerado& generado : lote)
+		{
+			size_t dni = static_cast<size_t>(generado.dni.getValor());
+			if (escritos[dni])
+			{
+				++resultado.duplicados;
+				continue;
+			}
+			escritos[dni] = true;
+
+			out.write(generado.datos.data(), generado.datos.size());
+			if (quejas != nullptr)
+			{
+				quejas->write(generado.datosQuejas.data(), generado.datosQuejas.size());
+			}
+			++resultado.registrados;
+			resultado.cuentas += generado.cuentas;
+			resultado.transacciones += generado.transacciones;
+			resultado.quejas += generado.quejas.size();
+			resultado.bytes += generado.datos.size();
+		}
+	}
+	out.flush();
+
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+	return resultado;
+}
+
+bool GeneradorBanco::leerBinario(istream& in, const function<void(const string&, long long, const BloqueHistorial&)>& operacion)
+{
+	char magia[8];
+	uint32_t version = 0;
+	if (!in.read(magia, sizeof(magia)) || memcmp(magia, MAGIA, sizeof(magia)) != 0 ||
+		!in.read(reinterpret_cast<char*>(&version), sizeof(version)) || version != VERSION)
+	{
+		return false;
+	}
+
+	string numero(LONGITUD_CUENTA, '\0');
+	long long saldo;
+	BloqueHistorial historial;
+	while (in.peek() != char_traits<char>::eof())
+	{
+		if (!in.read(&numero[0], LONGITUD_CUENTA) ||
+			!in.read(reinterpret_cast<char*>(&saldo), sizeof(saldo)) ||
+			!historial.cargar(in))
+		{
+			return false;
+		}
+		operacion(numero, saldo, historial);
+	}
+	return true;
+}
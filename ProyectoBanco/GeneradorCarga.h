@@ -0,0 +1,275 @@
+#pragma once
+
+#include "ServidorBanco.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#endif
+
+using namespace std;
+
+// Resultado de una prueba de carga contra ServidorBanco; latencias en microsegundos
+struct ResultadoCarga
+{
+	size_t peticiones = 0;
+	size_t rechazadas = 0;  // Respuestas "ER" (por ejemplo retiros sin saldo)
+	double segundos = 0;
+	double p50 = 0;
+	double p99 = 0;
+	double maxima = 0;
+	bool completo = false;  // false si se perdi la conexin antes de terminar
+};
+
+// Cliente de carga: abre 'conexiones' conexiones a un ServidorBanco y, desde un solo hilo con
+// epoll, mantiene una peticin en curso por conexin (saldos, depsitos, retiros y
+// transferencias al azar sobre las cuentas que lista el servidor) hasta enviar todas
+class GeneradorCarga
+{
+private:
+	string direccion;
+	size_t conexiones;
+
+#ifdef __linux__
+	// Enva una lnea y espera la respuesta completa; "" si falla
+	static string _consultar(int fd, const string& peticion);
+#endif
+
+public:
+	GeneradorCarga(const string& direccion, size_t conexiones);
+
+	ResultadoCarga ejecutar(size_t peticiones, unsigned semilla = 1);
+};
+
+GeneradorCarga::GeneradorCarga(const string& direccion, size_t conexiones)
+	: direccion(direccion), conexiones(max<size_t>(1, conexiones))
+{}
+
+#ifdef __linux__
+
+string GeneradorCarga::_consultar(int fd, const string& peticion)
+{
+	string pendiente = peticion + '\n';
+	string respuesta;
+	pollfd espera{ fd, 0, 0 };
+	while (true)
+	{
+		espera.events = pendiente.empty() ? POLLIN : POLLOUT;
+		if (poll(&espera, 1, 5000) <= 0)
+		{
+			return "";
+		}
+		if (!pendiente.empty())
+		{
+			ssize_t n = send(fd, pendiente.data(), pendiente.size(), MSG_NOSIGNAL);
+			if (n < 0 && errno != EAGAIN)
+			{
+				return "";
+			}
+			pendiente.erase(0, max<ssize_t>(0, n));
+			continue;
+		}
+		char buffer[65536];
+		ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+		if (n == 0 || (n < 0 && errno != EAGAIN))
+		{
+			return "";
+		}
+		respuesta.append(buffer, max<ssize_t>(0, n));
+		if (!respuesta.empty() && respuesta.back() == '\n')
+		{
+			respuesta.pop_back();
+			return respuesta;
+		}
+	}
+}
+
+ResultadoCarga GeneradorCarga::ejecutar(size_t peticiones, unsigned semilla)
+{
+	ResultadoCarga resultado;
+
+	// Cuentas sobre las que operar
+	int fd = ServidorBanco::abrirSocket(direccion, false);
+	if (fd < 0)
+	{
+		return resultado;
+	}
+	istringstream lista(_consultar(fd, "L 1000"));
+	close(fd);
+	string campo;
+	vector<string> cuentas;
+	lista >> campo;
+	while (lista >> campo)
+	{
+		cuentas.push_back(campo);
+	}
+	if (cuentas.size() < 2)
+	{
+		cerr << "El servidor no tiene suficientes cuentas para la carga\n";
+		return resultado;
+	}
+
+	mt19937 generador(semilla);
+	auto siguiente = [&]() {
+		const string& cuenta = cuentas[generador() % cuentas.size()];
+		string monto = to_string(1 + generador() % 10000);
+		unsigned tipo = generador() % 20;
+		if (tipo < 8) return "S " + cuenta + '\n';
+		if (tipo < 13) return "D " + cuenta + ' ' + monto + '\n';
+		if (tipo < 18) return "R " + cuenta + ' ' + monto + '\n';
+		return "T " + cuenta + ' ' + cuentas[generador() % cuentas.size()] + ' ' + monto + '\n';
+	};
+
+	struct Estado
+	{
+		int fd = -1;
+		string salida{};
+		size_t enviado = 0;
+		string entrada{};
+		chrono::steady_clock::time_point inicio{};
+	};
+	int ep = epoll_create1(0);
+	vector<Estado> estados;
+	for (size_t i = 0; i < conexiones; ++i)
+	{
+		int nuevo = ServidorBanco::abrirSocket(direccion, false);
+		if (nuevo < 0)
+		{
+			break;
+		}
+		estados.push_back(Estado{ nuevo });
+	}
+
+	vector<double> latencias;
+	latencias.reserve(peticiones);
+	size_t enviadas = 0;
+	auto enviar = [&](Estado& estado) {
+		while (estado.enviado < estado.salida.size())
+		{
+			ssize_t n = send(estado.fd, estado.salida.data() + estado.enviado, estado.salida.size() - estado.enviado, MSG_NOSIGNAL);
+			if (n < 0)
+			{
+				return errno == EAGAIN;
+			}
+			estado.enviado += n;
+		}
+		return true;
+	};
+	auto iniciar = [&](Estado& estado) {
+		estado.salida = siguiente();
+		estado.enviado = 0;
+		estado.inicio = chrono::steady_clock::now();
+		++enviadas;
+		return enviar(estado);
+	};
+
+	auto comienzo = chrono::steady_clock::now();
+	size_t activas = 0;
+	for (size_t i = 0; i < estados.size(); ++i)
+	{
+		// Por flanco: EPOLLOUT solo avisa cuando el socket vuelve a admitir datos
+		epoll_event evento{};
+		evento.events = EPOLLIN | EPOLLOUT | EPOLLET;
+		evento.data.u64 = i;
+		epoll_ctl(ep, EPOLL_CTL_ADD, estados[i].fd, &evento);
+		if (enviadas < peticiones && iniciar(estados[i]))
+		{
+			++activas;
+		}
+	}
+
+	vector<epoll_event> eventos(256);
+	char buffer[16384];
+	bool fallo = false;
+	while (activas > 0 && !fallo)
+	{
+		int listos = epoll_wait(ep, eventos.data(), static_cast<int>(eventos.size()), 5000);
+		if (listos <= 0)
+		{
+			fallo = true;
+			break;
+		}
+		for (int i = 0; i < listos; ++i)
+		{
+			Estado& estado = estados[eventos[i].data.u64];
+			if ((eventos[i].events & EPOLLOUT) && !enviar(estado))
+			{
+				fallo = true;
+				break;
+			}
+			if (!(eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)))
+			{
+				continue;
+			}
+			ssize_t n;
+			while ((n = recv(estado.fd, buffer, sizeof(buffer), 0)) > 0)
+			{
+				estado.entrada.append(buffer, n);
+			}
+			if (n == 0 || (n < 0 && errno != EAGAIN))
+			{
+				fallo = true;
+				break;
+			}
+
+			size_t fin = estado.entrada.find('\n');
+			if (fin == string::npos)
+			{
+				continue;
+			}
+			// Una sola peticin en curso por conexin: la lnea es su respuesta
+			latencias.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - estado.inicio).count());
+			resultado.rechazadas += estado.entrada.compare(0, 2, "ER") == 0 ? 1 : 0;
+			estado.entrada.erase(0, fin + 1);
+
+			if (enviadas < peticiones)
+			{
+				if (!iniciar(estado))
+				{
+					fallo = true;
+					break;
+				}
+			}
+			else
+			{
+				--activas;
+			}
+		}
+	}
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - comienzo).count();
+
+	for (Estado& estado : estados)
+	{
+		close(estado.fd);
+	}
+	close(ep);
+
+	resultado.peticiones = latencias.size();
+	resultado.completo = !fallo && latencias.size() == peticiones;
+	if (!latencias.empty())
+	{
+		auto percentil = [&latencias](double p) {
+			size_t k = min(latencias.size() - 1, static_cast<size_t>(p * latencias.size()));
+			nth_element(latencias.begin(), latencias.begin() + k, latencias.end());
+			return latencias[k];
+		};
+		resultado.p50 = percentil(0.50);
+		resultado.p99 = percentil(0.99);
+		resultado.maxima = *max_element(latencias.begin(), latencias.end());
+	}
+	return resultado;
+}
+
+#else
+
+ResultadoCarga GeneradorCarga::ejecutar(size_t peticiones, unsigned semilla)
+{
+	cerr << "El generador de carga solo esta disponible en Linux\n";
+	return ResultadoCarga();
+}
+
+#endif
@@ -5,12 +5,12 @@
 
 using namespace std;
 
-template <typename C>
+template <typename C, typename K = string>
 class HashEntity {
 public:
-    string key;
+    K key;
     C element;
 
     // Constructor
-    HashEntity(const string& k, const C& e) : key(k), element(e) {}
+    HashEntity(const K& k, const C& e) : key(k), element(e) {}
 };
\ No newline at end of file
@@ -1,26 +1,86 @@
 #pragma once
 
 #include "HashEntity.h"
+#include "Metricas.h"
+#include "Memoria.h"
+#include <cstdint>
+#include <functional>
 
-template <typename C>
+// Tabla hash con sondeo lineal. La clave es un string o un entero sin signo; las claves enteras
+// (DNI y nmeros de cuenta guardados como NumeroFijo) se mezclan y comparan sin recorrer texto.
+template <typename C, typename K = string>
 class HashTable {
 private:
     size_t capacity;               // capacidad
     size_t length;                 // cantidad de elementos dentro
-    HashEntity<C>** table;         // puntero a un arreglo de punteros a entidades hash
+    HashEntity<C, K>** table;      // puntero a un arreglo de punteros a entidades hash
 
-    size_t hash(const string& key) {
+    static size_t hashClave(const string& key) {
         size_t hashValue = 0;
         for (char ch : key) {
             hashValue = hashValue * 31 + ch; // simple hash usando la suma ponderada de caracteres
         }
-        return hashValue % capacity;
+        return hashValue;
+    }
+
+    static size_t hashClave(uint64_t key) {
+        // Mezcla final de MurmurHash3: nmeros consecutivos quedan repartidos en toda la tabla
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<size_t>(key);
+    }
+
+    size_t hash(const K& key) {
+        return hashClave(key) % capacity;
+    }
+
+    // Bsquedas y sondeos extra del hilo an no publicados en las mtricas
+    struct BusquedasPendientes {
+        size_t posicionBusquedas;
+        size_t posicionSondeos;
+        uint64_t busquedas = 0;
+        uint64_t sondeos = 0;
+
+        BusquedasPendientes()
+            : posicionBusquedas(Metricas::global().registrar("HashTable.busquedas", Metricas::Tipo::Contador)),
+            posicionSondeos(Metricas::global().registrar("HashTable.sondeos", Metricas::Tipo::Contador)) {
+            // Crea el fragmento de mtricas del hilo antes que este objeto, as sigue vivo
+            // cuando el destructor publica lo que qued pendiente al terminar el hilo
+            Metricas::global().sumar(posicionBusquedas, 0);
+        }
+        ~BusquedasPendientes() {
+            publicar();
+        }
+        void publicar() {
+            Metricas& metricas = Metricas::global();
+            if (metricas.getActivas()) {
+                metricas.sumar(posicionBusquedas, busquedas);
+                metricas.sumar(posicionSondeos, sondeos);
+            }
+            busquedas = 0;
+            sondeos = 0;
+        }
+    };
+    static constexpr uint64_t LOTE_METRICAS = 256;
+
+    // Cuenta una bsqueda y los sondeos extra (colisiones) que necesit; se acumulan en el hilo
+    // y se publican cada LOTE_METRICAS bsquedas para no tocar las mtricas en cada una
+    static void contarBusqueda(size_t sondeos) {
+        thread_local BusquedasPendientes pendientes;
+        pendientes.sondeos += sondeos;
+        if (++pendientes.busquedas == LOTE_METRICAS) {
+            pendientes.publicar();
+        }
     }
 
     void expand() {
+        static Histograma latencia("HashTable.expandir");
+        Cronometro cronometro(latencia);
+        ZonaMemoria zona(Subsistema::Contenedores, false);
         size_t oldCapacity = capacity;
         capacity *= 2;
-        HashEntity<C>** newTable = new HashEntity<C>*[capacity];
+        HashEntity<C, K>** newTable = new HashEntity<C, K>*[capacity];
 
         for (size_t i = 0; i < capacity; ++i) {
             newTable[i] = nullptr;
@@ -42,25 +102,29 @@ private:
 
 public:
     HashTable(size_t initialCapacity) : capacity(initialCapacity), length(0) {
-        table = new HashEntity<C>*[capacity];
+        table = new HashEntity<C, K>*[capacity];
         for (size_t i = 0; i < capacity; ++i) {
             table[i] = nullptr;
         }
     }
 
-    bool addElement(const string& key, const C& element) {
+    bool addElement(const K& key, const C& element) {
+        ZonaMemoria zona(Subsistema::Contenedores, false);
         if (length >= capacity * 0.7) { // Si se supera el 70% de la capacidad, expandir
             expand();
         }
 
         size_t index = hash(key);
+        size_t sondeos = 0;
         while (table[index] != nullptr && table[index]->key != key) {
             index = (index + 1) % capacity; // Manejar colisiones mediante sondeo lineal
+            ++sondeos;
         }
+        contarBusqueda(sondeos);
 
         if (table[index] == nullptr) {
             // Si la posicin est vaca, crear un nuevo elemento
-            table[index] = new HashEntity<C>(key, element);
+            table[index] = new HashEntity<C, K>(key, element);
             length++;
             return true;
         }
@@ -71,17 +135,47 @@ public:
         }
     }
 
-    C getElement(const string& key) {
+    C getElement(const K& key) {
         size_t index = hash(key);
+        size_t sondeos = 0;
         while (table[index] != nullptr) {
             if (table[index]->key == key) {
+                contarBusqueda(sondeos);
                 return table[index]->element;
             }
             index = (index + 1) % capacity;
+            ++sondeos;
         }
+        contarBusqueda(sondeos);
         throw std::runtime_error("Clave no encontrada en la tabla hash.");
     }
 
+    bool contains(const K& key) {
+        size_t index = hash(key);
+        size_t sondeos = 0;
+        while (table[index] != nullptr) {
+            if (table[index]->key == key) {
+                contarBusqueda(sondeos);
+                return true;
+            }
+            index = (index + 1) % capacity;
+            ++sondeos;
+        }
+        contarBusqueda(sondeos);
+        return false;
+    }
+
+    // Aplica una operacin a todos los elementos de la tabla
+    void apply(const std::function<void(C&)>& operation) {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (table[i] != nullptr) {
+                operation(table[i]->element);
+            }
+        }
+    }
+
+    size_t size() const { return length; }
+
     bool empty() { return length == 0; }
 
     void clear() {
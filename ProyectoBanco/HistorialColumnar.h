@@ -0,0 +1,347 @@
+#pragma once
+
+#include "IFileable.h"
+#include "Cuenta.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Columnas del historial columnar (se pueden combinar con '|')
+namespace ColumnasHistorial
+{
+    constexpr unsigned CUENTA = 1; // Nmero de cuenta como entero de 64 bits
+    constexpr unsigned TIPO = 2;   // TipoTransaccion como entero de 8 bits
+    constexpr unsigned FECHA = 4;  // Fecha de emisin como nmero de da (Fecha::toNumeroDia)
+    constexpr unsigned MONTO = 8;  // Monto en cntimos como entero de 64 bits
+    constexpr unsigned TODAS = CUENTA | TIPO | FECHA | MONTO;
+}
+
+// Historial de transacciones guardado por columnas para anlisis.
+//
+// Formato del archivo (enteros en el orden de bytes de la mquina):
+//   cabecera:   "PBCOLHST" | version u32 | numeroColumnas u32 | filas u64
+//   directorio: por columna: nombre char[16] | anchoBytes u32 | conSigno u32 | desplazamiento u64
+//   datos:      cada columna contigua, alineada a 8 bytes, con 'filas' elementos
+class HistorialColumnar : public IDebugable, IFileable
+{
+private:
+    string archivo;            // Ruta del archivo binario
+    unsigned columnas;         // Columnas que se leen con loadFromFile
+    size_t filas;              // Nmero de transacciones
+    vector<uint64_t> cuentas;  // Columna CUENTA
+    vector<uint8_t> tipos;     // Columna TIPO
+    vector<int32_t> fechas;    // Columna FECHA
+    vector<int64_t> montos;    // Columna MONTO
+
+    static constexpr char MAGIA[9] = "PBCOLHST";
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t LONGITUD_NOMBRE = 16;
+
+    // Descriptor de una columna en el directorio del archivo
+    struct Columna {
+        const char* nombre;
+        uint32_t anchoBytes;
+        uint32_t conSigno;
+        const void* datos;
+    };
+
+    size_t _columnasEnMemoria(Columna* descriptores) const;
+    template <class T>
+    static void _escribir(ofstream& out, const T& valor);
+    template <class T>
+    static bool _leer(ifstream& in, T& valor);
+    static uint64_t _alinear(uint64_t posicion);
+
+public:
+    HistorialColumnar(const string& archivo, unsigned columnas = ColumnasHistorial::TODAS);
+    ~HistorialColumnar() = default;
+
+    string getArchivo() const;
+    unsigned getColumnas() const;
+    size_t size() const;
+    bool empty() const;
+
+    bool setArchivo(const string& archivo);
+    bool setColumnas(unsigned columnas);
+
+    // Acceso de solo lectura a cada columna (vaca si no se carg)
+    const vector<uint64_t>& getCuentas() const;
+    const vector<uint8_t>& getTipos() const;
+    const vector<int32_t>& getFechas() const;
+    const vector<int64_t>& getMontos() const;
+
+    // Agrega al final todas las transacciones de una cuenta
+    void agregarCuenta(const Cuenta& cuenta);
+    void clear();
+
+    string toDebug() const override;
+    bool saveToFile() const override;
+    bool loadFromFile() override;
+};
+
+constexpr char HistorialColumnar::MAGIA[9];
+constexpr uint32_t HistorialColumnar::VERSION;
+constexpr size_t HistorialColumnar::LONGITUD_NOMBRE;
+
+HistorialColumnar::HistorialColumnar(const string& archivo, unsigned columnas)
+    : archivo(archivo), columnas(columnas & ColumnasHistorial::TODAS), filas(0)
+{}
+
+string HistorialColumnar::getArchivo() const {
+    return archivo;
+}
+
+unsigned HistorialColumnar::getColumnas() const {
+    return columnas;
+}
+
+size_t HistorialColumnar::size() const {
+    return filas;
+}
+
+bool HistorialColumnar::empty() const {
+    return filas == 0;
+}
+
+bool HistorialColumnar::setArchivo(const string& archivo) {
+    if (archivo.empty()) {
+        return false;
+    }
+    this->archivo = archivo;
+    return true;
+}
+
+bool HistorialColumnar::setColumnas(unsigned columnas) {
+    if ((columnas & ColumnasHistorial::TODAS) == 0) {
+        return false;
+    }
+    this->columnas = columnas & ColumnasHistorial::TODAS;
+    return true;
+}
+
+const vector<uint64_t>& HistorialColumnar::getCuentas() const {
+    return cuentas;
+}
+
+const vector<uint8_t>& HistorialColumnar::getTipos() const {
+    return tipos;
+}
+
+const vector<int32_t>& HistorialColumnar::getFechas() const {
+    return fechas;
+}
+
+const vector<int64_t>& HistorialColumnar::getMontos() const {
+    return montos;
+}
+
+void HistorialColumnar::agregarCuenta(const Cuenta& cuenta) {
+    ZonaMemoria zona(Subsistema::Historiales);
+    NumeroCuenta numero = cuenta.getNumeroCuentaNumerico();
+    uint64_t numeroCuenta = numero.empty() ? 0 : numero.getValor();
+
+    cuenta.recorrerHistorial([&](const RegistroTransaccion& registro) {
+        cuentas.push_back(numeroCuenta);
+        tipos.push_back(registro.tipo);
+        fechas.push_back(registro.numeroDia);
+        montos.push_back(registro.centimos);
+        ++filas;
+        });
+}
+
+void HistorialColumnar::clear() {
+    filas = 0;
+    cuentas.clear();
+    tipos.clear();
+    fechas.clear();
+    montos.clear();
+}
+
+string HistorialColumnar::toDebug() const {
+    ostringstream debug;
+    debug << "HistorialColumnar(archivo='" << archivo
+        << "', filas=" << filas
+        << ", cuentas=" << cuentas.size()
+        << ", tipos=" << tipos.size()
+        << ", fechas=" << fechas.size()
+        << ", montos=" << montos.size() << ")";
+    return debug.str();
+}
+
+// Llena los descriptores de las columnas completas y retorna cuntas hay
+size_t HistorialColumnar::_columnasEnMemoria(Columna* descriptores) const {
+    Columna todas[] = {
+        { "cuenta", 8, 0, cuentas.data() },
+        { "tipo", 1, 0, tipos.data() },
+        { "fecha", 4, 1, fechas.data() },
+        { "monto", 8, 1, montos.data() },
+    };
+    size_t longitudes[] = { cuentas.size(), tipos.size(), fechas.size(), montos.size() };
+
+    size_t n = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        if (longitudes[i] == filas) {
+            descriptores[n++] = todas[i];
+        }
+    }
+    return n;
+}
+
+template <class T>
+void HistorialColumnar::_escribir(ofstream& out, const T& valor) {
+    out.write(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+template <class T>
+bool HistorialColumnar::_leer(ifstream& in, T& valor) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&valor), sizeof(T)));
+}
+
+uint64_t HistorialColumnar::_alinear(uint64_t posicion) {
+    return (posicion + 7) & ~static_cast<uint64_t>(7);
+}
+
+bool HistorialColumnar::saveToFile() const {
+    static Histograma latencia("HistorialColumnar.saveToFile");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Serializacion);
+    ofstream out(archivo, ios::binary | ios::trunc);
+    if (!out) {
+        cerr << "Error al abrir el archivo para guardar el historial columnar.\n";
+        return false;
+    }
+
+    Columna descriptores[4];
+    size_t numeroColumnas = _columnasEnMemoria(descriptores);
+
+    // Cabecera
+    out.write(MAGIA, 8);
+    _escribir(out, VERSION);
+    _escribir(out, static_cast<uint32_t>(numeroColumnas));
+    _escribir(out, static_cast<uint64_t>(filas));
+
+    // Directorio: los datos empiezan despus del directorio, alineados a 8 bytes
+    uint64_t tamanioDirectorio = numeroColumnas * (LONGITUD_NOMBRE + 4 + 4 + 8);
+    uint64_t posicion = _alinear(8 + 4 + 4 + 8 + tamanioDirectorio);
+    uint64_t desplazamientos[4];
+    for (size_t i = 0; i < numeroColumnas; ++i) {
+        char nombre[LONGITUD_NOMBRE] = {};
+        strncpy(nombre, descriptores[i].nombre, LONGITUD_NOMBRE - 1);
+        out.write(nombre, LONGITUD_NOMBRE);
+        _escribir(out, descriptores[i].anchoBytes);
+        _escribir(out, descriptores[i].conSigno);
+        _escribir(out, posicion);
+
+        desplazamientos[i] = posicion;
+        posicion = _alinear(posicion + static_cast<uint64_t>(filas) * descriptores[i].anchoBytes);
+    }
+
+    // Datos de cada columna, contiguos
+    for (size_t i = 0; i < numeroColumnas; ++i) {
+        out.seekp(static_cast<streamoff>(desplazamientos[i]));
+        out.write(static_cast<const char*>(descriptores[i].datos),
+            static_cast<streamsize>(filas * descriptores[i].anchoBytes));
+    }
+
+    return out.good();
+}
+
+bool HistorialColumnar::loadFromFile() {
+    static Histograma latencia("HistorialColumnar.loadFromFile");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Historiales);
+    ifstream in(archivo, ios::binary | ios::ate);
+    if (!in) {
+        return false;
+    }
+    uint64_t tamanioArchivo = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+
+    char magia[8];
+    uint32_t version, numeroColumnas;
+    uint64_t filasArchivo;
+    if (!in.read(magia, 8) || memcmp(magia, MAGIA, 8) != 0 ||
+        !_leer(in, version) || version != VERSION ||
+        !_leer(in, numeroColumnas) || !_leer(in, filasArchivo)) {
+        cerr << "El archivo no es un historial columnar valido.\n";
+        return false;
+    }
+
+    clear();
+    filas = static_cast<size_t>(filasArchivo);
+
+    // Leer el directorio completo y luego solo las columnas pedidas
+    for (uint32_t i = 0; i < numeroColumnas; ++i) {
+        char nombre[LONGITUD_NOMBRE];
+        uint32_t anchoBytes, conSigno;
+        uint64_t desplazamiento;
+        if (!in.read(nombre, LONGITUD_NOMBRE) || !_leer(in, anchoBytes) ||
+            !_leer(in, conSigno) || !_leer(in, desplazamiento)) {
+            clear();
+            return false;
+        }
+        nombre[LONGITUD_NOMBRE - 1] = '\0';
+
+        streamoff siguiente = in.tellg();
+        string columna(nombre);
+        unsigned bandera = 0;
+        uint32_t anchoEsperado = 0;
+        if (columna == "cuenta") {
+            bandera = ColumnasHistorial::CUENTA;
+            anchoEsperado = 8;
+        }
+        else if (columna == "tipo") {
+            bandera = ColumnasHistorial::TIPO;
+            anchoEsperado = 1;
+        }
+        else if (columna == "fecha") {
+            bandera = ColumnasHistorial::FECHA;
+            anchoEsperado = 4;
+        }
+        else if (columna == "monto") {
+            bandera = ColumnasHistorial::MONTO;
+            anchoEsperado = 8;
+        }
+
+        if ((columnas & bandera) == 0) {
+            continue; // Columna desconocida o no pedida: no se lee
+        }
+        // 'filas' y el desplazamiento vienen del archivo: la columna debe caber en l antes
+        // de reservar memoria para leerla
+        if (anchoBytes != anchoEsperado || desplazamiento > tamanioArchivo ||
+            filasArchivo > (tamanioArchivo - desplazamiento) / anchoBytes) {
+            cerr << "El historial columnar esta truncado o danado (columna " << columna << ").\n";
+            clear();
+            return false;
+        }
+
+        char* destino = nullptr;
+        switch (bandera) {
+        case ColumnasHistorial::CUENTA:
+            cuentas.resize(filas);
+            destino = reinterpret_cast<char*>(cuentas.data());
+            break;
+        case ColumnasHistorial::TIPO:
+            tipos.resize(filas);
+            destino = reinterpret_cast<char*>(tipos.data());
+            break;
+        case ColumnasHistorial::FECHA:
+            fechas.resize(filas);
+            destino = reinterpret_cast<char*>(fechas.data());
+            break;
+        default:
+            montos.resize(filas);
+            destino = reinterpret_cast<char*>(montos.data());
+            break;
+        }
+
+        in.seekg(static_cast<streamoff>(desplazamiento));
+        if (!in.read(destino, static_cast<streamsize>(filas * anchoBytes))) {
+            clear();
+            return false;
+        }
+        in.seekg(siguiente);
+    }
+
+    return true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Format.h"
+#include "Sesion.h"
 
 #include "iostream"
 
@@ -12,6 +13,18 @@ public:
     // Destructor virtual
     virtual ~IInteractive() = default;
 
-    // Mtodo que debe implementarse para interactuar con el usuario.
-    virtual void interact() = 0;
-};
\ No newline at end of file
+    // Men interactivo como corrutina: lee con co_await sesion.leerLinea() y escribe en
+    // sesion.out(), por lo que el mismo men sirve para la consola y para sesiones multiplexadas.
+    virtual Tarea interactuar(Sesion& sesion) = 0;
+
+    // Interacta con el usuario por consola (bloquea hasta que sale del men)
+    virtual void interact();
+};
+
+void IInteractive::interact()
+{
+    Sesion consola(cin, cout);
+    Tarea tarea = interactuar(consola);
+    tarea.iniciar();
+    tarea.verificar();
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Aleatorio.h"
 #include <cstdlib>
 #include <ctime>
 
@@ -11,6 +12,15 @@ public:
     // Destructor virtual
     virtual ~IRandomizable() = default;
 
-    // Mtodo que debe implementarse para generar valores aleatorios.
-    virtual void generateRandom() = 0;
-};
\ No newline at end of file
+    // Mtodo que debe implementarse para generar valores aleatorios tomndolos de 'aleatorio';
+    // con el mismo estado del generador se obtienen los mismos valores.
+    virtual void generateRandom(Aleatorio& aleatorio) = 0;
+
+    // Genera valores con el generador del hilo actual.
+    virtual void generateRandom();
+};
+
+void IRandomizable::generateRandom()
+{
+    generateRandom(Aleatorio::delHilo());
+}
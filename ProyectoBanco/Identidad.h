@@ -1,17 +1,34 @@
 #pragma once
 
 #include "Fecha.h"
+#include "Memoria.h"
+#include "Serializable.h"
+#include "NumeroFijo.h"
 
 enum class Sexo { Masculino, Femenino, Desconocido };               // Enum para representar el sexo
 enum class EstadoCivil { Soltero, Casado, Divorciado, Viudo, Desconocido }; // Enum para representar el estado civil
 
+template<>
+struct NombresEnum<Sexo>
+{
+    static constexpr const char* nombres[] = { "Masculino", "Femenino", "Desconocido" };
+};
+
+template<>
+struct NombresEnum<EstadoCivil>
+{
+    static constexpr const char* nombres[] = { "Soltero", "Casado", "Divorciado", "Viudo", "Desconocido" };
+};
+
 // Mdulo Identidad
-class Identidad : public IDebugable, ISavable, IRandomizable
+class Identidad : public IDebugable, ISavable, IRandomizable, public Serializable<Identidad>
 {
 private:
-    string dni;                    // DNI de la persona
-    string primerApellido;         // Primer apellido de la persona
-    string segundoApellido;        // Segundo apellido de la persona
+    DNI dni;                       // DNI de la persona (8 dgitos)
+    // Los apellidos se repiten mucho entre clientes: se guardan internados (ver PoolCadenas.h).
+    // Los nombres son texto libre (combinaciones de varios nombres): internarlos llenara el pool
+    CadenaInterna primerApellido;  // Primer apellido de la persona
+    CadenaInterna segundoApellido; // Segundo apellido de la persona
     string nombres;                // Nombres de la persona
     Fecha fechaNacimiento;              // Fecha de nacimiento de la persona
     Sexo sexo;                          // Sexo de la persona
@@ -35,6 +52,8 @@ public:
 
     // Retorna el DNI
     string getDNI() const;
+    // Retorna el DNI como nmero de 8 dgitos (clave de los ndices del registro)
+    DNI getDNINumerico() const;
     // Retorna el primer apellido
     string getPrimerApellido() const;
     // Retorna el segundo apellido
@@ -82,9 +101,25 @@ public:
     void load(const string& data) override;
 
     // Mtodo para generar datos aleatorios
-    void generateRandom() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
+
+    // Campos que se guardan, en orden (ver Serializable.h)
+    static constexpr auto esquema();
 };
 
+constexpr auto Identidad::esquema()
+{
+    return crearEsquema("Identidad", Serialization::DELIMITER_SECTION,
+        campo("DNI", &Identidad::dni),
+        campo("PrimerApellido", &Identidad::primerApellido, &Identidad::setPrimerApellido),
+        campo("SegundoApellido", &Identidad::segundoApellido, &Identidad::setSegundoApellido),
+        campo("Nombres", &Identidad::nombres, &Identidad::setNombres),
+        campo("FechaNacimiento", &Identidad::fechaNacimiento),
+        campo("Sexo", &Identidad::sexo),
+        campo("EstadoCivil", &Identidad::estadoCivil));
+}
+
 // Implementacin de Constructores
 Identidad::Identidad(const string& dni, const string& primerApellido,
     const string& segundoApellido, const string& nombres,
@@ -94,7 +129,7 @@ Identidad::Identidad(const string& dni, const string& primerApellido,
 {}
 
 Identidad::Identidad()
-    : dni(""), primerApellido(""), segundoApellido(""), nombres(""),
+    : dni(), primerApellido(), segundoApellido(), nombres(),
     fechaNacimiento(Fecha()), sexo(Sexo::Desconocido), estadoCivil(EstadoCivil::Desconocido)
 {}
 
@@ -104,7 +139,8 @@ Identidad::Identidad(const string& datos)
 }
 
 // Implementacin de Getters
-string Identidad::getDNI() const { return dni; }
+string Identidad::getDNI() const { return dni.toString(); }
+DNI Identidad::getDNINumerico() const { return dni; }
 string Identidad::getPrimerApellido() const { return primerApellido; }
 string Identidad::getSegundoApellido() const { return segundoApellido; }
 string Identidad::getNombres() const { return nombres; }
@@ -116,12 +152,7 @@ EstadoCivil Identidad::getEstadoCivil() const { return estadoCivil; }
 bool Identidad::setDNI(const string& dni)
 {
     // Verifica que el DNI tenga exactamente 8 caracteres y contenga solo dgitos
-    if (dni.length() != 8) return false;
-    for (char c : dni) {
-        if (c < '0' || c > '9') return false; // Solo dgitos permitidos
-    }
-    this->dni = dni; // Asigna el DNI
-    return true; // xito
+    return this->dni.asignar(dni);
 }
 
 bool Identidad::setPrimerApellido(const string& primerApellido)
@@ -198,81 +229,33 @@ string Identidad::toStringEstadoCivil() const
 // Mtodo para retornar una representacin textual del objeto
 string Identidad::toDebug() const
 {
-    ostringstream debug;
-    debug << "Identidad(DNI='" << dni
-        << "', PrimerApellido='" << primerApellido
-        << "', SegundoApellido='" << segundoApellido
-        << "', Nombres='" << nombres
-        << "', FechaNacimiento='" << fechaNacimiento.toStringDDMMAAAA()
-        << "', Sexo='" << toStringSexo()
-        << "', EstadoCivil='" << toStringEstadoCivil()
-        << "')";
-    return debug.str();
+    return depurar();
 }
 
 // Mtodo para guardar la informacin
 string Identidad::toSave() const
 {
-    ostringstream out; // Para construir el string de salida
-    out << dni << Serialization::DELIMITER_SECTION
-        << primerApellido << Serialization::DELIMITER_SECTION
-        << segundoApellido << Serialization::DELIMITER_SECTION
-        << nombres << Serialization::DELIMITER_SECTION
-        << fechaNacimiento.toStringDDMMAAAA() << Serialization::DELIMITER_SECTION
-        << toStringSexo() << Serialization::DELIMITER_SECTION
-        << toStringEstadoCivil();
-    return out.str(); // Retorna el string generado
+    return guardar(); // Los campos del esquema separados por DELIMITER_SECTION
 }
 
 // Mtodo para cargar la informacin
 void Identidad::load(const string& data)
 {
-    istringstream in(data); // Flujo para leer datos
-    string fechaString, sexoString, estadoCivilString;
-
-    // Lee los datos separados por delimitadores
-    if (!getline(in, dni, Serialization::DELIMITER_SECTION) ||
-        !getline(in, primerApellido, Serialization::DELIMITER_SECTION) ||
-        !getline(in, segundoApellido, Serialization::DELIMITER_SECTION) ||
-        !getline(in, nombres, Serialization::DELIMITER_SECTION) ||
-        !getline(in, fechaString, Serialization::DELIMITER_SECTION) ||
-        !getline(in, sexoString, Serialization::DELIMITER_SECTION) ||
-        !getline(in, estadoCivilString, Serialization::DELIMITER_SECTION))
-    {
-        throw runtime_error("Error al cargar los datos: datos insuficientes o mal formateados.");
-    }
-
-    // Asigna los datos ledos utilizando los setters
-    if (!setDNI(dni) || !setPrimerApellido(primerApellido) ||
-        !setSegundoApellido(segundoApellido) || !setNombres(nombres))
-    {
-        throw runtime_error("Error al asignar datos a la identidad: formato invlido.");
-    }
-
-    // Asigna el sexo basado en la cadena leda
-    sexo = (sexoString == "Masculino") ? Sexo::Masculino :
-        (sexoString == "Femenino") ? Sexo::Femenino : Sexo::Desconocido;
-
-    // Asigna el estado civil basado en la cadena leda
-    if (estadoCivilString == "Soltero")
-        estadoCivil = EstadoCivil::Soltero;
-    else if (estadoCivilString == "Casado")
-        estadoCivil = EstadoCivil::Casado;
-    else if (estadoCivilString == "Divorciado")
-        estadoCivil = EstadoCivil::Divorciado;
-    else if (estadoCivilString == "Viudo")
-        estadoCivil = EstadoCivil::Viudo;
-    else
-        estadoCivil = EstadoCivil::Desconocido;
+    ZonaMemoria zona(Subsistema::Identidades);
+    // Valida DNI, apellidos y nombres con sus setters; un sexo o estado civil que no se reconoce
+    // se carga como Desconocido
+    cargar(data);
 }
 
 // Mtodo para generar datos aleatorios
-void Identidad::generateRandom() {
+void Identidad::generateRandom(Aleatorio& aleatorio) {
+    ZonaMemoria zona(Subsistema::Identidades);
     // Generar un DNI aleatorio de 8 dgitos
-    dni.clear();
+    uint64_t numero = 0;
     for (int i = 0; i < 8; ++i) {
-        dni += '0' + (rand() % 10); // Generar un dgito aleatorio entre 0 y 9
+        numero = numero * 10 + aleatorio.entero(10); // Agregar un dgito aleatorio entre 0 y 9
     }
+    dni.setValor(numero);
 
     // Generar apellidos aleatorios usando un array esttico de apellidos
     const string apellidos[] = {
@@ -280,8 +263,8 @@ void Identidad::generateRandom() {
         "Hernandez", "Diaz", "Fernandez", "Lima", "Sanchez", "Vasquez",
         "Romero", "Alvarez", "Morales", "Jimenez"
     };
-    primerApellido = apellidos[rand() % (sizeof(apellidos) / sizeof(apellidos[0]))];
-    segundoApellido = apellidos[rand() % (sizeof(apellidos) / sizeof(apellidos[0]))];
+    primerApellido = apellidos[aleatorio.entero(sizeof(apellidos) / sizeof(apellidos[0]))];
+    segundoApellido = apellidos[aleatorio.entero(sizeof(apellidos) / sizeof(apellidos[0]))];
 
     // Generar nombres aleatorios usando un array esttico de nombres
     const string nombresPosibles[] = {
@@ -289,22 +272,20 @@ void Identidad::generateRandom() {
         "Miguel", "Sofia", "Antonio", "Elena", "Pedro", "Isabel", "David",
         "Patricia", "Raul", "Marta", "Eduardo", "Beatriz"
     };
-    nombres = nombresPosibles[rand() % (sizeof(nombresPosibles) / sizeof(nombresPosibles[0]))]
+    nombres = nombresPosibles[aleatorio.entero(sizeof(nombresPosibles) / sizeof(nombresPosibles[0]))]
         + " "
-        + nombresPosibles[rand() % (sizeof(nombresPosibles) / sizeof(nombresPosibles[0]))];
+        + nombresPosibles[aleatorio.entero(sizeof(nombresPosibles) / sizeof(nombresPosibles[0]))];
 
-    // Generar fecha de nacimiento aleatoria (ao entre 1970 y 2000)
-    int dia = rand() % 31 + 1;      // Da entre 1 y 31
-    int mes = rand() % 12 + 1;      // Mes entre 1 y 12
-    int anio = rand() % 31 + 1970;  // Ao entre 1970 y 2000
-    fechaNacimiento = Fecha(dia, mes, anio);
+    // Generar fecha de nacimiento aleatoria (entre 01/01/1970 y 31/12/2000); se elige el
+    // nmero de da para no generar fechas inexistentes como el 31/02
+    fechaNacimiento.setNumeroDia(aleatorio.entero(Fecha(31, 12, 2000).toNumeroDia() + 1));
 
     // Generar sexo aleatorio (Masculino o Femenino)
-    sexo = (rand() % 2 == 0) ? Sexo::Masculino : Sexo::Femenino;
+    sexo = (aleatorio.entero(2) == 0) ? Sexo::Masculino : Sexo::Femenino;
 
     // Generar estado civil aleatorio
-    estadoCivil = static_cast<EstadoCivil>(rand() % 5); // Genera un nmero entre 0 y 4
+    estadoCivil = static_cast<EstadoCivil>(aleatorio.entero(5)); // Genera un nmero entre 0 y 4
 
     // Opcional: Asegurar que el estado civil sea uno vlido
-    // Puedes agregar validacin si lo deseas, aunque el `rand() % 5` debera funcionar correctamente.
+    // Puedes agregar validacin si lo deseas, aunque el rango de 0 a 4 debera funcionar correctamente.
 }
\ No newline at end of file
@@ -0,0 +1,418 @@
+#pragma once
+
+#include "MGeneral.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Resultado de una importacin masiva de clientes
+struct ResultadoImportacion : public IDebugable
+{
+	size_t registros = 0;    // Clientes importados correctamente
+	size_t malformados = 0;  // Lneas que no se pudieron interpretar
+	size_t duplicados = 0;   // Clientes cuyo DNI ya estaba registrado
+	size_t bytes = 0;        // Bytes ledos del archivo
+	double segundos = 0;     // Tiempo total de la importacin
+
+	// Registros procesados por segundo
+	double registrosPorSegundo() const;
+	// Suma los contadores de otro resultado parcial (el tiempo no se acumula)
+	void acumular(const ResultadoImportacion& otro);
+
+	string toDebug() const override;
+};
+
+double ResultadoImportacion::registrosPorSegundo() const
+{
+	return segundos > 0 ? (registros + malformados + duplicados) / segundos : 0;
+}
+
+void ResultadoImportacion::acumular(const ResultadoImportacion& otro)
+{
+	registros += otro.registros;
+	malformados += otro.malformados;
+	duplicados += otro.duplicados;
+	bytes += otro.bytes;
+}
+
+string ResultadoImportacion::toDebug() const
+{
+	ostringstream debug;
+	debug << "ResultadoImportacion(registros=" << registros
+		<< ", malformados=" << malformados
+		<< ", duplicados=" << duplicados
+		<< ", bytes=" << bytes
+		<< ", segundos=" << segundos
+		<< ", registrosPorSegundo=" << registrosPorSegundo() << ")";
+	return debug.str();
+}
+
+// Importador de archivos de clientes (un Cliente::toSave por lnea) con memoria acotada
+class ImportadorClientes
+{
+private:
+	Fecha fechaActual;       // Fecha con la que se crean los clientes
+	size_t tamanioBloque;    // Bytes ledos del archivo en cada lectura
+	size_t longitudMaxima;   // Longitud mxima de un registro; los ms largos se descartan
+
+	Cliente* _parsearLinea(string& linea, ResultadoImportacion& resultado) const;
+	void _registrar(Cliente* cliente, MGeneral& registro, ResultadoImportacion& resultado) const;
+	void _procesarLinea(string& linea, MGeneral& registro, ResultadoImportacion& resultado) const;
+	// Lee 'in' por bloques y entrega cada registro completo a 'procesar'; los de ms de
+	// 'longitudMaxima' bytes se descartan sin guardarlos y se cuentan como malformados.
+	// Se detiene antes del primer registro que empiece a 'limite' bytes o ms de la posicin
+	// inicial. Con 'saltarPrimera' el primer registro (resto de una lnea ajena) se ignora.
+	void _leerLineas(istream& in, streamoff limite, bool saltarPrimera, ResultadoImportacion& resultado,
+		const function<void(string&)>& procesar, const function<void()>& bloqueLeido) const;
+	// Interpreta las lneas que empiezan en [inicio, fin) y agrega los clientes a 'lote' sin registrarlos
+	void _procesarTramo(const string& archivo, streamoff inicio, streamoff fin, vector<Cliente*>& lote,
+		ResultadoImportacion& resultado) const;
+	// Acumula el resultado de una importacin en las mtricas del proceso
+	static void _contar(const ResultadoImportacion& resultado);
+
+public:
+	ImportadorClientes(const Fecha& fechaActual, size_t tamanioBloque = 1 << 20, size_t longitudMaxima = 1 << 16);
+
+	size_t getTamanioBloque() const;
+	size_t getLongitudMaxima() const;
+
+	bool setTamanioBloque(size_t tamanioBloque);
+	bool setLongitudMaxima(size_t longitudMaxima);
+
+	// Lee el archivo por bloques y registra cada cliente a medida que se completa su lnea.
+	// 'progreso' se invoca despus de cada bloque con el resultado parcial.
+	ResultadoImportacion importar(const string& archivo, MGeneral& registro,
+		const function<void(const ResultadoImportacion&)>& progreso = nullptr) const;
+
+	// Divide el archivo en tramos de 'tamanioBloque' bytes alineados a inicio de lnea y los
+	// interpreta en 'hilos' hilos (0 = todos los ncleos). Cada tramo se registra en un solo lote
+	// y los lotes se registran en el orden del archivo, as un DNI repetido se resuelve igual que
+	// en importar (gana la primera aparicin).
+	ResultadoImportacion importarParalelo(const string& archivo, MGeneral& registro, size_t hilos = 0) const;
+};
+
+ImportadorClientes::ImportadorClientes(const Fecha& fechaActual, size_t tamanioBloque, size_t longitudMaxima)
+	: fechaActual(fechaActual), tamanioBloque(1 << 20), longitudMaxima(1 << 16)
+{
+	setTamanioBloque(tamanioBloque);
+	setLongitudMaxima(longitudMaxima);
+}
+
+size_t ImportadorClientes::getTamanioBloque() const
+{
+	return tamanioBloque;
+}
+
+size_t ImportadorClientes::getLongitudMaxima() const
+{
+	return longitudMaxima;
+}
+
+bool ImportadorClientes::setTamanioBloque(size_t tamanioBloque)
+{
+	if (tamanioBloque == 0)
+	{
+		return false;
+	}
+	this->tamanioBloque = tamanioBloque;
+	return true;
+}
+
+bool ImportadorClientes::setLongitudMaxima(size_t longitudMaxima)
+{
+	if (longitudMaxima == 0)
+	{
+		return false;
+	}
+	this->longitudMaxima = longitudMaxima;
+	return true;
+}
+
+Cliente* ImportadorClientes::_parsearLinea(string& linea, ResultadoImportacion& resultado) const
+{
+	// Aceptar archivos con fin de lnea de Windows
+	if (!linea.empty() && linea.back() == '\r')
+	{
+		linea.pop_back();
+	}
+	if (linea.empty())
+	{
+		return nullptr;
+	}
+
+	try
+	{
+		return new Cliente(fechaActual, linea);
+	}
+	catch (const exception&)
+	{
+		++resultado.malformados;
+		return nullptr;
+	}
+}
+
+void ImportadorClientes::_registrar(Cliente* cliente, MGeneral& registro, ResultadoImportacion& resultado) const
+{
+	if (registro.addCliente(cliente))
+	{
+		++resultado.registros;
+	}
+	else
+	{
+		delete cliente;
+		++resultado.duplicados;
+	}
+}
+
+void ImportadorClientes::_procesarLinea(string& linea, MGeneral& registro, ResultadoImportacion& resultado) const
+{
+	Cliente* cliente = _parsearLinea(linea, resultado);
+	if (cliente != nullptr)
+	{
+		_registrar(cliente, registro, resultado);
+	}
+}
+
+void ImportadorClientes::_leerLineas(istream& in, streamoff limite, bool saltarPrimera, ResultadoImportacion& resultado,
+	const function<void(string&)>& procesar, const function<void()>& bloqueLeido) const
+{
+	vector<char> bloque(tamanioBloque);
+	string linea;                       // Registro en construccin (puede abarcar varios bloques)
+	bool ajeno = saltarPrimera;         // El registro actual pertenece a otro tramo
+	bool descartando = saltarPrimera;   // El registro actual no se guarda (ajeno o demasiado largo)
+	streamoff posicion = 0;             // Bytes consumidos desde la posicin inicial
+	streamoff inicioLinea = 0;          // Posicin en la que empieza el registro actual
+
+	while (in && inicioLinea < limite)
+	{
+		// Pasado el lmite solo falta terminar el ltimo registro: se lee de a poco
+		size_t pedidos = bloque.size();
+		if (posicion >= limite)
+		{
+			pedidos = min<size_t>(pedidos, 4096);
+		}
+		in.read(bloque.data(), pedidos);
+		size_t leidos = static_cast<size_t>(in.gcount());
+		if (leidos == 0)
+		{
+			break;
+		}
+
+		const char* actual = bloque.data();
+		const char* fin = actual + leidos;
+		while (actual < fin)
+		{
+			const char* salto = static_cast<const char*>(memchr(actual, '\n', fin - actual));
+			const char* corte = salto ? salto : fin;
+
+			if (!descartando)
+			{
+				if (linea.size() + (corte - actual) > longitudMaxima)
+				{
+					// El registro no cabe en el bfer: se descarta hasta el siguiente salto de lnea
+					descartando = true;
+					linea.clear();
+				}
+				else
+				{
+					linea.append(actual, corte);
+				}
+			}
+			posicion += corte - actual;
+
+			if (salto == nullptr)
+			{
+				break;
+			}
+			++posicion;
+
+			if (ajeno)
+			{
+				ajeno = false;
+			}
+			else
+			{
+				resultado.bytes += posicion - inicioLinea;
+				if (descartando)
+				{
+					++resultado.malformados;
+				}
+				else
+				{
+					procesar(linea);
+				}
+			}
+			descartando = false;
+			linea.clear();
+			inicioLinea = posicion;
+			actual = salto + 1;
+
+			if (inicioLinea >= limite)
+			{
+				break;
+			}
+		}
+
+		if (bloqueLeido)
+		{
+			bloqueLeido();
+		}
+	}
+
+	// ltimo registro sin salto de lnea final
+	if (!ajeno && inicioLinea < limite && posicion > inicioLinea)
+	{
+		resultado.bytes += posicion - inicioLinea;
+		if (descartando)
+		{
+			++resultado.malformados;
+		}
+		else
+		{
+			procesar(linea);
+		}
+	}
+}
+
+void ImportadorClientes::_procesarTramo(const string& archivo, streamoff inicio, streamoff fin, vector<Cliente*>& lote,
+	ResultadoImportacion& resultado) const
+{
+	ifstream inFile(archivo, ios::binary);
+	if (!inFile)
+	{
+		return;
+	}
+
+	// Una lnea pertenece al tramo en el que empieza: se lee desde el byte anterior al tramo
+	// y se ignora todo hasta el primer salto de lnea (vaco si el tramo empieza una lnea)
+	streamoff desde = inicio > 0 ? inicio - 1 : 0;
+	inFile.seekg(desde);
+
+	_leerLineas(inFile, fin - desde, inicio > 0, resultado, [&](string& linea) {
+		Cliente* cliente = _parsearLinea(linea, resultado);
+		if (cliente != nullptr)
+		{
+			lote.push_back(cliente);
+		}
+		}, nullptr);
+}
+
+void ImportadorClientes::_contar(const ResultadoImportacion& resultado)
+{
+	static Contador registros("ImportadorClientes.registros");
+	static Contador malformados("ImportadorClientes.malformados");
+	static Contador duplicados("ImportadorClientes.duplicados");
+	static Contador bytes("ImportadorClientes.bytes");
+	registros.sumar(resultado.registros);
+	malformados.sumar(resultado.malformados);
+	duplicados.sumar(resultado.duplicados);
+	bytes.sumar(resultado.bytes);
+}
+
+ResultadoImportacion ImportadorClientes::importar(const string& archivo, MGeneral& registro,
+	const function<void(const ResultadoImportacion&)>& progreso) const
+{
+	static Histograma latencia("ImportadorClientes.importar");
+	Cronometro cronometro(latencia);
+	ZonaMemoria zona(Subsistema::Dominio);
+	ResultadoImportacion resultado;
+	auto inicio = chrono::steady_clock::now();
+
+	ifstream inFile(archivo, ios::binary);
+	if (!inFile)
+	{
+		throw runtime_error("No se pudo abrir el archivo de importacin: " + archivo);
+	}
+
+	_leerLineas(inFile, numeric_limits<streamoff>::max(), false, resultado,
+		[&](string& linea) { _procesarLinea(linea, registro, resultado); },
+		[&]() {
+			if (progreso)
+			{
+				resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+				progreso(resultado);
+			}
+		});
+
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+	_contar(resultado);
+	return resultado;
+}
+
+ResultadoImportacion ImportadorClientes::importarParalelo(const string& archivo, MGeneral& registro, size_t hilos) const
+{
+	static Histograma latencia("ImportadorClientes.importarParalelo");
+	Cronometro cronometro(latencia);
+	ZonaMemoria zona(Subsistema::Dominio);
+	auto inicio = chrono::steady_clock::now();
+
+	ifstream inFile(archivo, ios::binary | ios::ate);
+	if (!inFile)
+	{
+		throw runtime_error("No se pudo abrir el archivo de importacin: " + archivo);
+	}
+	streamoff tamanio = inFile.tellg();
+	inFile.close();
+
+	if (hilos == 0)
+	{
+		hilos = max<size_t>(1, thread::hardware_concurrency());
+	}
+
+	size_t numeroTramos = static_cast<size_t>((tamanio + tamanioBloque - 1) / tamanioBloque);
+	hilos = max<size_t>(1, min(hilos, numeroTramos));
+
+	// Cada hilo toma el siguiente tramo libre hasta agotarlos. El registro no es seguro entre
+	// hilos y debe recibir los lotes en orden: el hilo que termina un tramo lo deja listo y
+	// registra todos los lotes consecutivos que ya estn listos desde 'siguienteRegistro'
+	atomic<size_t> siguienteTramo(0);
+	mutex cerrojoRegistro;
+	vector<vector<Cliente*>> lotes(numeroTramos);  // Protegidos por 'cerrojoRegistro'
+	vector<bool> listos(numeroTramos, false);
+	size_t siguienteRegistro = 0;
+	vector<ResultadoImportacion> parciales(hilos);
+	vector<thread> trabajadores;
+
+	for (size_t h = 0; h < hilos; ++h)
+	{
+		trabajadores.emplace_back([&, h]() {
+			size_t tramo;
+			while ((tramo = siguienteTramo.fetch_add(1)) < numeroTramos)
+			{
+				streamoff desde = static_cast<streamoff>(tramo) * tamanioBloque;
+				streamoff hasta = min<streamoff>(desde + tamanioBloque, tamanio);
+				vector<Cliente*> lote;
+				_procesarTramo(archivo, desde, hasta, lote, parciales[h]);
+
+				lock_guard<mutex> bloqueo(cerrojoRegistro);
+				lotes[tramo] = move(lote);
+				listos[tramo] = true;
+				for (; siguienteRegistro < numeroTramos && listos[siguienteRegistro]; ++siguienteRegistro)
+				{
+					for (Cliente* cliente : lotes[siguienteRegistro])
+					{
+						_registrar(cliente, registro, parciales[h]);
+					}
+					vector<Cliente*>().swap(lotes[siguienteRegistro]);
+				}
+			}
+			});
+	}
+	for (auto& trabajador : trabajadores)
+	{
+		trabajador.join();
+	}
+
+	ResultadoImportacion resultado;
+	for (const auto& parcial : parciales)
+	{
+		resultado.acumular(parcial);
+	}
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+	_contar(resultado);
+	return resultado;
+}
@@ -2,20 +2,197 @@
 
 #include "Fecha.h"
 #include "HashTable.h"
+#include "Cliente.h"
+#include "MotorTransferencias.h"
+#include "ReporteBanco.h"
+#include "ThreadPool.h"
 
-class MGeneral
+// Registro general del banco: dueo de todos los clientes cargados
+class MGeneral : public IDebugable
 {
 private:
+	Fecha fechaActual;
+	HashTable<Cliente*, uint64_t> clientes;  // Clientes registrados indexados por DNI (DNI::getValor)
+	HashTable<Cuenta*, uint64_t> cuentas;    // Cuentas indexadas por nmero (NumeroCuenta::getValor)
+	MotorTransferencias motor;     // Transferencias entre cuentas registradas
+
+	void _indexarCuentas(Cliente& cliente);
 
 public:
+	MGeneral(const Fecha& fechaActual);
 	MGeneral();
 	~MGeneral();
+
+	// El registro es dueo de los punteros, no se puede copiar
+	MGeneral(const MGeneral&) = delete;
+	MGeneral& operator=(const MGeneral&) = delete;
+
+	Fecha getFechaActual() const;
+	size_t getNumeroClientes() const;
+	Cliente* getCliente(const string& dni);
+	size_t getNumeroCuentas() const;
+	Cuenta* getCuenta(const string& numeroCuenta);
+
+	// Registra un cliente y toma posesin del puntero; retorna false si el DNI ya existe
+	bool addCliente(Cliente* cliente);
+	// Aplica una operacin a todos los clientes registrados
+	void apply(const function<void(Cliente&)>& operation);
+	// Copia de los punteros a los clientes registrados (en el orden de la tabla)
+	vector<Cliente*> getClientes();
+	// Transfiere entre dos cuentas registradas; retorna false si alguna no existe o no hay saldo
+	bool transferir(const string& origen, const string& destino, const Monto& monto);
+
+	// Totales de todo el banco; con un ThreadPool cada trozo de 'grano' clientes es una tarea
+	ReporteBanco generarReporte();
+	ReporteBanco generarReporte(ThreadPool& pool, size_t grano = 256);
+
+	string toDebug() const override;
 };
 
+MGeneral::MGeneral(const Fecha& fechaActual)
+	: fechaActual(fechaActual), clientes(1024), cuentas(4096), motor(fechaActual)
+{
+}
+
 MGeneral::MGeneral()
+	: fechaActual(Fecha()), clientes(1024), cuentas(4096), motor(fechaActual)
 {
 }
 
 MGeneral::~MGeneral()
 {
-}
\ No newline at end of file
+	clientes.apply([](Cliente*& cliente) {
+		delete cliente;
+		cliente = nullptr;
+		});
+}
+
+Fecha MGeneral::getFechaActual() const
+{
+	return fechaActual;
+}
+
+size_t MGeneral::getNumeroClientes() const
+{
+	return clientes.size();
+}
+
+Cliente* MGeneral::getCliente(const string& dni)
+{
+	DNI clave;
+	if (!clave.asignar(dni))
+	{
+		return nullptr;
+	}
+	return clientes.contains(clave.getValor()) ? clientes.getElement(clave.getValor()) : nullptr;
+}
+
+size_t MGeneral::getNumeroCuentas() const
+{
+	return cuentas.size();
+}
+
+Cuenta* MGeneral::getCuenta(const string& numeroCuenta)
+{
+	NumeroCuenta clave;
+	if (!clave.asignar(numeroCuenta))
+	{
+		return nullptr;
+	}
+	return cuentas.contains(clave.getValor()) ? cuentas.getElement(clave.getValor()) : nullptr;
+}
+
+// Las cuentas viven en la lista del cliente, que el registro no vuelve a modificar
+void MGeneral::_indexarCuentas(Cliente& cliente)
+{
+	cliente.aplicarCuentas([this](Cuenta& cuenta) {
+		NumeroCuenta numero = cuenta.getNumeroCuentaNumerico();
+		if (!numero.empty() && !cuentas.contains(numero.getValor()))
+		{
+			cuentas.addElement(numero.getValor(), &cuenta);
+		}
+		});
+}
+
+bool MGeneral::addCliente(Cliente* cliente)
+{
+	if (cliente == nullptr)
+	{
+		return false;
+	}
+	ZonaMemoria zona(Subsistema::Dominio);
+
+	DNI dni = cliente->getIdentidad().getDNINumerico();
+	if (dni.empty() || clientes.contains(dni.getValor()))
+	{
+		return false;
+	}
+	clientes.addElement(dni.getValor(), cliente);
+	_indexarCuentas(*cliente);
+	return true;
+}
+
+void MGeneral::apply(const function<void(Cliente&)>& operation)
+{
+	clientes.apply([&operation](Cliente*& cliente) {
+		operation(*cliente);
+		});
+}
+
+vector<Cliente*> MGeneral::getClientes()
+{
+	vector<Cliente*> lista;
+	lista.reserve(clientes.size());
+	clientes.apply([&lista](Cliente*& cliente) {
+		lista.push_back(cliente);
+		});
+	return lista;
+}
+
+ReporteBanco MGeneral::generarReporte()
+{
+	ReporteBanco reporte;
+	apply([&reporte](Cliente& cliente) {
+		reporte.agregarCliente(cliente);
+		});
+	return reporte;
+}
+
+ReporteBanco MGeneral::generarReporte(ThreadPool& pool, size_t grano)
+{
+	vector<Cliente*> lista = getClientes();
+	return pool.parallelReduce<ReporteBanco>(0, lista.size(), grano, ReporteBanco(),
+		[&lista](size_t desde, size_t hasta) {
+			ReporteBanco parcial;
+			for (size_t i = desde; i < hasta; ++i)
+			{
+				parcial.agregarCliente(*lista[i]);
+			}
+			return parcial;
+		},
+		[](const ReporteBanco& a, const ReporteBanco& b) {
+			ReporteBanco suma = a;
+			suma.combinar(b);
+			return suma;
+		});
+}
+
+bool MGeneral::transferir(const string& origen, const string& destino, const Monto& monto)
+{
+	Cuenta* cuentaOrigen = getCuenta(origen);
+	Cuenta* cuentaDestino = getCuenta(destino);
+	if (cuentaOrigen == nullptr || cuentaDestino == nullptr)
+	{
+		return false;
+	}
+	return motor.transferir(*cuentaOrigen, *cuentaDestino, monto);
+}
+
+string MGeneral::toDebug() const
+{
+	ostringstream out;
+	out << "MGeneral(fechaActual=" << fechaActual.toStringDDMMAAAA()
+		<< ", clientes=" << clientes.size()
+		<< ", cuentas=" << cuentas.size() << ")";
+	return out.str();
+}
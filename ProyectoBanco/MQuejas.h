@@ -3,154 +3,617 @@
 #include "IFileable.h"
 #include "IInteractive.h"
 #include "SStack.h"
+#include "ConcurrentStack.h"
 #include "AVLTree.h"
 #include "Queja.h"
+#include "Metricas.h"
+#include "Memoria.h"
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
 
 enum class TipoUsuario { Cliente, Administrador, Desconocido };
 
+// Archivos de persistencia de las quejas. Cada Cliente, UCliente y Administrador tiene su propio
+// MQuejas, pero todos comparten los mismos dos archivos: este objeto, nico en el proceso, es el
+// dueo del ndice en memoria y de su cerrojo, as una compactacin conserva las quejas guardadas
+// por cualquiera y actualiza sus posiciones. Cada queja guardada se identifica con un nmero que
+// no cambia al compactar. El ndice del disco se lee una sola vez, en el primer uso.
+class ArchivoQuejas
+{
+public:
+    // Registro de solo-anexado: una queja por lnea, nunca se reescribe al registrar
+    static constexpr char DATOS[] = "Quejas.txt";
+    // ndice de posiciones: "+pos" al registrar una queja, "-pos" (lpida) al resolverla
+    static constexpr char INDICE[] = "Quejas.idx";
+    // La compactacin escribe primero aqu y luego los renombra sobre los originales
+    static constexpr char DATOS_TEMPORAL[] = "Quejas.txt.tmp";
+    static constexpr char INDICE_TEMPORAL[] = "Quejas.idx.tmp";
+    // Nmero mnimo de lpidas acumuladas antes de compactar los archivos
+    static constexpr size_t UMBRAL_COMPACTACION = 64;
+
+private:
+    mutex m;                                     // Protege los archivos y todo lo de abajo
+    bool abierto;                                // Ya se ley el ndice del disco
+    size_t siguienteNumero;                      // Nmero de la prxima queja guardada
+    unordered_map<size_t, streamoff> posiciones; // Posicin en DATOS de cada queja guardada vigente
+    size_t lapidas;                              // Lpidas en el ndice desde la ltima compactacin
+
+    ArchivoQuejas();
+
+    // Todo lo siguiente requiere 'm'
+    void _abrir();
+    // Termina o descarta una compactacin que se interrumpi entre un renombre y el otro
+    void _recuperar();
+    // "+pos" o "-pos" con 'pos' al inicio de una lnea de 'inFile'
+    bool _leerEntrada(const string& entrada, ifstream& inFile, streamoff tamanio, streamoff& posicion);
+    bool _compactar();
+
+    static bool _existe(const char* archivo);
+    static bool _reemplazar(const char* temporal, const char* destino);
+
+public:
+    ArchivoQuejas(const ArchivoQuejas&) = delete;
+    ArchivoQuejas& operator=(const ArchivoQuejas&) = delete;
+
+    static ArchivoQuejas& global();
+
+    // Anexa la queja al final de DATOS; retorna su nmero, o 0 si no se pudo escribir
+    size_t anexar(const Queja& queja);
+    // Escribe la lpida de la queja y compacta si ya hay demasiadas; retorna false solo si no se
+    // pudo escribir (si la queja ya no estaba guardada no hace nada)
+    bool resolver(size_t numero);
+    // Reescribe los archivos solo con las quejas guardadas vigentes
+    bool compactar();
+    // Nmero y lnea de cada queja guardada vigente, en el orden en que se guardaron; retorna
+    // false si DATOS no existe
+    bool leerVigentes(vector<pair<size_t, string>>& vigentes);
+};
+
+// Queja vigente junto con el identificador con el que se ubica su posicin en el archivo
+struct EntradaQueja
+{
+    Queja queja;
+    size_t id = 0;
+};
+
+// Las quejas viven en una ConcurrentStack: clientes y administradores pueden registrar y
+// resolver quejas desde varios hilos sin bloquearse. La escritura en los archivos se serializa
+// en ArchivoQuejas, compartido por todas las instancias.
 class MQuejas : public IDebugable, IFileable, IRandomizable, IInteractive
 {
 private:
     Fecha fechaActual;
     TipoUsuario tipo;
-    SStack<Queja*> quejas;  // Cambiar de SStack<Queja> a SStack<Queja*>
+    ConcurrentStack<EntradaQueja> quejas;
+    atomic<size_t> siguienteId;                          // Identificador de la prxima queja
+    mutable mutex mGuardadas;                            // Protege 'guardadas'
+    mutable unordered_map<size_t, size_t> guardadas;     // Nmero en ArchivoQuejas de cada queja guardada
 
     bool _addQueja(const string& cliente, const string& descripcion);
-    bool _removeQueja();
-    void _showQuejas();
-    void _interactQuejarse();
-    void _interactResolver();
+    // Resuelve la queja de la cima solo si sigue siendo la queja 'id'
+    bool _removeQueja(size_t id);
+    void _clearQuejas();
+    void _pushQuejas(const vector<Queja>& quejas);
+    void _showQuejas(ostream& out);
+    Tarea _interactQuejarse(Sesion& sesion);
+    Tarea _interactResolver(Sesion& sesion);
 
 public:
     MQuejas(const Fecha& fechaActual, const TipoUsuario& tipo);
-    ~MQuejas();  // Destructor para liberar memoria
 
     Fecha getFechaActual() const;
     TipoUsuario getTipo() const;
-    SStack<Queja*> getQuejas() const;
+    // Copia de las quejas vigentes con la ms reciente en la cima
+    SStack<Queja> getQuejas() const;
 
     bool setFechaActual(const Fecha& fechaActual);
     bool setTipo(const TipoUsuario& tipo);
-    bool setQuejas(const SStack<Queja*>& quejas);
+    bool setQuejas(const SStack<Queja>& quejas);
+
+    // Registra y guarda una queja sin pasar por el men; seguro entre hilos
+    bool registrarQueja(const string& cliente, const string& descripcion);
 
     string toDebug() const override;
     bool saveToFile() const override;
     bool loadFromFile() override;
-    void generateRandom() override;
-    void interact() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
+    Tarea interactuar(Sesion& sesion) override;
+    using IInteractive::interact;
 };
 
+ArchivoQuejas::ArchivoQuejas()
+    : abierto(false), siguienteNumero(0), lapidas(0)
+{}
+
+ArchivoQuejas& ArchivoQuejas::global()
+{
+    static ArchivoQuejas archivo;
+    return archivo;
+}
+
+bool ArchivoQuejas::_existe(const char* archivo)
+{
+    return ifstream(archivo, ios::binary).is_open();
+}
+
+// rename no reemplaza un archivo existente en todas las plataformas: entonces se borra el
+// destino antes; si se interrumpe ah, _recuperar encuentra el temporal completo y lo usa
+bool ArchivoQuejas::_reemplazar(const char* temporal, const char* destino)
+{
+    if (rename(temporal, destino) == 0)
+    {
+        return true;
+    }
+    remove(destino);
+    return rename(temporal, destino) == 0;
+}
+
+void ArchivoQuejas::_recuperar()
+{
+    // Los temporales se renombran solo despus de escribirlos completos: si DATOS todava
+    // existe junto a su temporal, la compactacin no reemplaz nada y se descarta
+    if (_existe(DATOS_TEMPORAL))
+    {
+        if (_existe(DATOS))
+        {
+            remove(DATOS_TEMPORAL);
+            remove(INDICE_TEMPORAL);
+            return;
+        }
+        _reemplazar(DATOS_TEMPORAL, DATOS);
+    }
+    if (_existe(INDICE_TEMPORAL))
+    {
+        _reemplazar(INDICE_TEMPORAL, INDICE);
+    }
+}
+
+bool ArchivoQuejas::_leerEntrada(const string& entrada, ifstream& inFile, streamoff tamanio, streamoff& posicion)
+{
+    if (entrada.size() < 2 || (entrada[0] != '+' && entrada[0] != '-'))
+    {
+        return false;
+    }
+    long long valor = -1;
+    const char* fin = entrada.data() + entrada.size();
+    auto [ultimo, error] = from_chars(entrada.data() + 1, fin, valor);
+    if (error != errc() || ultimo != fin || valor < 0 || valor >= tamanio)
+    {
+        return false;
+    }
+    if (valor > 0)
+    {
+        inFile.seekg(valor - 1);
+        if (inFile.get() != '\n')
+        {
+            inFile.clear();
+            return false;
+        }
+    }
+    posicion = valor;
+    return true;
+}
+
+void ArchivoQuejas::_abrir()
+{
+    if (abierto)
+    {
+        return;
+    }
+    abierto = true;
+    _recuperar();
+
+    ifstream inFile(ArchivoQuejas::DATOS, ios::binary);
+    if (!inFile)
+    {
+        return; // Todava no hay quejas guardadas
+    }
+    inFile.seekg(0, ios::end);
+    streamoff tamanio = inFile.tellg();
+    inFile.seekg(0);
+
+    vector<streamoff> vigentes;
+    ifstream inIndice(ArchivoQuejas::INDICE, ios::binary);
+    if (inIndice)
+    {
+        // Reconstruir las quejas vigentes a partir del ndice; una entrada daada o truncada se
+        // ignora en lugar de perder todo el ndice
+        vector<streamoff> resueltas;
+        size_t invalidas = 0;
+        string entrada;
+        while (getline(inIndice, entrada))
+        {
+            if (!entrada.empty() && entrada.back() == '\r')
+            {
+                entrada.pop_back();
+            }
+            streamoff posicion = -1;
+            if (entrada.empty())
+            {
+                continue;
+            }
+            if (!_leerEntrada(entrada, inFile, tamanio, posicion))
+            {
+                ++invalidas;
+                continue;
+            }
+            (entrada[0] == '+' ? vigentes : resueltas).push_back(posicion);
+        }
+        if (invalidas > 0)
+        {
+            cerr << "Se ignoraron " << invalidas << " entradas invalidas del indice de quejas.\n";
+        }
+        lapidas = resueltas.size();
+
+        sort(vigentes.begin(), vigentes.end());
+        vigentes.erase(unique(vigentes.begin(), vigentes.end()), vigentes.end());
+        sort(resueltas.begin(), resueltas.end());
+        vigentes.erase(remove_if(vigentes.begin(), vigentes.end(), [&resueltas](streamoff posicion) {
+            return binary_search(resueltas.begin(), resueltas.end(), posicion);
+            }), vigentes.end());
+    }
+    else
+    {
+        // Archivo sin ndice (formato anterior): recorrerlo una vez y generar el ndice
+        ofstream outIndice(ArchivoQuejas::INDICE, ios::binary | ios::trunc);
+        string line;
+        streamoff posicion = inFile.tellg();
+        while (getline(inFile, line))
+        {
+            if (!line.empty() && line != "\r")
+            {
+                vigentes.push_back(posicion);
+                outIndice << '+' << posicion << '\n';
+            }
+            posicion = inFile.tellg();
+        }
+    }
+
+    for (streamoff posicion : vigentes)
+    {
+        posiciones[++siguienteNumero] = posicion;
+    }
+}
+
+size_t ArchivoQuejas::anexar(const Queja& queja)
+{
+    static Histograma latencia("ArchivoQuejas.anexar");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Serializacion);
+    lock_guard<mutex> bloqueo(m);
+    _abrir();
+
+    ofstream outFile(ArchivoQuejas::DATOS, ios::binary | ios::app);
+    ofstream outIndice(ArchivoQuejas::INDICE, ios::binary | ios::app);
+    if (!outFile || !outIndice)
+    {
+        cerr << "Error al abrir el archivo para guardar las quejas.\n";
+        return 0;
+    }
+
+    // La queja se escribe al final; su posicin es el tamao actual del archivo
+    outFile.seekp(0, ios::end);
+    streamoff posicion = outFile.tellp();
+    outFile << queja.toSave() << '\n';
+    outIndice << '+' << posicion << '\n';
+    if (!outFile.good() || !outIndice.good())
+    {
+        return 0;
+    }
+
+    posiciones[++siguienteNumero] = posicion;
+    return siguienteNumero;
+}
+
+bool ArchivoQuejas::resolver(size_t numero)
+{
+    lock_guard<mutex> bloqueo(m);
+    _abrir();
+
+    auto guardada = posiciones.find(numero);
+    if (guardada == posiciones.end())
+    {
+        return true;
+    }
+    ofstream outIndice(ArchivoQuejas::INDICE, ios::binary | ios::app);
+    if (!outIndice)
+    {
+        cerr << "Error al abrir el indice de quejas.\n";
+        return false;
+    }
+    outIndice << '-' << guardada->second << '\n';
+    if (!outIndice.good())
+    {
+        return false;
+    }
+    outIndice.close();
+    posiciones.erase(guardada);
+    ++lapidas;
+
+    // Compactar cuando las lpidas superan a las quejas vigentes
+    if (lapidas >= UMBRAL_COMPACTACION && lapidas >= posiciones.size())
+    {
+        _compactar();
+    }
+    return true;
+}
+
+bool ArchivoQuejas::compactar()
+{
+    lock_guard<mutex> bloqueo(m);
+    _abrir();
+    return _compactar();
+}
+
+bool ArchivoQuejas::_compactar()
+{
+    static Histograma latencia("ArchivoQuejas.compactar");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Serializacion);
+    // Leer las quejas vigentes en el orden en que fueron guardadas
+    vector<pair<streamoff, size_t>> vigentes;
+    for (const auto& guardada : posiciones)
+    {
+        vigentes.emplace_back(guardada.second, guardada.first);
+    }
+    sort(vigentes.begin(), vigentes.end());
+
+    vector<string> lineas;
+    {
+        ifstream inFile(ArchivoQuejas::DATOS, ios::binary);
+        if (!inFile)
+        {
+            return posiciones.empty();
+        }
+        string line;
+        for (const auto& vigente : vigentes)
+        {
+            inFile.seekg(vigente.first);
+            if (!getline(inFile, line))
+            {
+                return false;
+            }
+            lineas.push_back(line);
+        }
+    }
+
+    // Los originales no se tocan hasta tener los temporales completos: si algo falla antes,
+    // las quejas siguen intactas en ellos
+    vector<streamoff> nuevas;
+    {
+        ofstream outFile(ArchivoQuejas::DATOS_TEMPORAL, ios::binary | ios::trunc);
+        ofstream outIndice(ArchivoQuejas::INDICE_TEMPORAL, ios::binary | ios::trunc);
+        for (size_t i = 0; outFile && outIndice && i < vigentes.size(); ++i)
+        {
+            nuevas.push_back(outFile.tellp());
+            outFile << lineas[i] << '\n';
+            outIndice << '+' << nuevas.back() << '\n';
+        }
+        outFile.close();
+        outIndice.close();
+        if (!outFile || !outIndice)
+        {
+            cerr << "Error al escribir los archivos temporales de quejas.\n";
+            remove(ArchivoQuejas::DATOS_TEMPORAL);
+            remove(ArchivoQuejas::INDICE_TEMPORAL);
+            return false;
+        }
+    }
+
+    if (!_reemplazar(ArchivoQuejas::DATOS_TEMPORAL, ArchivoQuejas::DATOS))
+    {
+        cerr << "Error al reemplazar el archivo de quejas.\n";
+        return false;
+    }
+    // Desde aqu DATOS es el nuevo: las posiciones cambian aunque falle el ndice, que entonces
+    // queda en su temporal para que _recuperar lo instale
+    for (size_t i = 0; i < vigentes.size(); ++i)
+    {
+        posiciones[vigentes[i].second] = nuevas[i];
+    }
+    lapidas = 0;
+    if (!_reemplazar(ArchivoQuejas::INDICE_TEMPORAL, ArchivoQuejas::INDICE))
+    {
+        cerr << "Error al reemplazar el indice de quejas.\n";
+        return false;
+    }
+    return true;
+}
+
+bool ArchivoQuejas::leerVigentes(vector<pair<size_t, string>>& vigentes)
+{
+    lock_guard<mutex> bloqueo(m);
+    _abrir();
+    ifstream inFile(ArchivoQuejas::DATOS, ios::binary);
+    if (!inFile)
+    {
+        return false;
+    }
+
+    vector<pair<streamoff, size_t>> orden;
+    for (const auto& guardada : posiciones)
+    {
+        orden.emplace_back(guardada.second, guardada.first);
+    }
+    sort(orden.begin(), orden.end());
+
+    string line;
+    for (const auto& guardada : orden)
+    {
+        inFile.seekg(guardada.first);
+        if (!getline(inFile, line))
+        {
+            inFile.clear();
+            continue;
+        }
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        vigentes.emplace_back(guardada.second, line);
+    }
+    return true;
+}
+
 bool MQuejas::_addQueja(const string& cliente, const string& descripcion)
 {
+    ZonaMemoria zona(Subsistema::Quejas);
     if (cliente.empty() || descripcion.empty())
     {
         return false;
     }
-    quejas.push(new Queja(fechaActual, cliente, descripcion));  // Asignar dinmicamente
+    EntradaQueja entrada{ Queja(fechaActual, cliente, descripcion), ++siguienteId };
+
+    // Persistir solo la nueva queja al final del archivo, sin reescribirlo
+    {
+        lock_guard<mutex> bloqueo(mGuardadas);
+        size_t guardada = ArchivoQuejas::global().anexar(entrada.queja);
+        if (guardada == 0)
+        {
+            return false;
+        }
+        guardadas[entrada.id] = guardada;
+    }
+
+    quejas.push(entrada);
     return true;
 }
 
-bool MQuejas::_removeQueja()
+bool MQuejas::_removeQueja(size_t id)
 {
-    if (quejas.empty())
+    // Otro administrador pudo resolverla, o un cliente agregar una queja encima, desde que se mostr
+    EntradaQueja resuelta;
+    if (!quejas.tryPopIf(resuelta, [id](const EntradaQueja& entrada) { return entrada.id == id; }))
     {
         return false;
     }
-    delete quejas.top();  // Liberar la memoria de la queja
-    quejas.pop();
+
+    lock_guard<mutex> bloqueo(mGuardadas);
+
+    // Marcar la queja como resuelta en el ndice si ya estaba guardada
+    auto guardada = guardadas.find(id);
+    if (guardada != guardadas.end())
+    {
+        if (!ArchivoQuejas::global().resolver(guardada->second))
+        {
+            quejas.push(resuelta); // Sigue vigente en el archivo: devolverla a la pila
+            return false;
+        }
+        guardadas.erase(guardada);
+    }
     return true;
 }
 
-void MQuejas::_showQuejas()
+void MQuejas::_clearQuejas()
 {
-    for (const auto& queja : quejas) {
-        cout << queja->toShow() << '\n';
+    quejas.clear();
+    lock_guard<mutex> bloqueo(mGuardadas);
+    guardadas.clear();
+}
+
+// Agrega las quejas (de la ms antigua a la ms reciente) sin posicin en el archivo
+void MQuejas::_pushQuejas(const vector<Queja>& quejas)
+{
+    ZonaMemoria zona(Subsistema::Quejas);
+    for (const Queja& queja : quejas)
+    {
+        this->quejas.push({ queja, ++siguienteId });
     }
 }
 
-void MQuejas::_interactQuejarse()
+void MQuejas::_showQuejas(ostream& out)
 {
-    string cliente;
-    string descripcion;
+    quejas.forEach([&out](const EntradaQueja& entrada) {
+        out << entrada.queja.toShow() << '\n';
+        });
+}
+
+Tarea MQuejas::_interactQuejarse(Sesion& sesion)
+{
+    ostream& out = sesion.out();
 
     // Solicitar nombre del cliente
-    cout << "Ingrese su primer apellido y su primer nombre (maximo 100 caracteres): ";
-    getline(cin, cliente);
+    out << "Ingrese su primer apellido y su primer nombre (maximo 100 caracteres): ";
+    string cliente = (co_await sesion.leerLinea()).value_or("");
 
     // Validar entrada del cliente
     if (cliente.empty() || cliente.size() > 100) {
-        cout << "El nombre no debe estar vacio ni exceder los 100 caracteres. Intente nuevamente.\n";
-        return;
+        out << "El nombre no debe estar vacio ni exceder los 100 caracteres. Intente nuevamente.\n";
+        co_return;
     }
 
     // Solicitar descripcion de la queja
-    cout << "Ingrese su queja (maximo 300 caracteres): ";
-    getline(cin, descripcion);
+    out << "Ingrese su queja (maximo 300 caracteres): ";
+    string descripcion = (co_await sesion.leerLinea()).value_or("");
 
     // Validar entrada de la descripcion
     if (descripcion.empty() || descripcion.size() > 300) {
-        cout << "La queja no debe estar vacia ni exceder los 300 caracteres. Intente nuevamente.\n";
-        return;
+        out << "La queja no debe estar vacia ni exceder los 300 caracteres. Intente nuevamente.\n";
+        co_return;
     }
 
     // Intentar registrar la queja
     if (_addQueja(cliente, descripcion)) {
-        cout << "Queja registrada exitosamente.\n";
+        out << "Queja registrada exitosamente.\n";
     }
     else {
-        cout << "No se pudo registrar la queja. Por favor intente nuevamente.\n";
+        out << "No se pudo registrar la queja. Por favor intente nuevamente.\n";
     }
 }
 
-void MQuejas::_interactResolver()
+Tarea MQuejas::_interactResolver(Sesion& sesion)
 {
+    ostream& out = sesion.out();
+
     // Verificar si hay quejas pendientes
-    if (quejas.empty())
+    EntradaQueja actual;
+    if (!quejas.top(actual))
     {
-        cout << "No hay quejas pendientes para resolver.\n";
-        return;
+        out << "No hay quejas pendientes para resolver.\n";
+        co_return;
     }
 
     // Mostrar la queja ms reciente
-    cout << "Queja actual para resolver:\n";
-    cout << quejas.top()->toShow() << "\n";
+    out << "Queja actual para resolver:\n";
+    out << actual.queja.toShow() << "\n";
 
     // Confirmar resolucin
-    cout << "Desea resolver esta queja? (S/N): ";
-    char opcion;
-    cin >> opcion;
+    out << "Desea resolver esta queja? (S/N): ";
+    optional<string> linea = co_await sesion.leerLinea();
+    char opcion = 'N';
+    if (linea)
+    {
+        Sesion::convertir(*linea, opcion);
+    }
 
     // Validar la entrada
     if (opcion == 'S' || opcion == 's')
     {
-        if (_removeQueja())
+        if (_removeQueja(actual.id))
         {
-            cout << "La queja ha sido resuelta exitosamente.\n";
+            out << "La queja ha sido resuelta exitosamente.\n";
         }
         else
         {
-            cout << "No se pudo resolver la queja. Intente nuevamente.\n";
+            out << "No se pudo resolver la queja (pudo cambiar mientras tanto). Intente nuevamente.\n";
         }
     }
     else
     {
-        cout << "La queja no fue resuelta.\n";
+        out << "La queja no fue resuelta.\n";
     }
 }
 
 MQuejas::MQuejas(const Fecha& fechaActual, const TipoUsuario& tipo)
-    : fechaActual(fechaActual), tipo(tipo)
+    : fechaActual(fechaActual), tipo(tipo), siguienteId(0)
 {}
 
-MQuejas::~MQuejas()
-{
-    // Liberar la memoria de las quejas
-    while (!quejas.empty()) {
-        delete quejas.top();  // Liberar cada puntero
-        quejas.pop();
-    }
-}
-
 Fecha MQuejas::getFechaActual() const
 {
     return fechaActual;
@@ -161,9 +624,18 @@ TipoUsuario MQuejas::getTipo() const
     return tipo;
 }
 
-SStack<Queja*> MQuejas::getQuejas() const
+SStack<Queja> MQuejas::getQuejas() const
 {
-    return quejas;
+    // forEach recorre desde la cima: se apilan en orden inverso para conservarla
+    vector<Queja> copia;
+    quejas.forEach([&copia](const EntradaQueja& entrada) { copia.push_back(entrada.queja); });
+
+    SStack<Queja> resultado;
+    for (auto it = copia.rbegin(); it != copia.rend(); ++it)
+    {
+        resultado.push(*it);
+    }
+    return resultado;
 }
 
 bool MQuejas::setFechaActual(const Fecha& fechaActual)
@@ -182,111 +654,126 @@ bool MQuejas::setTipo(const TipoUsuario& tipo)
     return true; // xito
 }
 
-bool MQuejas::setQuejas(const SStack<Queja*>& quejas)
+bool MQuejas::setQuejas(const SStack<Queja>& quejas)
 {
-    this->quejas = quejas;
+    _clearQuejas();
+
+    // Las quejas asignadas no tienen posicin conocida en el archivo
+    vector<Queja> copia;
+    for (const auto& queja : quejas) {
+        copia.push_back(queja);
+    }
+    reverse(copia.begin(), copia.end());
+    _pushQuejas(copia);
     return true;
 }
 
+bool MQuejas::registrarQueja(const string& cliente, const string& descripcion)
+{
+    return _addQueja(cliente, descripcion);
+}
+
 string MQuejas::toDebug() const
 {
     ostringstream out;
     out << "MQuejas(tipo=" << (tipo == TipoUsuario::Administrador ? "Administrador" : "Cliente");
     out << ", fechaActual=" << fechaActual.toStringDDMMAAAA()
         << ", historial=";
-    for (const auto& queja : quejas) {
-        out << queja->toDebug() << ", ";
-    }
+    quejas.forEach([&out](const EntradaQueja& entrada) {
+        out << entrada.queja.toDebug() << ", ";
+        });
     string outStr = out.str();
     outStr.pop_back(); outStr.pop_back();
     outStr += ')';
     return outStr;
 }
 
+// Guarda las quejas que an no estaban en el archivo y lo compacta
 bool MQuejas::saveToFile() const
 {
-    if (quejas.empty())
+    static Histograma latencia("MQuejas.saveToFile");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Serializacion);
+    // Se guardan de la ms antigua a la ms reciente
+    vector<EntradaQueja> vigentes;
+    quejas.forEach([&vigentes](const EntradaQueja& entrada) { vigentes.push_back(entrada); });
+    reverse(vigentes.begin(), vigentes.end());
+
+    lock_guard<mutex> bloqueo(mGuardadas);
+    for (const auto& entrada : vigentes)
     {
-        cout << "No hay quejas para guardar.\n";
-        return false;
-    }
-
-    ofstream outFile("Quejas.txt");
-    if (!outFile)
-    {
-        cerr << "Error al abrir el archivo para guardar las quejas.\n";
-        return false;
-    }
-
-    SStack<Queja*> tempStack(quejas);
-    tempStack.invert();
-    for (const auto& queja : tempStack) {
-        outFile << queja->toSave() << '\n';
+        // Una queja resuelta despus de copiarla recibe su lpida al tomar 'mGuardadas'
+        if (guardadas.find(entrada.id) == guardadas.end())
+        {
+            size_t guardada = ArchivoQuejas::global().anexar(entrada.queja);
+            if (guardada == 0)
+            {
+                return false;
+            }
+            guardadas[entrada.id] = guardada;
+        }
     }
-
-    outFile.close();  // Asegrate de cerrar el archivo
-    return true;      // Retornar true al finalizar exitosamente
+    return ArchivoQuejas::global().compactar();
 }
 
 bool MQuejas::loadFromFile()
 {
-    ifstream inFile("Quejas.txt");
-    if (!inFile)
+    static Histograma latencia("MQuejas.loadFromFile");
+    Cronometro cronometro(latencia);
+    ZonaMemoria zona(Subsistema::Quejas);
+    vector<pair<size_t, string>> vigentes;
+    if (!ArchivoQuejas::global().leerVigentes(vigentes))
     {
         return false;
     }
 
-    quejas.clear(); // Limpiar el stack antes de cargar nuevas quejas
-
-    string line;
-    while (getline(inFile, line))
+    _clearQuejas(); // Limpiar el stack antes de cargar nuevas quejas
+    lock_guard<mutex> bloqueo(mGuardadas);
+    for (const auto& [guardada, linea] : vigentes)
     {
-        if (line.empty())
-        {
-            continue;
-        }
-
-        Queja* nuevaQueja = new Queja();  // Crear un nuevo puntero para la queja
-        nuevaQueja->load(line);  // Mtodo de carga para procesar cada lnea
-        quejas.push(nuevaQueja);  // Aadir la queja al stack
+        EntradaQueja entrada{ Queja(), ++siguienteId };
+        entrada.queja.load(linea);  // Mtodo de carga para procesar cada lnea
+        guardadas[entrada.id] = guardada;
+        quejas.push(entrada);  // Aadir la queja al stack
     }
-
     return true;
 }
 
-void MQuejas::generateRandom()
+void MQuejas::generateRandom(Aleatorio& aleatorio)
 {
-    auto compare = [](Queja* a, Queja* b) {
-        return a->getFecha().toStringAAAAMMDD() > b->getFecha().toStringAAAAMMDD();
+    auto compare = [](Queja a, Queja b) {
+        return a.getFecha().toStringAAAAMMDD() > b.getFecha().toStringAAAAMMDD();
         };
 
-    AVLTree<Queja*> randomQuejas(compare);
+    AVLTree<Queja> randomQuejas(compare);
 
     // Nmero aleatorio de quejas a generar (por ejemplo entre 1 y 15 quejas)
-    size_t numQuejas = 1 + rand() % 15;
+    size_t numQuejas = 1 + aleatorio.entero(15);
 
     for (size_t i = 0; i < numQuejas; ++i)
     {
-        Queja* q = new Queja();
-        q->generateRandom();  // Genera una queja aleatoria
+        Queja q;
+        q.generateRandom(aleatorio);  // Genera una queja aleatoria
         randomQuejas.insert(q);
     }
 
-    // Transferir las quejas ordenadas desde el rbol AVL
+    // Transferir las quejas ordenadas desde el rbol AVL; las generadas no estn guardadas
+    vector<Queja> ordenadas;
     while (!randomQuejas.empty()) {
-        quejas.push(randomQuejas.getBack());  // Obtener el ltimo elemento (ms antiguo)
-        randomQuejas.popBack();                  // Eliminar el ltimo elemento del rbol
+        ordenadas.push_back(randomQuejas.getBack());  // Obtener el ltimo elemento (ms antiguo)
+        randomQuejas.popBack();                       // Eliminar el ltimo elemento del rbol
     }
+    _pushQuejas(ordenadas);
 }
 
-void MQuejas::interact()
+Tarea MQuejas::interactuar(Sesion& sesion)
 {
     if (tipo == TipoUsuario::Cliente)
     {
-        _interactQuejarse();  // El cliente podr presentar una queja
+        co_await _interactQuejarse(sesion);  // El cliente podr presentar una queja
     }
     else
     {
-        _interactResolver();  // El administrador podr gestionar/resolver las quejas
+        co_await _interactResolver(sesion);  // El administrador podr gestionar/resolver las quejas
     }
 }
@@ -0,0 +1,337 @@
+#pragma once
+
+#include "IDebugable.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Subsistemas a los que se atribuye la memoria reservada (ver ZonaMemoria)
+enum class Subsistema : uint8_t
+{
+	General,        // Fuera de toda zona
+	Contenedores,   // Nodos y tablas de SList, SQueue, SStack, AVLTree y HashTable
+	Serializacion,  // Cadenas de toSave y bferes de lectura y escritura de archivos
+	Dominio,        // Clientes, cuentas, tarjetas y los ndices del registro
+	Historiales,    // Transacciones de las cuentas e historial columnar
+	Quejas,         // Pilas de quejas y su archivo
+	Identidades,    // Cadenas de Identidad y Contacto
+	Cadenas,        // Pool de cadenas internadas (ver PoolCadenas.h)
+	Cantidad
+};
+
+// Uso de memoria de un subsistema desde el inicio del proceso
+struct UsoMemoria : public IDebugable
+{
+	Subsistema subsistema = Subsistema::General;
+	uint64_t asignaciones = 0;
+	uint64_t liberaciones = 0;
+	uint64_t bytesAsignados = 0;
+	uint64_t bytesLiberados = 0;
+
+	uint64_t bloquesVivos() const;
+	uint64_t bytesVivos() const;
+
+	string toDebug() const override;
+};
+
+// Contabilidad de memoria por subsistema. Solo registra algo si el ejecutable reemplaza
+// operator new/delete para que llamen a reservar/liberar con MEMORIA_REEMPLAZAR_OPERADORES()
+// (lo hacen Source.cpp y Benchmarks.cpp).
+//
+// Cada bloque lleva delante una cabecera con su tamao y el subsistema de la zona en que se
+// reserv, as al liberarlo se descuenta del subsistema correcto aunque se libere en otra zona
+// u otro hilo. Los contadores estn repartidos en ranuras por hilo para no compartir la misma
+// lnea de cach entre hilos que reservan a la vez; se suman al consultarlos.
+class Memoria
+{
+public:
+	static constexpr size_t SUBSISTEMAS = static_cast<size_t>(Subsistema::Cantidad);
+
+private:
+	enum Campo { Asignaciones, Liberaciones, BytesAsignados, BytesLiberados, Campos };
+
+	static constexpr size_t RANURAS = 64;
+	static constexpr size_t CABECERA = 16;  // Tamao y subsistema; conserva la alineacin de malloc
+
+	struct alignas(64) Ranura
+	{
+		atomic<uint64_t> valores[SUBSISTEMAS][Campos];
+	};
+
+	// Sin constructores dinmicos: operator new puede llamarse antes de main y durante la salida
+	inline static Ranura ranuras[RANURAS];
+	inline static atomic<size_t> siguienteRanura{ 0 };
+	inline static atomic<bool> activa{ false };
+	inline static thread_local size_t ranura = RANURAS;  // RANURAS = sin asignar todava
+	inline static thread_local Subsistema zona = Subsistema::General;
+
+	static Ranura& _ranura();
+
+	friend class ZonaMemoria;
+
+public:
+	// Para los operator new/delete reemplazados; reservar retorna nullptr si no hay memoria
+	static void* reservar(size_t tamanio) noexcept;
+	static void liberar(void* memoria) noexcept;
+
+	// true si alguna reserva pas por reservar (el ejecutable reemplaz operator new)
+	static bool getActiva();
+	// Subsistema al que se atribuyen las reservas del hilo actual
+	static Subsistema getZona();
+
+	static UsoMemoria getUso(Subsistema subsistema);
+	static vector<UsoMemoria> getUsos();
+	static UsoMemoria getTotal();
+
+	// Tabla de los subsistemas ordenada por bytes vivos, con los totales al final
+	static string volcar();
+	// Lo mismo en una sola lnea: "subsistema=bytesVivos/bloquesVivos/asignaciones" separados por espacios
+	static string volcarLinea();
+
+	static string toString(Subsistema subsistema);
+};
+
+// Define en el ejecutable que lo usa (una sola vez, fuera de toda funcin) los operator
+// new/delete reemplazados. La versin nothrow tambin se reemplaza: lo que reserva (por ejemplo,
+// el bfer temporal de stable_sort) se libera con el operator delete con tamao.
+#define MEMORIA_REEMPLAZAR_OPERADORES() \
+	void* operator new(size_t tamanio) \
+	{ \
+		if (void* memoria = Memoria::reservar(tamanio == 0 ? 1 : tamanio)) \
+		{ \
+			return memoria; \
+		} \
+		throw bad_alloc(); \
+	} \
+	void* operator new(size_t tamanio, const nothrow_t&) noexcept \
+	{ \
+		return Memoria::reservar(tamanio == 0 ? 1 : tamanio); \
+	} \
+	void operator delete(void* memoria) noexcept \
+	{ \
+		Memoria::liberar(memoria); \
+	} \
+	void operator delete(void* memoria, const nothrow_t&) noexcept \
+	{ \
+		Memoria::liberar(memoria); \
+	} \
+	void operator delete(void* memoria, size_t) noexcept \
+	{ \
+		Memoria::liberar(memoria); \
+	}
+
+// Atribuye al subsistema las reservas del hilo actual mientras viva el objeto. Las zonas se
+// anidan: manda la ms interna, salvo las de 'reemplazar' = false, que solo se aplican fuera
+// de toda zona (las usan los contenedores para no quitarle la memoria a quien los usa)
+class ZonaMemoria
+{
+private:
+	Subsistema anterior;
+
+public:
+	explicit ZonaMemoria(Subsistema subsistema, bool reemplazar = true);
+	~ZonaMemoria();
+
+	ZonaMemoria(const ZonaMemoria&) = delete;
+	ZonaMemoria& operator=(const ZonaMemoria&) = delete;
+};
+
+uint64_t UsoMemoria::bloquesVivos() const
+{
+	return asignaciones - liberaciones;
+}
+
+uint64_t UsoMemoria::bytesVivos() const
+{
+	return bytesAsignados - bytesLiberados;
+}
+
+string UsoMemoria::toDebug() const
+{
+	ostringstream debug;
+	debug << "UsoMemoria(subsistema=" << Memoria::toString(subsistema)
+		<< ", bytesVivos=" << bytesVivos()
+		<< ", bloquesVivos=" << bloquesVivos()
+		<< ", asignaciones=" << asignaciones
+		<< ", liberaciones=" << liberaciones
+		<< ", bytesAsignados=" << bytesAsignados << ")";
+	return debug.str();
+}
+
+Memoria::Ranura& Memoria::_ranura()
+{
+	if (ranura == RANURAS)
+	{
+		ranura = siguienteRanura.fetch_add(1, memory_order_relaxed) % RANURAS;
+	}
+	return ranuras[ranura];
+}
+
+void* Memoria::reservar(size_t tamanio) noexcept
+{
+	if (tamanio > SIZE_MAX - CABECERA)
+	{
+		return nullptr;
+	}
+	uint64_t* cabecera = static_cast<uint64_t*>(malloc(tamanio + CABECERA));
+	if (cabecera == nullptr)
+	{
+		return nullptr;
+	}
+	Subsistema subsistema = zona;
+	cabecera[0] = tamanio;
+	cabecera[1] = static_cast<uint64_t>(subsistema);
+
+	atomic<uint64_t>* valores = _ranura().valores[static_cast<size_t>(subsistema)];
+	valores[Asignaciones].fetch_add(1, memory_order_relaxed);
+	valores[BytesAsignados].fetch_add(tamanio, memory_order_relaxed);
+	if (!activa.load(memory_order_relaxed))
+	{
+		activa.store(true, memory_order_relaxed);
+	}
+	return reinterpret_cast<char*>(cabecera) + CABECERA;
+}
+
+void Memoria::liberar(void* memoria) noexcept
+{
+	if (memoria == nullptr)
+	{
+		return;
+	}
+	uint64_t* cabecera = reinterpret_cast<uint64_t*>(static_cast<char*>(memoria) - CABECERA);
+	atomic<uint64_t>* valores = _ranura().valores[cabecera[1]];
+	valores[Liberaciones].fetch_add(1, memory_order_relaxed);
+	valores[BytesLiberados].fetch_add(cabecera[0], memory_order_relaxed);
+	free(cabecera);
+}
+
+bool Memoria::getActiva()
+{
+	return activa.load(memory_order_relaxed);
+}
+
+Subsistema Memoria::getZona()
+{
+	return zona;
+}
+
+UsoMemoria Memoria::getUso(Subsistema subsistema)
+{
+	UsoMemoria uso;
+	uso.subsistema = subsistema;
+	for (const Ranura& r : ranuras)
+	{
+		const atomic<uint64_t>* valores = r.valores[static_cast<size_t>(subsistema)];
+		uso.asignaciones += valores[Asignaciones].load(memory_order_relaxed);
+		uso.liberaciones += valores[Liberaciones].load(memory_order_relaxed);
+		uso.bytesAsignados += valores[BytesAsignados].load(memory_order_relaxed);
+		uso.bytesLiberados += valores[BytesLiberados].load(memory_order_relaxed);
+	}
+	return uso;
+}
+
+vector<UsoMemoria> Memoria::getUsos()
+{
+	vector<UsoMemoria> usos;
+	for (size_t i = 0; i < SUBSISTEMAS; ++i)
+	{
+		usos.push_back(getUso(static_cast<Subsistema>(i)));
+	}
+	return usos;
+}
+
+UsoMemoria Memoria::getTotal()
+{
+	UsoMemoria total;
+	for (size_t i = 0; i < SUBSISTEMAS; ++i)  // Sin reservar memoria: se usa para medir asignaciones
+	{
+		UsoMemoria uso = getUso(static_cast<Subsistema>(i));
+		total.asignaciones += uso.asignaciones;
+		total.liberaciones += uso.liberaciones;
+		total.bytesAsignados += uso.bytesAsignados;
+		total.bytesLiberados += uso.bytesLiberados;
+	}
+	return total;
+}
+
+string Memoria::volcar()
+{
+	if (!getActiva())
+	{
+		return "Sin contabilidad de memoria: el ejecutable no reemplaza operator new\n";
+	}
+	// Las liberaciones de otro hilo pueden sumarse antes que su asignacin: las restas se hacen con signo
+	auto fila = [](ostringstream& out, const string& nombre, const UsoMemoria& uso) {
+		out << left << setw(16) << nombre << right
+			<< setw(16) << static_cast<int64_t>(uso.bytesVivos())
+			<< setw(14) << static_cast<int64_t>(uso.bloquesVivos())
+			<< setw(16) << uso.asignaciones
+			<< setw(18) << uso.bytesAsignados << '\n';
+	};
+
+	vector<UsoMemoria> usos = getUsos();
+	sort(usos.begin(), usos.end(), [](const UsoMemoria& a, const UsoMemoria& b) {
+		return static_cast<int64_t>(a.bytesVivos()) > static_cast<int64_t>(b.bytesVivos());
+		});
+
+	ostringstream out;
+	out << left << setw(16) << "subsistema" << right << setw(16) << "bytes vivos" << setw(14) << "bloques vivos"
+		<< setw(16) << "asignaciones" << setw(18) << "bytes asignados" << '\n';
+	for (const UsoMemoria& uso : usos)
+	{
+		fila(out, toString(uso.subsistema), uso);
+	}
+	fila(out, "Total", getTotal());
+	return out.str();
+}
+
+string Memoria::volcarLinea()
+{
+	ostringstream out;
+	for (const UsoMemoria& uso : getUsos())
+	{
+		if (out.tellp() > 0)
+		{
+			out << ' ';
+		}
+		out << toString(uso.subsistema) << '=' << static_cast<int64_t>(uso.bytesVivos())
+			<< '/' << static_cast<int64_t>(uso.bloquesVivos()) << '/' << uso.asignaciones;
+	}
+	return out.str();
+}
+
+string Memoria::toString(Subsistema subsistema)
+{
+	switch (subsistema)
+	{
+	case Subsistema::General: return "General";
+	case Subsistema::Contenedores: return "Contenedores";
+	case Subsistema::Serializacion: return "Serializacion";
+	case Subsistema::Dominio: return "Dominio";
+	case Subsistema::Historiales: return "Historiales";
+	case Subsistema::Quejas: return "Quejas";
+	case Subsistema::Identidades: return "Identidades";
+	case Subsistema::Cadenas: return "Cadenas";
+	default: return "Desconocido";
+	}
+}
+
+ZonaMemoria::ZonaMemoria(Subsistema subsistema, bool reemplazar)
+	: anterior(Memoria::zona)
+{
+	if (reemplazar || anterior == Subsistema::General)
+	{
+		Memoria::zona = subsistema;
+	}
+}
+
+ZonaMemoria::~ZonaMemoria()
+{
+	Memoria::zona = anterior;
+}
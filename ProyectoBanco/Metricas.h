@@ -0,0 +1,546 @@
+#pragma once
+
+#include "IDebugable.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Resumen de un histograma de latencias (en nanosegundos)
+struct ResumenLatencias : public IDebugable
+{
+	uint64_t cantidad = 0;
+	double media = 0;
+	uint64_t p50 = 0;
+	uint64_t p99 = 0;
+	uint64_t p999 = 0;
+	uint64_t maximo = 0;
+
+	string toDebug() const override;
+};
+
+string ResumenLatencias::toDebug() const
+{
+	ostringstream debug;
+	debug << "ResumenLatencias(cantidad=" << cantidad
+		<< ", media=" << media
+		<< ", p50=" << p50
+		<< ", p99=" << p99
+		<< ", p999=" << p999
+		<< ", maximo=" << maximo << ")";
+	return debug.str();
+}
+
+// Registro de mtricas del proceso: contadores e histogramas de latencia con nombre.
+//
+// Cada hilo escribe en su propio fragmento (sin compartir lneas de cach con otros hilos) y
+// los fragmentos solo se suman cuando alguien pide un resumen o un volcado. Cuando un hilo
+// termina, su fragmento se acumula en 'retirados' para no perder lo que midi.
+//
+// Los histogramas son logartmico-lineales, como HDR: valores menores que 16 exactos y luego 16
+// cubetas por cada potencia de 2, con un error relativo menor a 6.25% hasta 2^40 ns (unos 18 min).
+class Metricas
+{
+public:
+	enum class Tipo { Contador, Histograma };
+
+	static constexpr size_t SUBCUBETAS = 16;
+	static constexpr size_t BITS_MAXIMOS = 40;
+	static constexpr size_t CUBETAS = (BITS_MAXIMOS - 3) * SUBCUBETAS;
+	// Posiciones de un histograma: cantidad, suma, mximo y luego las cubetas
+	static constexpr size_t POSICIONES_HISTOGRAMA = 3 + CUBETAS;
+
+private:
+	static constexpr size_t TAMANIO_PAGINA = 1024;  // Posiciones por pgina de un fragmento
+	static constexpr size_t MAX_PAGINAS = 256;
+
+	// Valores de un hilo; las pginas se reservan al primer uso
+	struct Fragmento
+	{
+		atomic<atomic<uint64_t>*> paginas[MAX_PAGINAS];
+
+		Fragmento();
+		~Fragmento();
+		atomic<uint64_t>& posicion(size_t indice);
+		uint64_t leer(size_t indice) const;
+	};
+
+	// Dueo del fragmento de un hilo: lo registra al crearse y lo retira al terminar el hilo
+	struct Propietario
+	{
+		Fragmento* fragmento;
+
+		Propietario();
+		~Propietario();
+	};
+
+	struct Metrica
+	{
+		string nombre;
+		Tipo tipo;
+		size_t posicion;
+	};
+
+	mutable mutex m;                 // Protege 'metricas', 'fragmentos', 'retirados' y 'inicio'
+	vector<Metrica> metricas;
+	size_t siguientePosicion;
+	vector<Fragmento*> fragmentos;   // Fragmentos de los hilos vivos
+	Fragmento retirados;             // Suma de los fragmentos de hilos que ya terminaron
+	chrono::steady_clock::time_point inicio;
+	atomic<bool> activas;
+
+	Metricas();
+
+	static Fragmento& _fragmento();
+	void _retirar(Fragmento* fragmento);
+	// Suma de la posicin en todos los fragmentos (o mximo si 'maximo'); requiere 'm'
+	uint64_t _total(size_t posicion, bool maximo) const;
+	ResumenLatencias _resumen(size_t posicion) const;
+	double _segundos() const;
+
+public:
+	Metricas(const Metricas&) = delete;
+	Metricas& operator=(const Metricas&) = delete;
+
+	static Metricas& global();
+
+	// Con las mtricas inactivas los cronmetros no leen el reloj y ni ellos ni los contadores registran nada
+	bool getActivas() const;
+	bool setActivas(bool activas);
+
+	// Posicin de la mtrica 'nombre'; si ya existe con ese tipo se reutiliza
+	size_t registrar(const string& nombre, Tipo tipo);
+
+	// Escrituras del hilo actual
+	void sumar(size_t posicion, uint64_t cantidad);
+	void registrarLatencia(size_t posicion, uint64_t nanosegundos);
+
+	uint64_t getTotal(size_t posicion) const;
+	ResumenLatencias getResumen(size_t posicion) const;
+
+	// Pone todo en cero y reinicia el reloj de las tasas
+	void reiniciar();
+
+	// Tabla con cantidad, tasa por segundo y, para los histogramas, p50/p99/p999 y mximo en
+	// nanosegundos; solo las mtricas cuyo nombre contiene 'filtro'
+	string volcar(const string& filtro = "") const;
+	// Lo mismo en una sola lnea: "nombre=cantidad[/p50/p99/p999]" separados por espacios
+	string volcarLinea(const string& filtro = "") const;
+
+	static size_t cubeta(uint64_t valor);
+	// Valor representativo (punto medio) de la cubeta
+	static uint64_t valorCubeta(size_t cubeta);
+};
+
+constexpr size_t Metricas::SUBCUBETAS;
+constexpr size_t Metricas::CUBETAS;
+constexpr size_t Metricas::POSICIONES_HISTOGRAMA;
+
+// Contador con nombre; se declara esttico junto al cdigo que cuenta
+class Contador
+{
+private:
+	size_t posicion;
+
+public:
+	explicit Contador(const string& nombre);
+
+	void sumar(uint64_t cantidad = 1);
+	uint64_t getTotal() const;
+};
+
+// Histograma de latencias con nombre; se declara esttico junto al cdigo que mide
+class Histograma
+{
+private:
+	size_t posicion;
+
+public:
+	explicit Histograma(const string& nombre);
+
+	void registrar(uint64_t nanosegundos);
+	ResumenLatencias getResumen() const;
+};
+
+// Mide el tiempo de vida del objeto y lo registra en el histograma al destruirse
+class Cronometro
+{
+private:
+	Histograma& histograma;
+	bool activo;
+	chrono::steady_clock::time_point inicio;
+
+public:
+	explicit Cronometro(Histograma& histograma);
+	~Cronometro();
+
+	Cronometro(const Cronometro&) = delete;
+	Cronometro& operator=(const Cronometro&) = delete;
+};
+
+Metricas::Fragmento::Fragmento()
+{
+	for (auto& pagina : paginas)
+	{
+		pagina.store(nullptr, memory_order_relaxed);
+	}
+}
+
+Metricas::Fragmento::~Fragmento()
+{
+	for (auto& pagina : paginas)
+	{
+		delete[] pagina.load(memory_order_relaxed);
+	}
+}
+
+atomic<uint64_t>& Metricas::Fragmento::posicion(size_t indice)
+{
+	// Solo el hilo dueo reserva pginas; los lectores ven nullptr (cero) o la pgina completa
+	atomic<uint64_t>* pagina = paginas[indice / TAMANIO_PAGINA].load(memory_order_acquire);
+	if (pagina == nullptr)
+	{
+		pagina = new atomic<uint64_t>[TAMANIO_PAGINA];
+		for (size_t i = 0; i < TAMANIO_PAGINA; ++i)
+		{
+			pagina[i].store(0, memory_order_relaxed);
+		}
+		paginas[indice / TAMANIO_PAGINA].store(pagina, memory_order_release);
+	}
+	return pagina[indice % TAMANIO_PAGINA];
+}
+
+uint64_t Metricas::Fragmento::leer(size_t indice) const
+{
+	atomic<uint64_t>* pagina = paginas[indice / TAMANIO_PAGINA].load(memory_order_acquire);
+	return pagina == nullptr ? 0 : pagina[indice % TAMANIO_PAGINA].load(memory_order_relaxed);
+}
+
+Metricas::Propietario::Propietario() : fragmento(new Fragmento())
+{
+	Metricas& metricas = Metricas::global();
+	lock_guard<mutex> bloqueo(metricas.m);
+	metricas.fragmentos.push_back(fragmento);
+}
+
+Metricas::Propietario::~Propietario()
+{
+	Metricas::global()._retirar(fragmento);
+}
+
+Metricas::Metricas()
+	: siguientePosicion(0), inicio(chrono::steady_clock::now()), activas(true)
+{}
+
+Metricas& Metricas::global()
+{
+	static Metricas metricas;
+	return metricas;
+}
+
+Metricas::Fragmento& Metricas::_fragmento()
+{
+	thread_local Propietario propietario;
+	return *propietario.fragmento;
+}
+
+void Metricas::_retirar(Fragmento* fragmento)
+{
+	lock_guard<mutex> bloqueo(m);
+	for (const Metrica& metrica : metricas)
+	{
+		size_t posiciones = metrica.tipo == Tipo::Contador ? 1 : POSICIONES_HISTOGRAMA;
+		for (size_t i = 0; i < posiciones; ++i)
+		{
+			uint64_t valor = fragmento->leer(metrica.posicion + i);
+			if (valor == 0)
+			{
+				continue;
+			}
+			atomic<uint64_t>& destino = retirados.posicion(metrica.posicion + i);
+			// La tercera posicin de un histograma es su mximo, que no se suma
+			bool esMaximo = metrica.tipo == Tipo::Histograma && i == 2;
+			destino.store(esMaximo ? max(destino.load(), valor) : destino.load() + valor);
+		}
+	}
+	fragmentos.erase(remove(fragmentos.begin(), fragmentos.end(), fragmento), fragmentos.end());
+	delete fragmento;
+}
+
+uint64_t Metricas::_total(size_t posicion, bool maximo) const
+{
+	uint64_t total = retirados.leer(posicion);
+	for (const Fragmento* fragmento : fragmentos)
+	{
+		uint64_t valor = fragmento->leer(posicion);
+		total = maximo ? max(total, valor) : total + valor;
+	}
+	return total;
+}
+
+ResumenLatencias Metricas::_resumen(size_t posicion) const
+{
+	ResumenLatencias resumen;
+	resumen.cantidad = _total(posicion, false);
+	if (resumen.cantidad == 0)
+	{
+		return resumen;
+	}
+	resumen.media = static_cast<double>(_total(posicion + 1, false)) / resumen.cantidad;
+	resumen.maximo = _total(posicion + 2, true);
+
+	// La cantidad se lee antes que las cubetas; si otro hilo registr entretanto, las
+	// cubetas pueden sumar un poco ms, nunca menos
+	uint64_t objetivos[3] = { (resumen.cantidad * 50 + 99) / 100, (resumen.cantidad * 990 + 999) / 1000,
+		(resumen.cantidad * 9990 + 9999) / 10000 };
+	uint64_t* percentiles[3] = { &resumen.p50, &resumen.p99, &resumen.p999 };
+	uint64_t acumulado = 0;
+	size_t siguiente = 0;
+	for (size_t c = 0; c < CUBETAS && siguiente < 3; ++c)
+	{
+		acumulado += _total(posicion + 3 + c, false);
+		while (siguiente < 3 && acumulado >= objetivos[siguiente])
+		{
+			*percentiles[siguiente++] = min(valorCubeta(c), resumen.maximo);
+		}
+	}
+	return resumen;
+}
+
+double Metricas::_segundos() const
+{
+	return chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+}
+
+bool Metricas::getActivas() const
+{
+	return activas.load(memory_order_relaxed);
+}
+
+bool Metricas::setActivas(bool activas)
+{
+	this->activas.store(activas, memory_order_relaxed);
+	return true;
+}
+
+size_t Metricas::registrar(const string& nombre, Tipo tipo)
+{
+	lock_guard<mutex> bloqueo(m);
+	for (const Metrica& metrica : metricas)
+	{
+		if (metrica.nombre == nombre && metrica.tipo == tipo)
+		{
+			return metrica.posicion;
+		}
+	}
+
+	// Un histograma nunca cruza dos pginas
+	size_t posiciones = tipo == Tipo::Contador ? 1 : POSICIONES_HISTOGRAMA;
+	if (siguientePosicion % TAMANIO_PAGINA + posiciones > TAMANIO_PAGINA)
+	{
+		siguientePosicion += TAMANIO_PAGINA - siguientePosicion % TAMANIO_PAGINA;
+	}
+	if (siguientePosicion + posiciones > TAMANIO_PAGINA * MAX_PAGINAS)
+	{
+		throw runtime_error("Demasiadas metricas registradas");
+	}
+
+	metricas.push_back({ nombre, tipo, siguientePosicion });
+	siguientePosicion += posiciones;
+	return metricas.back().posicion;
+}
+
+void Metricas::sumar(size_t posicion, uint64_t cantidad)
+{
+	_fragmento().posicion(posicion).fetch_add(cantidad, memory_order_relaxed);
+}
+
+void Metricas::registrarLatencia(size_t posicion, uint64_t nanosegundos)
+{
+	Fragmento& fragmento = _fragmento();
+	fragmento.posicion(posicion).fetch_add(1, memory_order_relaxed);
+	fragmento.posicion(posicion + 1).fetch_add(nanosegundos, memory_order_relaxed);
+	atomic<uint64_t>& maximo = fragmento.posicion(posicion + 2);
+	if (nanosegundos > maximo.load(memory_order_relaxed))
+	{
+		maximo.store(nanosegundos, memory_order_relaxed);  // Solo este hilo escribe su mximo
+	}
+	fragmento.posicion(posicion + 3 + cubeta(nanosegundos)).fetch_add(1, memory_order_relaxed);
+}
+
+uint64_t Metricas::getTotal(size_t posicion) const
+{
+	lock_guard<mutex> bloqueo(m);
+	return _total(posicion, false);
+}
+
+ResumenLatencias Metricas::getResumen(size_t posicion) const
+{
+	lock_guard<mutex> bloqueo(m);
+	return _resumen(posicion);
+}
+
+void Metricas::reiniciar()
+{
+	lock_guard<mutex> bloqueo(m);
+	for (Fragmento* fragmento : fragmentos)
+	{
+		for (size_t i = 0; i < siguientePosicion; ++i)
+		{
+			if (fragmento->leer(i) != 0)
+			{
+				fragmento->posicion(i).store(0, memory_order_relaxed);
+			}
+		}
+	}
+	for (size_t i = 0; i < siguientePosicion; ++i)
+	{
+		if (retirados.leer(i) != 0)
+		{
+			retirados.posicion(i).store(0, memory_order_relaxed);
+		}
+	}
+	inicio = chrono::steady_clock::now();
+}
+
+string Metricas::volcar(const string& filtro) const
+{
+	lock_guard<mutex> bloqueo(m);
+	double segundos = max(_segundos(), 1e-9);
+
+	vector<Metrica> ordenadas = metricas;
+	sort(ordenadas.begin(), ordenadas.end(), [](const Metrica& a, const Metrica& b) { return a.nombre < b.nombre; });
+
+	ostringstream out;
+	out << left << setw(36) << "metrica" << right << setw(14) << "cantidad" << setw(14) << "por seg"
+		<< setw(12) << "p50 ns" << setw(12) << "p99 ns" << setw(12) << "p999 ns" << setw(14) << "max ns" << '\n';
+	for (const Metrica& metrica : ordenadas)
+	{
+		if (metrica.nombre.find(filtro) == string::npos)
+		{
+			continue;
+		}
+		uint64_t cantidad = _total(metrica.posicion, false);
+		out << left << setw(36) << metrica.nombre << right << setw(14) << cantidad
+			<< setw(14) << fixed << setprecision(1) << cantidad / segundos;
+		if (metrica.tipo == Tipo::Histograma)
+		{
+			ResumenLatencias resumen = _resumen(metrica.posicion);
+			out << setw(12) << resumen.p50 << setw(12) << resumen.p99
+				<< setw(12) << resumen.p999 << setw(14) << resumen.maximo;
+		}
+		out << '\n';
+	}
+	return out.str();
+}
+
+string Metricas::volcarLinea(const string& filtro) const
+{
+	lock_guard<mutex> bloqueo(m);
+	ostringstream out;
+	for (const Metrica& metrica : metricas)
+	{
+		if (metrica.nombre.find(filtro) == string::npos)
+		{
+			continue;
+		}
+		if (out.tellp() > 0)
+		{
+			out << ' ';
+		}
+		out << metrica.nombre << '=' << _total(metrica.posicion, false);
+		if (metrica.tipo == Tipo::Histograma)
+		{
+			ResumenLatencias resumen = _resumen(metrica.posicion);
+			out << '/' << resumen.p50 << '/' << resumen.p99 << '/' << resumen.p999;
+		}
+	}
+	return out.str();
+}
+
+size_t Metricas::cubeta(uint64_t valor)
+{
+	if (valor < SUBCUBETAS)
+	{
+		return static_cast<size_t>(valor);
+	}
+	size_t bits = 63;
+	while ((valor >> bits) == 0)
+	{
+		--bits;
+	}
+	if (bits >= BITS_MAXIMOS)
+	{
+		return CUBETAS - 1;
+	}
+	// Con 'bits' como la potencia de 2 ms alta, los 4 bits siguientes eligen la subcubeta
+	return (bits - 3) * SUBCUBETAS + static_cast<size_t>((valor >> (bits - 4)) & (SUBCUBETAS - 1));
+}
+
+uint64_t Metricas::valorCubeta(size_t cubeta)
+{
+	if (cubeta < SUBCUBETAS)
+	{
+		return cubeta;
+	}
+	size_t bits = cubeta / SUBCUBETAS + 3;
+	uint64_t ancho = uint64_t(1) << (bits - 4);
+	uint64_t desde = (SUBCUBETAS + cubeta % SUBCUBETAS) * ancho;
+	return desde + ancho / 2;
+}
+
+Contador::Contador(const string& nombre)
+	: posicion(Metricas::global().registrar(nombre, Metricas::Tipo::Contador))
+{}
+
+void Contador::sumar(uint64_t cantidad)
+{
+	Metricas& metricas = Metricas::global();
+	if (!metricas.getActivas())
+	{
+		return;
+	}
+	metricas.sumar(posicion, cantidad);
+}
+
+uint64_t Contador::getTotal() const
+{
+	return Metricas::global().getTotal(posicion);
+}
+
+Histograma::Histograma(const string& nombre)
+	: posicion(Metricas::global().registrar(nombre, Metricas::Tipo::Histograma))
+{}
+
+void Histograma::registrar(uint64_t nanosegundos)
+{
+	Metricas::global().registrarLatencia(posicion, nanosegundos);
+}
+
+ResumenLatencias Histograma::getResumen() const
+{
+	return Metricas::global().getResumen(posicion);
+}
+
+Cronometro::Cronometro(Histograma& histograma)
+	: histograma(histograma), activo(Metricas::global().getActivas())
+{
+	if (activo)
+	{
+		inicio = chrono::steady_clock::now();
+	}
+}
+
+Cronometro::~Cronometro()
+{
+	if (activo)
+	{
+		auto duracion = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio);
+		histograma.registrar(static_cast<uint64_t>(duracion.count()));
+	}
+}
@@ -0,0 +1,446 @@
+#pragma once
+
+#include "SList.h"
+#include "SQueue.h"
+#include "SStack.h"
+#include "AVLTree.h"
+#include "HashTable.h"
+#include "Graph.h"
+#include "MGeneral.h"
+#include "Operacion.h"
+#include "ServidorBanco.h"
+#include "Memoria.h"
+#include "Validacion.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <random>
+
+using namespace std;
+
+// Microbenchmarks de los contenedores, de la serializacin (toSave/load de cada clase
+// ISavable), de los validadores de campos (escalar contra SIMD) y de los depsitos y retiros
+// de punta a punta. Cada medicin se calienta, se
+// repite 'repeticiones' veces de unos 'milisegundos' ms y reporta la mediana de ns por
+// operacin, las asignaciones por operacin y las operaciones por segundo. Los datos se
+// generan con semilla fija para que las ejecuciones sean comparables.
+//   Benchmarks micro [--filtro texto] [--repeticiones R] [--ms M]
+class Microbenchmarks
+{
+private:
+	string filtro;          // Solo se miden los nombres que lo contienen
+	size_t repeticiones;
+	double milisegundos;    // Duracin aproximada de cada repeticin
+	size_t medidas;
+	volatile size_t sumidero; // Consume los resultados para que el compilador no los descarte
+
+	// Mide 'lote' (que hace 'operacionesPorLote' operaciones) e imprime una fila; 'reiniciar'
+	// se ejecuta fuera de la medicin despus de cada lote
+	void _medir(const string& nombre, size_t operacionesPorLote, const function<void()>& lote,
+		const function<void()>& reiniciar = nullptr);
+
+	// toSave y load de un objeto de la clase T (que debe poder construirse sin argumentos)
+	template<class T>
+	void _serializar(const string& nombre, const T& objeto);
+
+public:
+	Microbenchmarks(const string& filtro = "", size_t repeticiones = 5, double milisegundos = 100);
+
+	void contenedores();
+	void serializacion();
+	void validacion();
+	void movimientos();
+
+	// Interpreta los argumentos de main (a partir de "micro") y ejecuta todos los grupos
+	static int ejecutar(int argc, char* argv[]);
+};
+
+Microbenchmarks::Microbenchmarks(const string& filtro, size_t repeticiones, double milisegundos)
+	: filtro(filtro), repeticiones(max<size_t>(1, repeticiones)), milisegundos(milisegundos), medidas(0), sumidero(0)
+{}
+
+void Microbenchmarks::_medir(const string& nombre, size_t operacionesPorLote, const function<void()>& lote,
+	const function<void()>& reiniciar)
+{
+	if (nombre.find(filtro) == string::npos)
+	{
+		return;
+	}
+	if (medidas++ == 0)
+	{
+		cout << left << setw(34) << "benchmark" << right << setw(12) << "ns/op" << setw(12) << "asign/op"
+			<< setw(16) << "op/s" << '\n';
+	}
+
+	// Ejecuta 'lotes' lotes y retorna los segundos medidos (sin contar los reinicios)
+	size_t asignaciones = 0;
+	auto correr = [&](size_t lotes) {
+		double segundos = 0;
+		for (size_t i = 0; i < lotes; ++i)
+		{
+			uint64_t antes = Memoria::getTotal().asignaciones;
+			auto inicio = chrono::steady_clock::now();
+			lote();
+			segundos += chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+			asignaciones += Memoria::getTotal().asignaciones - antes;
+			if (reiniciar)
+			{
+				reiniciar();
+			}
+		}
+		return segundos;
+	};
+
+	// Calentamiento: tambin estima cuntos lotes caben en una repeticin
+	size_t lotes = 1;
+	double segundos = correr(lotes);
+	while (segundos < milisegundos / 1000.0 / 4)
+	{
+		lotes *= 2;
+		segundos = correr(lotes);
+	}
+	lotes = max<size_t>(1, static_cast<size_t>(lotes * (milisegundos / 1000.0) / segundos));
+
+	asignaciones = 0;
+	vector<double> nanosegundos;
+	for (size_t r = 0; r < repeticiones; ++r)
+	{
+		nanosegundos.push_back(correr(lotes) * 1e9 / (lotes * operacionesPorLote));
+	}
+	sort(nanosegundos.begin(), nanosegundos.end());
+	double mediana = nanosegundos[nanosegundos.size() / 2];
+	double operaciones = static_cast<double>(lotes) * operacionesPorLote * repeticiones;
+
+	cout << left << setw(34) << nombre << right << fixed << setw(12) << setprecision(1) << mediana
+		<< setw(12) << setprecision(2) << asignaciones / operaciones
+		<< setw(16) << setprecision(0) << 1e9 / mediana << '\n';
+}
+
+template<class T>
+void Microbenchmarks::_serializar(const string& nombre, const T& objeto)
+{
+	const size_t LOTE = 100;
+	string datos = objeto.toSave();
+	_medir(nombre + "::toSave", LOTE, [&]() {
+		for (size_t i = 0; i < LOTE; ++i)
+		{
+			sumidero = sumidero + objeto.toSave().size();
+		}
+		});
+
+	// Algunas clases agregan a lo que ya tienen al cargar: se parte de un objeto nuevo en cada lote
+	unique_ptr<T> destino(new T());
+	_medir(nombre + "::load", LOTE, [&]() {
+		for (size_t i = 0; i < LOTE; ++i)
+		{
+			destino->load(datos);
+		}
+		}, [&]() { destino.reset(new T()); });
+}
+
+void Microbenchmarks::contenedores()
+{
+	const size_t N = 1000;
+	mt19937 generador(1);
+	vector<int> valores(N);
+	vector<string> claves(N);
+	for (size_t i = 0; i < N; ++i)
+	{
+		valores[i] = static_cast<int>(generador() % 1000000);
+		claves[i] = to_string(100000000000ull + generador() % 900000000000ull);
+	}
+
+	SList<int> lista;
+	_medir("SList::pushBack+clear", N, [&]() {
+		for (int v : valores) lista.pushBack(v);
+		lista.clear();
+		});
+	for (int v : valores) lista.pushBack(v);
+	_medir("SList::recorrer", N, [&]() {
+		size_t suma = 0;
+		for (int v : lista) suma += v;
+		sumidero = suma;
+		});
+	_medir("SList::getAt", 100, [&]() {
+		size_t suma = 0;
+		for (size_t i = 0; i < 100; ++i) suma += lista.getAt((i * 7919) % N);
+		sumidero = suma;
+		});
+
+	SQueue<int> cola;
+	_medir("SQueue::push+pop", N, [&]() {
+		for (int v : valores) cola.push(v);
+		while (!cola.empty()) cola.pop();
+		});
+
+	SStack<int> pila;
+	_medir("SStack::push+pop", N, [&]() {
+		for (int v : valores) pila.push(v);
+		while (!pila.empty()) pila.pop();
+		});
+
+	AVLTree<int> arbol([](int a, int b) { return a < b; });
+	_medir("AVLTree::insert", N, [&]() {
+		for (int v : valores) arbol.insert(v);
+		}, [&]() { arbol.clear(); });
+	for (int v : valores) arbol.insert(v);
+	_medir("AVLTree::getBack+popBack", N, [&]() {
+		size_t suma = 0;
+		while (!arbol.empty())
+		{
+			suma += arbol.getBack();
+			arbol.popBack();
+		}
+		sumidero = suma;
+		}, [&]() { for (int v : valores) arbol.insert(v); });
+	arbol.clear();
+
+	unique_ptr<HashTable<int>> tabla(new HashTable<int>(16));
+	_medir("HashTable::addElement", N, [&]() {
+		for (size_t i = 0; i < N; ++i) tabla->addElement(claves[i], valores[i]);
+		}, [&]() { tabla.reset(new HashTable<int>(16)); });
+	for (size_t i = 0; i < N; ++i) tabla->addElement(claves[i], valores[i]);
+	_medir("HashTable::getElement", N, [&]() {
+		size_t suma = 0;
+		for (const string& clave : claves) suma += tabla->getElement(clave);
+		sumidero = suma;
+		});
+
+	// Las mismas claves como nmeros de cuenta de 12 dgitos (as indexa MGeneral)
+	vector<uint64_t> clavesNumericas(N);
+	for (size_t i = 0; i < N; ++i) clavesNumericas[i] = NumeroCuenta(claves[i]).getValor();
+	unique_ptr<HashTable<int, uint64_t>> tablaNumerica(new HashTable<int, uint64_t>(16));
+	_medir("HashTable<uint64_t>::addElement", N, [&]() {
+		for (size_t i = 0; i < N; ++i) tablaNumerica->addElement(clavesNumericas[i], valores[i]);
+		}, [&]() { tablaNumerica.reset(new HashTable<int, uint64_t>(16)); });
+	for (size_t i = 0; i < N; ++i) tablaNumerica->addElement(clavesNumericas[i], valores[i]);
+	_medir("HashTable<uint64_t>::getElement", N, [&]() {
+		size_t suma = 0;
+		for (uint64_t clave : clavesNumericas) suma += tablaNumerica->getElement(clave);
+		sumidero = suma;
+		});
+
+	unique_ptr<Graph<int>> grafo(new Graph<int>());
+	_medir("Graph::addVertex+addArc", N, [&]() {
+		for (size_t i = 0; i < N; ++i)
+		{
+			grafo->addVertex(valores[i]);
+			if (i > 0) grafo->addArc(i, i - 1, valores[i]);
+		}
+		}, [&]() { grafo.reset(new Graph<int>()); });
+	for (size_t i = 0; i < N; ++i)
+	{
+		grafo->addVertex(valores[i]);
+		grafo->addArc(i, (i * 31) % N, valores[i]);
+		grafo->addArc(i, (i * 17) % N, valores[i]);
+	}
+	_medir("Graph::recorrerArcos", N, [&]() {
+		size_t suma = 0;
+		for (size_t i = 0; i < grafo->size(); ++i)
+		{
+			for (size_t a = 0; a < grafo->vertexSize(i); ++a)
+			{
+				suma += grafo->getArriveVertex(i, a) + grafo->getArc(i, a);
+			}
+		}
+		sumidero = suma;
+		});
+}
+
+void Microbenchmarks::serializacion()
+{
+	Aleatorio aleatorio(1);
+	Fecha fecha;
+	fecha.generateRandom(aleatorio);
+	_serializar("Fecha", fecha);
+	Monto monto;
+	monto.generateRandom(aleatorio);
+	_serializar("Monto", monto);
+	Identidad identidad;
+	identidad.generateRandom(aleatorio);
+	_serializar("Identidad", identidad);
+	Contacto contacto;
+	contacto.generateRandom(aleatorio);
+	_serializar("Contacto", contacto);
+	_serializar("Usuario", Usuario(identidad, contacto));
+	Tarjeta tarjeta;
+	tarjeta.generateRandom(aleatorio);
+	_serializar("Tarjeta", tarjeta);
+	Transaccion transaccion;
+	transaccion.generateRandom(aleatorio);
+	_serializar("Transaccion", transaccion);
+	_serializar("Operacion", Operacion("123456789012", transaccion));
+	Cuenta cuenta;
+	cuenta.generateRandom(aleatorio);
+	_serializar("Cuenta", cuenta);
+	Queja queja;
+	queja.generateRandom(aleatorio);
+	_serializar("Queja", queja);
+	Cliente cliente;
+	cliente.generateRandom(aleatorio);
+	_serializar("Cliente", cliente);
+}
+
+void Microbenchmarks::validacion()
+{
+	// Campos como los de una carga masiva: DNI, telfono, nmero de cuenta, tarjeta y CVV, con
+	// uno de cada 20 invlido, y los correos de Contacto::generateRandom
+	const size_t N = 1000;
+	const size_t longitudes[] = { 8, 9, 12, 16, 3 };
+	mt19937 generador(1);
+	Aleatorio aleatorio(1);
+	vector<string> numeros(N);
+	vector<string> correos(N);
+	for (size_t i = 0; i < N; ++i)
+	{
+		for (size_t k = 0; k < longitudes[i % 5]; ++k)
+		{
+			numeros[i] += static_cast<char>('0' + generador() % 10);
+		}
+		if (generador() % 20 == 0)
+		{
+			numeros[i][generador() % numeros[i].size()] = 'x';
+		}
+		Contacto contacto;
+		contacto.generateRandom(aleatorio);
+		correos[i] = contacto.getCorreoElectronico();
+		if (generador() % 20 == 0)
+		{
+			correos[i].erase(correos[i].find('@'), 1);
+		}
+	}
+
+	// Las dos versiones deben coincidir antes de compararlas
+	for (size_t i = 0; i < N; ++i)
+	{
+		uint64_t simd = 0, escalar = 0;
+		bool validoSimd = Validacion::leerDigitos(numeros[i], simd);
+		bool validoEscalar = Validacion::leerDigitosEscalar(numeros[i], escalar);
+		if (validoSimd != validoEscalar || simd != escalar ||
+			Validacion::esCorreo(correos[i]) != Validacion::esCorreoEscalar(correos[i]))
+		{
+			cerr << "Validacion: la version " << Validacion::getInstrucciones() << " difiere de la escalar\n";
+			return;
+		}
+	}
+
+	string simd = string("/") + Validacion::getInstrucciones();
+	_medir("Validacion::leerDigitos/escalar", N, [&]() {
+		uint64_t suma = 0, valor = 0;
+		for (const string& numero : numeros) suma += Validacion::leerDigitosEscalar(numero, valor) ? valor : 0;
+		sumidero = static_cast<size_t>(suma);
+		});
+	_medir("Validacion::leerDigitos" + simd, N, [&]() {
+		uint64_t suma = 0, valor = 0;
+		for (const string& numero : numeros) suma += Validacion::leerDigitos(numero, valor) ? valor : 0;
+		sumidero = static_cast<size_t>(suma);
+		});
+	_medir("Validacion::esCorreo/escalar", N, [&]() {
+		size_t validos = 0;
+		for (const string& correo : correos) validos += Validacion::esCorreoEscalar(correo);
+		sumidero = validos;
+		});
+	_medir("Validacion::esCorreo" + simd, N, [&]() {
+		size_t validos = 0;
+		for (const string& correo : correos) validos += Validacion::esCorreo(correo);
+		sumidero = validos;
+		});
+}
+
+void Microbenchmarks::movimientos()
+{
+	const size_t LOTE = 1000;
+	Aleatorio aleatorio(1);
+	Fecha fecha;
+	Monto monto;
+	monto.setTotalCentimos(150);
+
+	// Cada lote deja el saldo como estaba; el historial se vaca fuera de la medicin
+	Cuenta cuenta;
+	cuenta.generateRandom(aleatorio);
+	_medir("Cuenta::depositar+retirar", LOTE, [&]() {
+		for (size_t i = 0; i < LOTE / 2; ++i)
+		{
+			cuenta.depositar(fecha, monto);
+			cuenta.retirar(fecha, monto);
+		}
+		}, [&]() { cuenta.setHistorial(SQueue<Transaccion>()); });
+
+	// De punta a punta: texto de la peticin -> bsqueda de la cuenta -> movimiento -> respuesta
+	MGeneral registro;
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		Cliente* nuevo = new Cliente();
+		nuevo->generateRandom(aleatorio);
+		if (!registro.addCliente(nuevo))
+		{
+			delete nuevo;
+		}
+	}
+	vector<string> numeros;
+	for (Cliente* c : registro.getClientes())
+	{
+		c->aplicarCuentas([&numeros](Cuenta& cuenta) { numeros.push_back(cuenta.getNumeroCuenta()); });
+	}
+	vector<string> peticiones;
+	for (size_t i = 0; i < LOTE; ++i)
+	{
+		peticiones.push_back(string(i % 2 == 0 ? "D " : "R ") + numeros[(i / 2) % numeros.size()] + " 150");
+	}
+	auto vaciarHistoriales = [&]() {
+		registro.apply([](Cliente& c) {
+			c.aplicarCuentas([](Cuenta& cuenta) { cuenta.setHistorial(SQueue<Transaccion>()); });
+			});
+	};
+	_medir("MGeneral::getCuenta+depositar", LOTE, [&]() {
+		for (size_t i = 0; i < LOTE; ++i)
+		{
+			registro.getCuenta(numeros[i % numeros.size()])->depositar(fecha, monto);
+		}
+		}, vaciarHistoriales);
+
+	MQuejas quejas(fecha, TipoUsuario::Cliente);
+	ServidorBanco servidor(registro, quejas);
+	_medir("ServidorBanco::responder(D/R)", LOTE, [&]() {
+		size_t largo = 0;
+		for (const string& peticion : peticiones)
+		{
+			largo += servidor.responder(peticion).size();
+		}
+		sumidero = largo;
+		}, vaciarHistoriales);
+}
+
+int Microbenchmarks::ejecutar(int argc, char* argv[])
+{
+	string filtro;
+	size_t repeticiones = 5;
+	double milisegundos = 100;
+	try
+	{
+		for (int i = 2; i + 1 < argc; i += 2)
+		{
+			string opcion = argv[i];
+			if (opcion == "--filtro") filtro = argv[i + 1];
+			else if (opcion == "--repeticiones") repeticiones = stoul(argv[i + 1]);
+			else if (opcion == "--ms") milisegundos = stod(argv[i + 1]);
+			else throw invalid_argument(opcion);
+		}
+	}
+	catch (const exception& e)
+	{
+		cerr << "Argumentos invalidos: " << e.what() << '\n'
+			<< "Uso: micro [--filtro texto] [--repeticiones R] [--ms M]\n";
+		return 2;
+	}
+
+	Microbenchmarks micro(filtro, repeticiones, milisegundos);
+	micro.contenedores();
+	micro.serializacion();
+	micro.validacion();
+	micro.movimientos();
+	return 0;
+}
@@ -25,12 +25,15 @@ public:
 
     // Retorna el monto total como un float
     float getMonto() const;
-    //
+    // Retorna el monto total expresado en cntimos
+    long long getTotalCentimos() const;
 
     // Mtodos de modificacin
 
     // Establece el monto con un float
     bool setMonto(const float& monto);
+    // Establece el monto a partir de un total en cntimos
+    bool setTotalCentimos(const long long& totalCentimos);
 
     // Mtodos de conversin a string
 
@@ -50,7 +53,8 @@ public:
     void load(const string& data) override;
 
     // Mtodo para generar un monto aleatorio
-    void generateRandom() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
 };
 
 // Constructor que recibe un float
@@ -81,6 +85,21 @@ float Monto::getMonto() const {
     return soles + centimos / 100.0f;
 }
 
+// Retorna el monto total expresado en cntimos
+long long Monto::getTotalCentimos() const {
+    return static_cast<long long>(soles) * 100 + centimos;
+}
+
+// Establece el monto a partir de un total en cntimos
+bool Monto::setTotalCentimos(const long long& totalCentimos) {
+    if (totalCentimos < 0) {
+        return false;
+    }
+    soles = static_cast<int>(totalCentimos / 100);
+    centimos = static_cast<int>(totalCentimos % 100);
+    return true;
+}
+
 // Establece el monto con un float
 bool Monto::setMonto(const float& monto) {
     if (monto < 0) {
@@ -139,7 +158,7 @@ void Monto::load(const string& data) {
 }
 
 // Genera un monto aleatorio
-void Monto::generateRandom() {
-    soles = rand() % 101;
-    centimos = rand() % 100; // Asegura un rango de 0 a 99
+void Monto::generateRandom(Aleatorio& aleatorio) {
+    soles = aleatorio.entero(101);
+    centimos = aleatorio.entero(100); // Asegura un rango de 0 a 99
 }
\ No newline at end of file
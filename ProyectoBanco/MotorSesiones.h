@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Sesion.h"
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Atiende muchas sesiones interactivas en un solo hilo.
+//
+// Cada sesin ejecuta un men (una corrutina que recibe la Sesion) que se suspende cada vez
+// que pide una lnea; entregar() le pasa la lnea y la reanuda hasta su siguiente lectura.
+// La salida de cada sesin se acumula hasta que se toma con tomarSalida().
+class MotorSesiones
+{
+public:
+	// Crea la corrutina del men; lo que capture (por ejemplo el cliente) vive con la sesin
+	using Programa = function<Tarea(Sesion&)>;
+
+private:
+	struct Entrada
+	{
+		Programa programa;
+		ostringstream salida;
+		Sesion sesion;
+		Tarea tarea;
+
+		Entrada(Programa programa) : programa(move(programa)), sesion(salida), tarea(this->programa(sesion)) {}
+	};
+
+	unordered_map<size_t, unique_ptr<Entrada>> sesiones;
+	size_t terminadas;
+
+	// Si la corrutina termin con una excepcin la informa en su salida
+	void _verificar(Entrada& entrada);
+
+public:
+	MotorSesiones();
+
+	MotorSesiones(const MotorSesiones&) = delete;
+	MotorSesiones& operator=(const MotorSesiones&) = delete;
+
+	// Crea la sesin 'id' y ejecuta su men hasta la primera lectura; false si ya existe
+	bool abrir(size_t id, const Programa& programa);
+	// Entrega una lnea a la sesin 'id'; false si no existe o su men ya termin
+	bool entregar(size_t id, const string& linea);
+	// Termina la entrada de la sesin (su men ve el fin de la entrada) y la elimina
+	bool cerrar(size_t id);
+
+	bool contains(size_t id) const;
+	bool terminada(size_t id) const;
+	// Retorna y vaca la salida acumulada de la sesin
+	string tomarSalida(size_t id);
+
+	size_t getActivas() const;
+	size_t getTerminadas() const;
+
+	// Multiplexa sesiones sobre un par de flujos (por ejemplo una tubera). Cada lnea de
+	// entrada es "id texto": la primera vez que aparece un id se abre su sesin con 'fabrica'.
+	// Cada lnea de salida se escribe como "id> texto" y al terminar un men como "id# fin"
+	static int atender(istream& entrada, ostream& salida, const function<Programa()>& fabrica);
+};
+
+MotorSesiones::MotorSesiones() : terminadas(0)
+{}
+
+void MotorSesiones::_verificar(Entrada& entrada)
+{
+	if (!entrada.tarea.terminada())
+	{
+		return;
+	}
+	try
+	{
+		entrada.tarea.verificar();
+	}
+	catch (const exception& e)
+	{
+		entrada.salida << "Error: " << e.what() << '\n';
+	}
+}
+
+bool MotorSesiones::abrir(size_t id, const Programa& programa)
+{
+	if (contains(id))
+	{
+		return false;
+	}
+	unique_ptr<Entrada> entrada(new Entrada(programa));
+	entrada->tarea.iniciar();
+	_verificar(*entrada);
+	terminadas += entrada->tarea.terminada() ? 1 : 0;
+	sesiones[id] = move(entrada);
+	return true;
+}
+
+bool MotorSesiones::entregar(size_t id, const string& linea)
+{
+	auto it = sesiones.find(id);
+	if (it == sesiones.end() || it->second->tarea.terminada())
+	{
+		return false;
+	}
+	Entrada& entrada = *it->second;
+	entrada.sesion.entregar(linea);
+	_verificar(entrada);
+	terminadas += entrada.tarea.terminada() ? 1 : 0;
+	return true;
+}
+
+bool MotorSesiones::cerrar(size_t id)
+{
+	auto it = sesiones.find(id);
+	if (it == sesiones.end())
+	{
+		return false;
+	}
+	if (!it->second->tarea.terminada())
+	{
+		it->second->sesion.cerrarEntrada();
+		terminadas += it->second->tarea.terminada() ? 1 : 0;
+	}
+	sesiones.erase(it);
+	return true;
+}
+
+bool MotorSesiones::contains(size_t id) const
+{
+	return sesiones.find(id) != sesiones.end();
+}
+
+bool MotorSesiones::terminada(size_t id) const
+{
+	auto it = sesiones.find(id);
+	return it == sesiones.end() || it->second->tarea.terminada();
+}
+
+string MotorSesiones::tomarSalida(size_t id)
+{
+	auto it = sesiones.find(id);
+	if (it == sesiones.end())
+	{
+		return "";
+	}
+	string texto = it->second->salida.str();
+	it->second->salida.str("");
+	return texto;
+}
+
+size_t MotorSesiones::getActivas() const
+{
+	size_t activas = 0;
+	for (const auto& sesion : sesiones)
+	{
+		activas += sesion.second->tarea.terminada() ? 0 : 1;
+	}
+	return activas;
+}
+
+size_t MotorSesiones::getTerminadas() const
+{
+	return terminadas;
+}
+
+int MotorSesiones::atender(istream& entrada, ostream& salida, const function<Programa()>& fabrica)
+{
+	MotorSesiones motor;
+	auto volcar = [&motor, &salida](size_t id) {
+		istringstream texto(motor.tomarSalida(id));
+		string linea;
+		while (getline(texto, linea))
+		{
+			salida << id << "> " << linea << '\n';
+		}
+		if (motor.terminada(id))
+		{
+			salida << id << "# fin\n";
+			motor.cerrar(id);
+		}
+		salida.flush();
+	};
+
+	string linea;
+	while (getline(entrada, linea))
+	{
+		if (!linea.empty() && linea.back() == '\r')
+		{
+			linea.pop_back();
+		}
+		istringstream in(linea);
+		size_t id;
+		if (!(in >> id))
+		{
+			cerr << "Linea invalida (se esperaba \"id texto\"): " << linea << '\n';
+			continue;
+		}
+		if (in.peek() == ' ')
+		{
+			in.get();
+		}
+		string texto;
+		getline(in, texto);
+
+		if (!motor.contains(id))
+		{
+			// La primera lnea de una sesin solo la abre: el men an no pidi nada
+			motor.abrir(id, fabrica());
+			volcar(id);
+			if (texto.empty() || !motor.contains(id))
+			{
+				continue;
+			}
+		}
+		motor.entregar(id, texto);
+		volcar(id);
+	}
+
+	// Fin de la entrada: terminar los mens que quedaron esperando
+	vector<size_t> pendientes;
+	for (const auto& sesion : motor.sesiones)
+	{
+		pendientes.push_back(sesion.first);
+	}
+	for (size_t id : pendientes)
+	{
+		motor.sesiones[id]->sesion.cerrarEntrada();
+		motor.terminadas += motor.terminada(id) ? 1 : 0;
+		volcar(id);
+	}
+	return 0;
+}
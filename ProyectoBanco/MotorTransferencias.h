@@ -0,0 +1,234 @@
+#pragma once
+
+#include "Cuenta.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Resultado de una prueba de estrs de transferencias
+struct ResultadoTransferencias : public IDebugable
+{
+	size_t exitosas = 0;         // Transferencias completadas
+	size_t rechazadas = 0;       // Transferencias sin saldo suficiente o con tarjeta inactiva
+	size_t auditorias = 0;       // Veces que se sum el dinero total durante la prueba
+	size_t descuadres = 0;       // Auditoras en las que el total no coincidi
+	long long totalInicial = 0;  // Dinero total antes de la prueba (cntimos)
+	long long totalFinal = 0;    // Dinero total despus de la prueba (cntimos)
+	double segundos = 0;
+
+	// El dinero no se cre ni se perdi en ningn momento
+	bool conservado() const;
+	double transferenciasPorSegundo() const;
+
+	string toDebug() const override;
+};
+
+bool ResultadoTransferencias::conservado() const
+{
+	return descuadres == 0 && totalInicial == totalFinal;
+}
+
+double ResultadoTransferencias::transferenciasPorSegundo() const
+{
+	return segundos > 0 ? (exitosas + rechazadas) / segundos : 0;
+}
+
+string ResultadoTransferencias::toDebug() const
+{
+	ostringstream debug;
+	debug << "ResultadoTransferencias(exitosas=" << exitosas
+		<< ", rechazadas=" << rechazadas
+		<< ", auditorias=" << auditorias
+		<< ", descuadres=" << descuadres
+		<< ", totalInicial=" << totalInicial
+		<< ", totalFinal=" << totalFinal
+		<< ", segundos=" << segundos
+		<< ", transferenciasPorSegundo=" << transferenciasPorSegundo() << ")";
+	return debug.str();
+}
+
+// Transferencias atmicas entre cuentas.
+//
+// Cada cuenta se asocia a uno de NUMERO_CERROJOS cerrojos segn su nmero de cuenta.
+// Una transferencia toma los dos cerrojos siempre en orden creciente de ndice, por lo
+// que dos transferencias cruzadas (A->B y B->A) nunca se bloquean mutuamente.
+class MotorTransferencias
+{
+private:
+	static constexpr size_t NUMERO_CERROJOS = 256;
+
+	// Cada cerrojo en su propia lnea de cach para que no compitan entre s
+	struct alignas(64) Cerrojo
+	{
+		mutex m;
+	};
+
+	Fecha fechaActual;
+	Cerrojo cerrojos[NUMERO_CERROJOS];
+
+	size_t _indiceCerrojo(const Cuenta& cuenta) const;
+	long long _auditar(const vector<Cuenta*>& cuentas);
+
+public:
+	MotorTransferencias(const Fecha& fechaActual);
+
+	// No se copia: los cerrojos protegen a cuentas concretas
+	MotorTransferencias(const MotorTransferencias&) = delete;
+	MotorTransferencias& operator=(const MotorTransferencias&) = delete;
+
+	Fecha getFechaActual() const;
+	bool setFechaActual(const Fecha& fechaActual);
+
+	// Debita 'origen' y acredita 'destino' como una sola operacin; registra el retiro
+	// en el historial de origen y el depsito en el de destino
+	bool transferir(Cuenta& origen, Cuenta& destino, const Monto& monto);
+
+	// Ejecuta 'transferencias' transferencias aleatorias entre 'cuentas' repartidas en 'hilos'
+	// hilos mientras otro hilo audita que el dinero total no cambie
+	ResultadoTransferencias estresar(const vector<Cuenta*>& cuentas, size_t hilos, size_t transferencias,
+		unsigned semilla = 1);
+};
+
+constexpr size_t MotorTransferencias::NUMERO_CERROJOS;
+
+MotorTransferencias::MotorTransferencias(const Fecha& fechaActual)
+	: fechaActual(fechaActual)
+{
+}
+
+Fecha MotorTransferencias::getFechaActual() const
+{
+	return fechaActual;
+}
+
+bool MotorTransferencias::setFechaActual(const Fecha& fechaActual)
+{
+	this->fechaActual = fechaActual;
+	return true;
+}
+
+size_t MotorTransferencias::_indiceCerrojo(const Cuenta& cuenta) const
+{
+	return cuenta.getNumeroCuentaNumerico().getValor() % NUMERO_CERROJOS;
+}
+
+bool MotorTransferencias::transferir(Cuenta& origen, Cuenta& destino, const Monto& monto)
+{
+	if (&origen == &destino || monto.getTotalCentimos() <= 0)
+	{
+		return false;
+	}
+
+	size_t i = _indiceCerrojo(origen);
+	size_t j = _indiceCerrojo(destino);
+	if (i > j)
+	{
+		swap(i, j);
+	}
+
+	// Dos cuentas pueden compartir cerrojo: en ese caso se toma una sola vez
+	lock_guard<mutex> primero(cerrojos[i].m);
+	unique_lock<mutex> segundo(cerrojos[j].m, defer_lock);
+	if (j != i)
+	{
+		segundo.lock();
+	}
+
+	return origen.transferir(destino, fechaActual, monto);
+}
+
+// Suma todos los saldos con todos los cerrojos tomados (en orden), sin transferencias a medias
+long long MotorTransferencias::_auditar(const vector<Cuenta*>& cuentas)
+{
+	for (auto& cerrojo : cerrojos)
+	{
+		cerrojo.m.lock();
+	}
+
+	long long total = 0;
+	for (const Cuenta* cuenta : cuentas)
+	{
+		total += cuenta->getSaldoCentimos();
+	}
+
+	for (auto& cerrojo : cerrojos)
+	{
+		cerrojo.m.unlock();
+	}
+	return total;
+}
+
+ResultadoTransferencias MotorTransferencias::estresar(const vector<Cuenta*>& cuentas, size_t hilos,
+	size_t transferencias, unsigned semilla)
+{
+	ResultadoTransferencias resultado;
+	if (cuentas.size() < 2)
+	{
+		return resultado;
+	}
+	if (hilos == 0)
+	{
+		hilos = max<size_t>(1, thread::hardware_concurrency());
+	}
+
+	resultado.totalInicial = _auditar(cuentas);
+	auto inicio = chrono::steady_clock::now();
+
+	atomic<size_t> exitosas(0), rechazadas(0), activos(hilos);
+	vector<thread> trabajadores;
+	for (size_t h = 0; h < hilos; ++h)
+	{
+		size_t cantidad = transferencias / hilos + (h < transferencias % hilos ? 1 : 0);
+		trabajadores.emplace_back([&, h, cantidad]() {
+			mt19937 generador(semilla + static_cast<unsigned>(h));
+			uniform_int_distribution<size_t> cuenta(0, cuentas.size() - 1);
+			uniform_int_distribution<long long> centimos(1, 10000);
+			size_t propiasExitosas = 0, propiasRechazadas = 0;
+
+			for (size_t k = 0; k < cantidad; ++k)
+			{
+				size_t a = cuenta(generador);
+				size_t b = cuenta(generador);
+				Monto monto;
+				monto.setTotalCentimos(centimos(generador));
+				if (a != b && transferir(*cuentas[a], *cuentas[b], monto))
+				{
+					++propiasExitosas;
+				}
+				else
+				{
+					++propiasRechazadas;
+				}
+			}
+
+			exitosas += propiasExitosas;
+			rechazadas += propiasRechazadas;
+			--activos;
+			});
+	}
+
+	// Auditor: mientras hay transferencias en curso el total debe mantenerse
+	while (activos.load() > 0)
+	{
+		if (_auditar(cuentas) != resultado.totalInicial)
+		{
+			++resultado.descuadres;
+		}
+		++resultado.auditorias;
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+
+	for (auto& trabajador : trabajadores)
+	{
+		trabajador.join();
+	}
+
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+	resultado.exitosas = exitosas;
+	resultado.rechazadas = rechazadas;
+	resultado.totalFinal = _auditar(cuentas);
+	return resultado;
+}
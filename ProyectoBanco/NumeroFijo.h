@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Validacion.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// Nmero de exactamente DIGITOS dgitos decimales (DNI, tarjeta, CVV, telfono, nmero de cuenta)
+// guardado como un entero de 8 bytes en lugar de un string de 32. Se compara y se usa como clave
+// de hash como entero; al formatearlo se completan los ceros a la izquierda. Puede estar vaco
+// (sin asignar), y entonces se formatea como "".
+template<size_t DIGITOS>
+class NumeroFijo
+{
+	static_assert(DIGITOS > 0 && DIGITOS <= 19, "NumeroFijo: a lo ms 19 dgitos caben en 64 bits");
+
+private:
+	static constexpr uint64_t VACIO = UINT64_MAX;
+
+	uint64_t valor;
+
+	static constexpr uint64_t _limite();  // 10^DIGITOS
+
+public:
+	// Vaco
+	NumeroFijo();
+	// Queda vaco si 'texto' no es vlido
+	explicit NumeroFijo(string_view texto);
+
+	// Exactamente DIGITOS caracteres, todos dgitos
+	static bool esValido(string_view texto);
+
+	// Valida y convierte en una sola pasada; si no es vlido retorna false y no cambia
+	bool asignar(string_view texto);
+	// Retorna false si 'valor' tiene ms de DIGITOS dgitos
+	bool setValor(uint64_t valor);
+	void clear();
+
+	bool empty() const;
+	uint64_t getValor() const;
+
+	// Agrega los DIGITOS dgitos al final de 'destino' (nada si est vaco)
+	void escribirEn(string& destino) const;
+	string toString() const;
+
+	bool operator==(const NumeroFijo& other) const;
+	bool operator!=(const NumeroFijo& other) const;
+	bool operator<(const NumeroFijo& other) const;
+};
+
+using DNI = NumeroFijo<8>;
+using NumeroTarjeta = NumeroFijo<16>;
+using CodigoCVV = NumeroFijo<3>;
+using Telefono = NumeroFijo<9>;
+using NumeroCuenta = NumeroFijo<12>;
+
+template<size_t DIGITOS>
+ostream& operator<<(ostream& out, const NumeroFijo<DIGITOS>& numero);
+
+template<size_t DIGITOS>
+constexpr uint64_t NumeroFijo<DIGITOS>::_limite()
+{
+	uint64_t limite = 1;
+	for (size_t i = 0; i < DIGITOS; ++i)
+	{
+		limite *= 10;
+	}
+	return limite;
+}
+
+template<size_t DIGITOS>
+NumeroFijo<DIGITOS>::NumeroFijo()
+	: valor(VACIO)
+{}
+
+template<size_t DIGITOS>
+NumeroFijo<DIGITOS>::NumeroFijo(string_view texto)
+	: valor(VACIO)
+{
+	asignar(texto);
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::esValido(string_view texto)
+{
+	return texto.size() == DIGITOS && Validacion::esDigitos(texto);
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::asignar(string_view texto)
+{
+	// Hasta 16 dgitos se validan y convierten con un solo registro SIMD (ver Validacion.h)
+	return texto.size() == DIGITOS && Validacion::leerDigitos(texto, valor);
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::setValor(uint64_t valor)
+{
+	if (valor >= _limite())
+	{
+		return false;
+	}
+	this->valor = valor;
+	return true;
+}
+
+template<size_t DIGITOS>
+void NumeroFijo<DIGITOS>::clear()
+{
+	valor = VACIO;
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::empty() const
+{
+	return valor == VACIO;
+}
+
+template<size_t DIGITOS>
+uint64_t NumeroFijo<DIGITOS>::getValor() const
+{
+	return valor;
+}
+
+template<size_t DIGITOS>
+void NumeroFijo<DIGITOS>::escribirEn(string& destino) const
+{
+	if (empty())
+	{
+		return;
+	}
+	char digitos[DIGITOS];
+	uint64_t resto = valor;
+	for (size_t i = DIGITOS; i > 0; --i)
+	{
+		digitos[i - 1] = static_cast<char>('0' + resto % 10);
+		resto /= 10;
+	}
+	destino.append(digitos, DIGITOS);
+}
+
+template<size_t DIGITOS>
+string NumeroFijo<DIGITOS>::toString() const
+{
+	string texto;
+	escribirEn(texto);
+	return texto;
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::operator==(const NumeroFijo& other) const
+{
+	return valor == other.valor;
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::operator!=(const NumeroFijo& other) const
+{
+	return valor != other.valor;
+}
+
+template<size_t DIGITOS>
+bool NumeroFijo<DIGITOS>::operator<(const NumeroFijo& other) const
+{
+	return valor < other.valor;
+}
+
+template<size_t DIGITOS>
+ostream& operator<<(ostream& out, const NumeroFijo<DIGITOS>& numero)
+{
+	return out << numero.toString();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Transaccion.h"
+
+// Resultado de aplicar una operacin de un lote
+enum class EstadoOperacion { Pendiente, Aplicada, CuentaInexistente, TarjetaInactiva, MontoInvalido, TipoInvalido, SaldoInsuficiente };
+
+// Retorna el estado de una operacin como cadena
+string toStringEstado(const EstadoOperacion& estado)
+{
+    switch (estado) {
+    case EstadoOperacion::Pendiente: return "Pendiente";
+    case EstadoOperacion::Aplicada: return "Aplicada";
+    case EstadoOperacion::CuentaInexistente: return "CuentaInexistente";
+    case EstadoOperacion::TarjetaInactiva: return "TarjetaInactiva";
+    case EstadoOperacion::MontoInvalido: return "MontoInvalido";
+    case EstadoOperacion::TipoInvalido: return "TipoInvalido";
+    case EstadoOperacion::SaldoInsuficiente: return "SaldoInsuficiente";
+    }
+    return "Desconocido";
+}
+
+// Movimiento a aplicar sobre una cuenta en un lote (por ejemplo, una lnea de un archivo de liquidacin)
+struct Operacion : public IDebugable, ISavable
+{
+    string numeroCuenta;       // Cuenta sobre la que se aplica
+    Transaccion transaccion;   // Tipo, fecha y monto del movimiento
+
+    Operacion(const string& numeroCuenta, const Transaccion& transaccion);
+    Operacion(const string& datos);
+    Operacion() = default;
+
+    string toDebug() const override;
+    // Formato: numeroCuenta;Transaccion::toSave
+    string toSave() const override;
+    void load(const string& data) override;
+};
+
+Operacion::Operacion(const string& numeroCuenta, const Transaccion& transaccion)
+    : numeroCuenta(numeroCuenta), transaccion(transaccion) {}
+
+Operacion::Operacion(const string& datos) {
+    load(datos);
+}
+
+string Operacion::toDebug() const {
+    ostringstream debug;
+    debug << "Operacion(numeroCuenta='" << numeroCuenta
+        << "', transaccion=" << transaccion.toDebug() << ")";
+    return debug.str();
+}
+
+string Operacion::toSave() const {
+    ostringstream out;
+    out << numeroCuenta << Serialization::DELIMITER_SECTION << transaccion.toSave();
+    return out.str();
+}
+
+void Operacion::load(const string& data) {
+    size_t separador = data.find(Serialization::DELIMITER_SECTION);
+    if (separador == string::npos || separador == 0) {
+        throw runtime_error("Operacin mal formateada: falta el nmero de cuenta.");
+    }
+    numeroCuenta = data.substr(0, separador);
+    transaccion.load(data.substr(separador + 1));
+}
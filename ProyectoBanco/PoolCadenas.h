@@ -0,0 +1,160 @@
+#pragma once
+
+#include "ConcurrentLog.h"
+#include "Memoria.h"
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+
+// Pool global de cadenas internadas: cada texto distinto se guarda una sola vez y se identifica
+// por un entero. Solo para campos de vocabulario pequeo y acotado (apellidos, departamentos,
+// provincias, distritos) que se repiten en millones de clientes: las cadenas nunca se liberan,
+// as que un campo de texto libre lo hara crecer sin lmite. Su direccin no cambia; el id 0
+// es siempre la cadena vaca.
+class PoolCadenas
+{
+private:
+	mutable shared_mutex m;                 // Protege 'indice'; las escrituras en 'cadenas' la tienen exclusiva
+	ConcurrentLog<string> cadenas;          // Cadena de cada id; se lee sin bloqueos
+	unordered_map<string_view, uint32_t> indice; // Las vistas apuntan a las cadenas de 'cadenas'
+
+	PoolCadenas();
+
+public:
+	PoolCadenas(const PoolCadenas&) = delete;
+	PoolCadenas& operator=(const PoolCadenas&) = delete;
+
+	static PoolCadenas& global();
+
+	// Id de 'texto'; lo agrega si an no est. Seguro entre hilos
+	uint32_t internar(string_view texto);
+	// Cadena del id (sin bloqueos); el id debe provenir de internar
+	const string& obtener(uint32_t id) const;
+	// Cantidad de cadenas distintas, incluida la vaca
+	size_t size() const;
+};
+
+// Referencia de 4 bytes a una cadena del pool. Se compara por id y se convierte implcitamente
+// a const string& para pasarla a los setters y flujos que esperan un string.
+class CadenaInterna
+{
+private:
+	uint32_t id;
+
+public:
+	// Cadena vaca
+	CadenaInterna();
+	explicit CadenaInterna(string_view texto);
+	CadenaInterna& operator=(string_view texto);
+
+	uint32_t getId() const;
+	const string& str() const;
+	bool empty() const;
+	operator const string&() const;
+
+	bool operator==(const CadenaInterna& other) const;
+	bool operator!=(const CadenaInterna& other) const;
+};
+
+PoolCadenas::PoolCadenas()
+	: cadenas(Subsistema::Cadenas)
+{
+	cadenas.push(string());
+	ZonaMemoria zona(Subsistema::Cadenas);
+	indice.emplace(string_view(), 0);
+}
+
+PoolCadenas& PoolCadenas::global()
+{
+	static PoolCadenas pool;
+	return pool;
+}
+
+uint32_t PoolCadenas::internar(string_view texto)
+{
+	{
+		shared_lock<shared_mutex> lectura(m);
+		auto it = indice.find(texto);
+		if (it != indice.end())
+		{
+			return it->second;
+		}
+	}
+
+	unique_lock<shared_mutex> escritura(m);
+	// Otro hilo pudo agregarla entre ambos bloqueos
+	auto it = indice.find(texto);
+	if (it != indice.end())
+	{
+		return it->second;
+	}
+	ZonaMemoria zona(Subsistema::Cadenas);
+	uint32_t id = static_cast<uint32_t>(cadenas.size());
+	cadenas.push(string(texto));
+	indice.emplace(string_view(cadenas.at(id)), id);
+	return id;
+}
+
+const string& PoolCadenas::obtener(uint32_t id) const
+{
+	return cadenas.at(id);
+}
+
+size_t PoolCadenas::size() const
+{
+	return cadenas.size();
+}
+
+CadenaInterna::CadenaInterna()
+	: id(0)
+{}
+
+CadenaInterna::CadenaInterna(string_view texto)
+	: id(PoolCadenas::global().internar(texto))
+{}
+
+CadenaInterna& CadenaInterna::operator=(string_view texto)
+{
+	// Asignar la misma cadena del pool (p. ej. un setter que recibe str()) no la vuelve a buscar
+	const string& actual = str();
+	if (texto.data() != actual.data() || texto.size() != actual.size())
+	{
+		id = PoolCadenas::global().internar(texto);
+	}
+	return *this;
+}
+
+uint32_t CadenaInterna::getId() const
+{
+	return id;
+}
+
+const string& CadenaInterna::str() const
+{
+	return PoolCadenas::global().obtener(id);
+}
+
+bool CadenaInterna::empty() const
+{
+	return id == 0;
+}
+
+CadenaInterna::operator const string&() const
+{
+	return str();
+}
+
+bool CadenaInterna::operator==(const CadenaInterna& other) const
+{
+	return id == other.id;
+}
+
+bool CadenaInterna::operator!=(const CadenaInterna& other) const
+{
+	return id != other.id;
+}
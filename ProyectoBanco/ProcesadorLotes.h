@@ -0,0 +1,201 @@
+#pragma once
+
+#include "MGeneral.h"
+#include "Operacion.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Resultado de procesar un lote de operaciones
+struct ResultadoLote : public IDebugable
+{
+	vector<EstadoOperacion> estados;  // Estado de cada operacin, en el orden del lote
+	size_t aplicadas = 0;             // Operaciones aplicadas
+	size_t rechazadas = 0;            // Operaciones rechazadas (ver 'estados')
+	size_t cuentas = 0;               // Cuentas distintas afectadas por el lote
+	double segundos = 0;
+
+	double operacionesPorSegundo() const;
+
+	string toDebug() const override;
+};
+
+double ResultadoLote::operacionesPorSegundo() const
+{
+	return segundos > 0 ? estados.size() / segundos : 0;
+}
+
+string ResultadoLote::toDebug() const
+{
+	ostringstream debug;
+	debug << "ResultadoLote(operaciones=" << estados.size()
+		<< ", aplicadas=" << aplicadas
+		<< ", rechazadas=" << rechazadas
+		<< ", cuentas=" << cuentas
+		<< ", segundos=" << segundos
+		<< ", operacionesPorSegundo=" << operacionesPorSegundo() << ")";
+	return debug.str();
+}
+
+// Aplica lotes de operaciones (por ejemplo, la liquidacin de fin de da) sobre las cuentas del registro.
+// Las operaciones se agrupan por cuenta conservando su orden relativo y cada grupo se aplica
+// en una sola pasada (Cuenta::aplicarLote); los grupos se reparten entre los hilos.
+class ProcesadorLotes
+{
+private:
+	MGeneral& registro;
+
+public:
+	ProcesadorLotes(MGeneral& registro);
+
+	// 'hilos' = 0 usa todos los ncleos
+	ResultadoLote procesar(const vector<Operacion>& operaciones, size_t hilos = 1) const;
+
+	// Lee un archivo con una Operacion::toSave por lnea
+	static vector<Operacion> cargarArchivo(const string& archivo);
+	static bool guardarArchivo(const string& archivo, const vector<Operacion>& operaciones);
+};
+
+ProcesadorLotes::ProcesadorLotes(MGeneral& registro)
+	: registro(registro)
+{
+}
+
+ResultadoLote ProcesadorLotes::procesar(const vector<Operacion>& operaciones, size_t hilos) const
+{
+	static Histograma latencia("ProcesadorLotes.procesar");
+	Cronometro cronometro(latencia);
+	ResultadoLote resultado;
+	auto inicio = chrono::steady_clock::now();
+	resultado.estados.assign(operaciones.size(), EstadoOperacion::Pendiente);
+
+	// Agrupar por cuenta: orden estable para respetar el orden del lote dentro de cada cuenta
+	vector<size_t> indices(operaciones.size());
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		indices[i] = i;
+	}
+	stable_sort(indices.begin(), indices.end(), [&operaciones](size_t a, size_t b) {
+		return operaciones[a].numeroCuenta < operaciones[b].numeroCuenta;
+		});
+
+	vector<size_t> grupos;  // Inicio de cada grupo dentro de 'indices'
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		if (i == 0 || operaciones[indices[i]].numeroCuenta != operaciones[indices[i - 1]].numeroCuenta)
+		{
+			grupos.push_back(i);
+		}
+	}
+	grupos.push_back(indices.size());
+	resultado.cuentas = grupos.size() - 1;
+
+	if (hilos == 0)
+	{
+		hilos = max<size_t>(1, thread::hardware_concurrency());
+	}
+	hilos = max<size_t>(1, min(hilos, resultado.cuentas));
+
+	atomic<size_t> siguienteGrupo(0);
+	atomic<size_t> aplicadas(0);
+	auto trabajar = [&]() {
+		size_t propias = 0;
+		size_t g;
+		while ((g = siguienteGrupo.fetch_add(1)) < resultado.cuentas)
+		{
+			const size_t* grupo = indices.data() + grupos[g];
+			size_t cantidad = grupos[g + 1] - grupos[g];
+
+			Cuenta* cuenta = registro.getCuenta(operaciones[grupo[0]].numeroCuenta);
+			if (cuenta == nullptr)
+			{
+				for (size_t k = 0; k < cantidad; ++k)
+				{
+					resultado.estados[grupo[k]] = EstadoOperacion::CuentaInexistente;
+				}
+				continue;
+			}
+			propias += cuenta->aplicarLote(operaciones, grupo, cantidad, resultado.estados);
+		}
+		aplicadas += propias;
+		};
+
+	vector<thread> trabajadores;
+	for (size_t h = 1; h < hilos; ++h)
+	{
+		trabajadores.emplace_back(trabajar);
+	}
+	trabajar();
+	for (auto& trabajador : trabajadores)
+	{
+		trabajador.join();
+	}
+
+	resultado.aplicadas = aplicadas;
+	resultado.rechazadas = operaciones.size() - resultado.aplicadas;
+
+	static Contador aplicadasTotales("ProcesadorLotes.aplicadas");
+	static Contador rechazadasTotales("ProcesadorLotes.rechazadas");
+	aplicadasTotales.sumar(resultado.aplicadas);
+	rechazadasTotales.sumar(resultado.rechazadas);
+	resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+	return resultado;
+}
+
+vector<Operacion> ProcesadorLotes::cargarArchivo(const string& archivo)
+{
+	static Histograma latencia("ProcesadorLotes.cargarArchivo");
+	Cronometro cronometro(latencia);
+	ZonaMemoria zona(Subsistema::Serializacion);
+	ifstream inFile(archivo);
+	if (!inFile)
+	{
+		throw runtime_error("No se pudo abrir el archivo de operaciones: " + archivo);
+	}
+
+	vector<Operacion> operaciones;
+	string linea;
+	size_t numeroLinea = 0;
+	while (getline(inFile, linea))
+	{
+		++numeroLinea;
+		if (!linea.empty() && linea.back() == '\r')
+		{
+			linea.pop_back();
+		}
+		if (linea.empty())
+		{
+			continue;
+		}
+
+		try
+		{
+			operaciones.emplace_back(linea);
+		}
+		catch (const exception& e)
+		{
+			throw runtime_error("Lnea " + to_string(numeroLinea) + " de " + archivo + ": " + e.what());
+		}
+	}
+	return operaciones;
+}
+
+bool ProcesadorLotes::guardarArchivo(const string& archivo, const vector<Operacion>& operaciones)
+{
+	static Histograma latencia("ProcesadorLotes.guardarArchivo");
+	Cronometro cronometro(latencia);
+	ZonaMemoria zona(Subsistema::Serializacion);
+	ofstream outFile(archivo, ios::trunc);
+	if (!outFile)
+	{
+		cerr << "Error al abrir el archivo para guardar las operaciones.\n";
+		return false;
+	}
+	for (const Operacion& operacion : operaciones)
+	{
+		outFile << operacion.toSave() << '\n';
+	}
+	return outFile.good();
+}
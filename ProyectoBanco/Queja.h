@@ -31,7 +31,8 @@ public:
 	string toSave() const override;
 	void load(const string& data) override;
 	string toShow() const override;
-	void generateRandom() override;
+	void generateRandom(Aleatorio& aleatorio) override;
+	using IRandomizable::generateRandom;
 };
 
 Queja::Queja(const Fecha& fechaEmision, const string& cliente, const string& descripcion)
@@ -132,10 +133,10 @@ string Queja::toShow() const
 	return show.str(); // Retorna la representacin legible
 }
 
-void Queja::generateRandom()
+void Queja::generateRandom(Aleatorio& aleatorio)
 {
 	// Generar fecha aleatoria
-	fechaEmision.generateRandom();
+	fechaEmision.generateRandom(aleatorio);
 
 	// Arrays de apellidos y nombres
 	const string apellidos[] = {
@@ -151,7 +152,7 @@ void Queja::generateRandom()
 	};
 
 	// Generar cliente aleatorio (primer apellido, primer nombre)
-	cliente = apellidos[rand() % (sizeof(apellidos) / sizeof(apellidos[0]))] + ", " + nombres[rand() % (sizeof(nombres) / sizeof(nombres[0]))];
+	cliente = apellidos[aleatorio.entero(sizeof(apellidos) / sizeof(apellidos[0]))] + ", " + nombres[aleatorio.entero(sizeof(nombres) / sizeof(nombres[0]))];
 
 	// Arrays de queja
 	static const string disgustos[] = {
@@ -175,5 +176,5 @@ void Queja::generateRandom()
 	const int NUM_RAZONES = sizeof(compensaciones) / sizeof(compensaciones[0]);
 
 	// Combinar aleatoriamente las partes para formar una queja
-	descripcion = disgustos[rand() % NUM_DISGUSTOS] + " con " + temas[rand() % NUM_COSAS] + " quiero " + compensaciones[rand() % NUM_RAZONES];
+	descripcion = disgustos[aleatorio.entero(NUM_DISGUSTOS)] + " con " + temas[aleatorio.entero(NUM_COSAS)] + " quiero " + compensaciones[aleatorio.entero(NUM_RAZONES)];
 }
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Cliente.h"
+
+// Totales agregados de un conjunto de clientes; los parciales se combinan con 'combinar'
+struct ReporteBanco : public IDebugable, IShowable
+{
+	size_t clientes = 0;
+	size_t cuentas = 0;
+	size_t depositos = 0;             // Nmero de depsitos en los historiales
+	size_t retiros = 0;               // Nmero de retiros en los historiales
+	long long totalDepositos = 0;     // Cntimos depositados
+	long long totalRetiros = 0;       // Cntimos retirados
+	long long saldoTotal = 0;         // Suma de los saldos actuales en cntimos
+
+	void agregarCuenta(const Cuenta& cuenta);
+	void agregarCliente(Cliente& cliente);
+	void combinar(const ReporteBanco& otro);
+
+	string toDebug() const override;
+	string toShow() const override;
+};
+
+void ReporteBanco::agregarCuenta(const Cuenta& cuenta)
+{
+	// Saldo y movimientos del mismo instante: el reporte cuadra aunque se siga operando
+	InstantaneaCuenta instantanea = cuenta.getInstantanea();
+	++cuentas;
+	saldoTotal += instantanea.saldo;
+	cuenta.recorrerHistorial(instantanea, [this](const RegistroTransaccion& registro) {
+		long long centimos = registro.centimos;
+		if (registro.getTipo() == TipoTransaccion::Deposito)
+		{
+			++depositos;
+			totalDepositos += centimos;
+		}
+		else if (registro.getTipo() == TipoTransaccion::Retiro)
+		{
+			++retiros;
+			totalRetiros += centimos;
+		}
+		});
+}
+
+void ReporteBanco::agregarCliente(Cliente& cliente)
+{
+	++clientes;
+	cliente.aplicarCuentas([this](Cuenta& cuenta) {
+		agregarCuenta(cuenta);
+		});
+}
+
+void ReporteBanco::combinar(const ReporteBanco& otro)
+{
+	clientes += otro.clientes;
+	cuentas += otro.cuentas;
+	depositos += otro.depositos;
+	retiros += otro.retiros;
+	totalDepositos += otro.totalDepositos;
+	totalRetiros += otro.totalRetiros;
+	saldoTotal += otro.saldoTotal;
+}
+
+string ReporteBanco::toDebug() const
+{
+	ostringstream debug;
+	debug << "ReporteBanco(clientes=" << clientes
+		<< ", cuentas=" << cuentas
+		<< ", depositos=" << depositos
+		<< ", retiros=" << retiros
+		<< ", totalDepositos=" << totalDepositos
+		<< ", totalRetiros=" << totalRetiros
+		<< ", saldoTotal=" << saldoTotal << ")";
+	return debug.str();
+}
+
+string ReporteBanco::toShow() const
+{
+	Monto depositado, retirado, saldo;
+	depositado.setTotalCentimos(totalDepositos);
+	retirado.setTotalCentimos(totalRetiros);
+	saldo.setTotalCentimos(saldoTotal);
+
+	ostringstream show;
+	show << "=== Reporte del Banco ===\n"
+		<< "Clientes: " << clientes << '\n'
+		<< "Cuentas: " << cuentas << '\n'
+		<< "Total Depositos: " << depositado.toString() << " (" << depositos << ")\n"
+		<< "Total Retiros: " << retirado.toString() << " (" << retiros << ")\n"
+		<< "Saldo Total: " << saldo.toString() << '\n';
+	return show.str();
+}
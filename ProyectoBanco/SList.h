@@ -1,6 +1,8 @@
 #pragma once
 
 #include "SNode.h"
+#include "Aleatorio.h"
+#include "Memoria.h"
 #include <functional>
 #include <iterator>
 
@@ -17,6 +19,12 @@ public:
     // Constructor por defecto, inicializa una lista vaca
     SList();
 
+    // Constructor de copia, duplica los nodos de otra lista
+    SList(const SList<C>& other);
+
+    // Operador de asignacin, reemplaza el contenido por una copia de otra lista
+    SList<C>& operator=(const SList<C>& other);
+
     // Destructor, limpia la lista liberando la memoria
     ~SList();
 
@@ -87,6 +95,24 @@ public:
 template<class C>
 SList<C>::SList() : head(nullptr), tail(nullptr), length(0) {}
 
+template<class C>
+SList<C>::SList(const SList<C>& other) : head(nullptr), tail(nullptr), length(0) {
+    for (const auto& elem : other) {
+        pushBack(elem);
+    }
+}
+
+template<class C>
+SList<C>& SList<C>::operator=(const SList<C>& other) {
+    if (this != &other) {
+        clear();
+        for (const auto& elem : other) {
+            pushBack(elem);
+        }
+    }
+    return *this;
+}
+
 template<class C>
 SList<C>::~SList() {
     clear();
@@ -104,6 +130,7 @@ size_t SList<C>::size() const {
 
 template<class C>
 void SList<C>::pushFront(const C& data) {
+    ZonaMemoria zona(Subsistema::Contenedores, false);
     // Crear el nuevo nodo con el siguiente nodo apuntando a la cabeza actual
     SNode<C>* newNode = new SNode<C>(data, head);
 
@@ -121,6 +148,7 @@ void SList<C>::pushFront(const C& data) {
 
 template<class C>
 void SList<C>::pushBack(const C& data) {
+    ZonaMemoria zona(Subsistema::Contenedores, false);
     // Crear el nuevo nodo con el siguiente nodo apuntando a nullptr (ser el ltimo)
     SNode<C>* newNode = new SNode<C>(data, nullptr);
 
@@ -226,7 +254,7 @@ void SList<C>::shuffle() {
         }
 
         // Generar posicin aleatoria j
-        size_t j = rand() % (i + 1);
+        size_t j = Aleatorio::delHilo().entero(static_cast<uint32_t>(i + 1));
 
         // Encontrar nodo en posicin j
         SNode<C>* jNode = head;
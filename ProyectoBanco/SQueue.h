@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SNode.h"
+#include "Memoria.h"
 #include <iterator>
 #include <functional>
 
@@ -14,6 +15,8 @@ private:
 
 public:
     SQueue();
+    SQueue(const SQueue<C>& other);
+    SQueue<C>& operator=(const SQueue<C>& other);
     ~SQueue();
 
     bool empty() const;
@@ -49,6 +52,29 @@ public:
 template<class C>
 SQueue<C>::SQueue() : head(nullptr), tail(nullptr), length(0) {}
 
+template<class C>
+SQueue<C>::SQueue(const SQueue<C>& other) : head(nullptr), tail(nullptr), length(0)
+{
+    for (const auto& elem : other)
+    {
+        push(elem);
+    }
+}
+
+template<class C>
+SQueue<C>& SQueue<C>::operator=(const SQueue<C>& other)
+{
+    if (this != &other)
+    {
+        clear();
+        for (const auto& elem : other)
+        {
+            push(elem);
+        }
+    }
+    return *this;
+}
+
 template<class C>
 SQueue<C>::~SQueue()
 {
@@ -70,6 +96,7 @@ size_t SQueue<C>::size() const
 template<class C>
 void SQueue<C>::push(const C& data)
 {
+    ZonaMemoria zona(Subsistema::Contenedores, false);
     SNode<C>* newNode = new SNode<C>(data, nullptr);
     if (empty())
     {
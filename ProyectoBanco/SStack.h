@@ -1,6 +1,7 @@
 #pragma once
 
 #include "SNode.h"
+#include "Memoria.h"
 #include <iterator>
 #include <functional>
 
@@ -14,6 +15,7 @@ private:
 public:
     SStack();
     SStack(const SStack<C>& other);
+    SStack<C>& operator=(const SStack<C>& other);
     ~SStack();
 
     bool empty() const;
@@ -67,6 +69,33 @@ SStack<C>::SStack(const SStack<C>& other) : head(nullptr), length(0) {
     length = other.length;
 }
 
+template<class C>
+SStack<C>& SStack<C>::operator=(const SStack<C>& other)
+{
+    if (this != &other)
+    {
+        clear();
+
+        SNode<C>* current = other.head;
+        SNode<C>* prev = nullptr;
+
+        while (current != nullptr) {
+            SNode<C>* newNode = new SNode<C>(current->getData());
+            if (prev == nullptr) {
+                head = newNode;
+            }
+            else {
+                prev->setNext(newNode);
+            }
+            prev = newNode;
+            current = current->getNext();
+        }
+
+        length = other.length;
+    }
+    return *this;
+}
+
 
 template<class C>
 SStack<C>::~SStack()
@@ -89,6 +118,7 @@ size_t SStack<C>::size() const
 template<class C>
 void SStack<C>::push(const C& data)
 {
+    ZonaMemoria zona(Subsistema::Contenedores, false);
     head = new SNode<C>(data, head);
     ++length;
 }
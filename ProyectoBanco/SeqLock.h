@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// Cerrojo de secuencia: los escritores se excluyen entre s y los lectores nunca bloquean.
+//
+// La secuencia es impar mientras hay una escritura en curso. Un lector toma la secuencia al
+// empezar (esperando a que sea par), lee los datos protegidos y comprueba al final que no
+// cambi; si cambi, vuelve a leer. Los datos protegidos deben ser atmicos (o inmutables),
+// porque el lector puede leerlos mientras se escriben.
+class SeqLock
+{
+private:
+	std::atomic<uint64_t> secuencia;
+
+public:
+	SeqLock();
+	// La secuencia pertenece a cada objeto: copiar no copia el estado del cerrojo
+	SeqLock(const SeqLock&);
+	SeqLock& operator=(const SeqLock&);
+
+	void bloquearEscritura();
+	void liberarEscritura();
+
+	// Secuencia par con la que empieza una lectura
+	uint64_t iniciarLectura() const;
+	// true si no hubo escrituras desde iniciarLectura
+	bool validarLectura(uint64_t inicio) const;
+
+	// Bloquea la escritura durante su alcance
+	class Escritura
+	{
+	private:
+		SeqLock& cerrojo;
+
+	public:
+		Escritura(SeqLock& cerrojo) : cerrojo(cerrojo) { cerrojo.bloquearEscritura(); }
+		~Escritura() { cerrojo.liberarEscritura(); }
+
+		Escritura(const Escritura&) = delete;
+		Escritura& operator=(const Escritura&) = delete;
+	};
+};
+
+SeqLock::SeqLock() : secuencia(0)
+{}
+
+SeqLock::SeqLock(const SeqLock&) : secuencia(0)
+{}
+
+SeqLock& SeqLock::operator=(const SeqLock&)
+{
+	return *this;
+}
+
+void SeqLock::bloquearEscritura()
+{
+	uint64_t actual = secuencia.load(std::memory_order_relaxed);
+	while (true)
+	{
+		if ((actual & 1) == 0 &&
+			secuencia.compare_exchange_weak(actual, actual + 1, std::memory_order_acquire, std::memory_order_relaxed))
+		{
+			break;
+		}
+		std::this_thread::yield();
+		actual = secuencia.load(std::memory_order_relaxed);
+	}
+	// Las escrituras de los datos no pueden adelantarse al cambio a impar
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SeqLock::liberarEscritura()
+{
+	secuencia.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t SeqLock::iniciarLectura() const
+{
+	uint64_t inicio = secuencia.load(std::memory_order_acquire);
+	while (inicio & 1)
+	{
+		std::this_thread::yield();
+		inicio = secuencia.load(std::memory_order_acquire);
+	}
+	return inicio;
+}
+
+bool SeqLock::validarLectura(uint64_t inicio) const
+{
+	// Las lecturas de los datos no pueden retrasarse ms all de esta comprobacin
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return secuencia.load(std::memory_order_relaxed) == inicio;
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "Serialization.h"
+#include "PoolCadenas.h"
+#include "NumeroFijo.h"
+#include <concepts>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+using namespace std;
+
+// Nombres con que se guarda cada valor de un enum, en el orden del enum. Se especializa junto al enum;
+// al cargar, un texto que no coincide con ninguno toma el ltimo valor (el "Desconocido")
+template<class E>
+struct NombresEnum;
+
+// Campo de un esquema: nombre (para depurar), miembro y, opcionalmente, el setter que lo valida al cargar
+template<class T, class V, class S = nullptr_t>
+struct Campo
+{
+	const char* nombre;
+	V T::* miembro;
+	S asignar;
+};
+
+template<class T, class V>
+constexpr Campo<T, V> campo(const char* nombre, V T::* miembro);
+template<class T, class V, class S>
+constexpr Campo<T, V, S> campo(const char* nombre, V T::* miembro, S asignar);
+
+// Campos de una clase en el orden en que se guardan, separados por 'delimitador'
+template<class... Cs>
+struct Esquema
+{
+	const char* nombre;
+	char delimitador;
+	tuple<Cs...> campos;
+};
+
+template<class... Cs>
+constexpr Esquema<Cs...> crearEsquema(const char* nombre, char delimitador, Cs... campos);
+
+// Clases que declaran sus campos una sola vez con 'static constexpr auto esquema()'
+template<class T>
+concept ConEsquema = requires { T::esquema().nombre; T::esquema().delimitador; T::esquema().campos; };
+
+// Tipos valor que se guardan con su propio toSave/load (Fecha, Monto, ...)
+template<class V>
+concept Guardable = requires(const V& valor, V& destino, const string& datos) {
+	{ valor.toSave() } -> convertible_to<string>;
+	destino.load(datos);
+};
+
+// Como getline sobre 'datos' desde 'posicion': deja en 'campo' el texto hasta 'delimitador' (o el
+// final) y avanza 'posicion' tras l. Retorna false si no queda nada que leer
+bool leerCampo(string_view datos, size_t& posicion, char delimitador, string_view& campo);
+
+// Conversin de un campo a texto y de vuelta segn su tipo; leer retorna false si el texto no es
+// un valor vlido del tipo (los tipos sin formato propio aceptan cualquier texto)
+namespace Codificacion
+{
+	void escribir(string& destino, const string& valor);
+	bool leer(string_view texto, string& valor);
+	void escribir(string& destino, const CadenaInterna& valor);
+	bool leer(string_view texto, CadenaInterna& valor);
+
+	template<size_t DIGITOS>
+	void escribir(string& destino, const NumeroFijo<DIGITOS>& valor);
+	template<size_t DIGITOS>
+	bool leer(string_view texto, NumeroFijo<DIGITOS>& valor);
+
+	template<class E> requires is_enum_v<E>
+	void escribir(string& destino, E valor);
+	template<class E> requires is_enum_v<E>
+	bool leer(string_view texto, E& valor);
+
+	template<Guardable V>
+	void escribir(string& destino, const V& valor);
+	template<Guardable V>
+	bool leer(string_view texto, V& valor);
+}
+
+// Serializacin generada en tiempo de compilacin a partir del esquema de 'Derivada' (CRTP).
+// Las llamadas se resuelven estticamente y escriben directo en un string, sin ostringstream;
+// los toSave/load/toDebug virtuales de la clase delegan aqu y quedan para el cdigo interactivo.
+// El formato es el mismo que el de los toSave escritos a mano: los campos separados por el
+// delimitador del esquema, sin delimitador final.
+template<class Derivada>
+class Serializable
+{
+private:
+	template<class C>
+	void _cargarCampo(string_view datos, size_t& posicion, const C& campo);
+
+public:
+	// Agrega los campos al final de 'destino'
+	void guardarEn(string& destino) const;
+	string guardar() const;
+	// Carga los campos validndolos con los setters del esquema; lanza runtime_error si faltan o
+	// alguno es invlido. Como getline, ignora lo que siga al ltimo campo
+	void cargar(string_view datos);
+	// "Nombre(campo='valor', ...)"
+	string depurar() const;
+};
+
+template<class T, class V>
+constexpr Campo<T, V> campo(const char* nombre, V T::* miembro)
+{
+	return { nombre, miembro, nullptr };
+}
+
+template<class T, class V, class S>
+constexpr Campo<T, V, S> campo(const char* nombre, V T::* miembro, S asignar)
+{
+	return { nombre, miembro, asignar };
+}
+
+template<class... Cs>
+constexpr Esquema<Cs...> crearEsquema(const char* nombre, char delimitador, Cs... campos)
+{
+	return { nombre, delimitador, tuple<Cs...>(campos...) };
+}
+
+bool leerCampo(string_view datos, size_t& posicion, char delimitador, string_view& campo)
+{
+	if (posicion >= datos.size())
+	{
+		return false;
+	}
+	size_t fin = datos.find(delimitador, posicion);
+	if (fin == string_view::npos)
+	{
+		fin = datos.size();
+	}
+	campo = datos.substr(posicion, fin - posicion);
+	posicion = fin + 1;
+	return true;
+}
+
+void Codificacion::escribir(string& destino, const string& valor)
+{
+	destino += valor;
+}
+
+bool Codificacion::leer(string_view texto, string& valor)
+{
+	valor.assign(texto.data(), texto.size());
+	return true;
+}
+
+void Codificacion::escribir(string& destino, const CadenaInterna& valor)
+{
+	destino += valor.str();
+}
+
+bool Codificacion::leer(string_view texto, CadenaInterna& valor)
+{
+	valor = texto;
+	return true;
+}
+
+template<size_t DIGITOS>
+void Codificacion::escribir(string& destino, const NumeroFijo<DIGITOS>& valor)
+{
+	valor.escribirEn(destino);
+}
+
+template<size_t DIGITOS>
+bool Codificacion::leer(string_view texto, NumeroFijo<DIGITOS>& valor)
+{
+	return valor.asignar(texto);
+}
+
+template<class E> requires is_enum_v<E>
+void Codificacion::escribir(string& destino, E valor)
+{
+	destino += NombresEnum<E>::nombres[static_cast<size_t>(valor)];
+}
+
+template<class E> requires is_enum_v<E>
+bool Codificacion::leer(string_view texto, E& valor)
+{
+	constexpr size_t cantidad = size(NombresEnum<E>::nombres);
+	for (size_t i = 0; i < cantidad; ++i)
+	{
+		if (texto == NombresEnum<E>::nombres[i])
+		{
+			valor = static_cast<E>(i);
+			return true;
+		}
+	}
+	valor = static_cast<E>(cantidad - 1);
+	return true;
+}
+
+template<Guardable V>
+void Codificacion::escribir(string& destino, const V& valor)
+{
+	destino += valor.toSave();
+}
+
+template<Guardable V>
+bool Codificacion::leer(string_view texto, V& valor)
+{
+	valor.load(string(texto));
+	return true;
+}
+
+template<class Derivada>
+void Serializable<Derivada>::guardarEn(string& destino) const
+{
+	static_assert(ConEsquema<Derivada>, "La clase debe declarar 'static constexpr auto esquema()'");
+	constexpr auto descripcion = Derivada::esquema();
+	const Derivada& objeto = static_cast<const Derivada&>(*this);
+	bool primero = true;
+	apply([&](const auto&... campos) {
+		((primero ? void(primero = false) : void(destino += descripcion.delimitador),
+			Codificacion::escribir(destino, objeto.*campos.miembro)), ...);
+		}, descripcion.campos);
+}
+
+template<class Derivada>
+string Serializable<Derivada>::guardar() const
+{
+	string destino;
+	guardarEn(destino);
+	return destino;
+}
+
+template<class Derivada>
+template<class C>
+void Serializable<Derivada>::_cargarCampo(string_view datos, size_t& posicion, const C& campo)
+{
+	constexpr auto descripcion = Derivada::esquema();
+	string_view texto;
+	if (!leerCampo(datos, posicion, descripcion.delimitador, texto))
+	{
+		throw runtime_error(string("Error al cargar ") + descripcion.nombre + ": falta el campo " + campo.nombre + ".");
+	}
+
+	Derivada& objeto = static_cast<Derivada&>(*this);
+	bool valido = Codificacion::leer(texto, objeto.*campo.miembro);
+
+	// El setter valida el valor ledo y lo vuelve a asignar
+	if constexpr (!is_same_v<remove_cvref_t<decltype(campo.asignar)>, nullptr_t>)
+	{
+		valido = valido && (objeto.*campo.asignar)(objeto.*campo.miembro);
+	}
+	if (!valido)
+	{
+		throw runtime_error(string("Error al cargar ") + descripcion.nombre + ": campo " + campo.nombre + " invlido.");
+	}
+}
+
+template<class Derivada>
+void Serializable<Derivada>::cargar(string_view datos)
+{
+	static_assert(ConEsquema<Derivada>, "La clase debe declarar 'static constexpr auto esquema()'");
+	constexpr auto descripcion = Derivada::esquema();
+	size_t posicion = 0;
+	apply([&](const auto&... campos) {
+		(_cargarCampo(datos, posicion, campos), ...);
+		}, descripcion.campos);
+}
+
+template<class Derivada>
+string Serializable<Derivada>::depurar() const
+{
+	static_assert(ConEsquema<Derivada>, "La clase debe declarar 'static constexpr auto esquema()'");
+	constexpr auto descripcion = Derivada::esquema();
+	const Derivada& objeto = static_cast<const Derivada&>(*this);
+	string debug = string(descripcion.nombre) + '(';
+	bool primero = true;
+	apply([&](const auto&... campos) {
+		((debug += primero ? "" : ", ", primero = false,
+			debug += campos.nombre, debug += "='",
+			Codificacion::escribir(debug, objeto.*campos.miembro), debug += '\''), ...);
+		}, descripcion.campos);
+	return debug + ')';
+}
@@ -0,0 +1,459 @@
+#pragma once
+
+#include "MGeneral.h"
+#include "MQuejas.h"
+#include "Memoria.h"
+#include <atomic>
+#include <charconv>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Servicio de cuentas por socket local (Unix o TCP en 127.0.0.1) atendido por un solo hilo
+// con epoll. Las conexiones no bloquean: cada una acumula lo recibido, responde cada lnea
+// completa en orden y enva las respuestas cuando el socket lo admite.
+//
+// Protocolo: una peticin por lnea, campos separados por espacios, montos en cntimos.
+//   S cuenta                   Saldo                -> OK saldo
+//   D cuenta monto             Depsito             -> OK saldo
+//   R cuenta monto             Retiro               -> OK saldo
+//   T origen destino monto     Transferencia        -> OK saldoOrigen
+//   Q cliente|descripcion      Queja                -> OK
+//   L n                        Hasta n cuentas      -> OK cuenta cuenta ...
+//   M [filtro]                 Mtricas             -> OK nombre=cantidad[/p50/p99/p999] ...
+//   A                          Memoria              -> OK subsistema=bytesVivos/bloquesVivos/asignaciones ...
+// Si la peticin falla se responde "ER motivo". Una lnea de ms de LONGITUD_MAXIMA_LINEA bytes
+// se responde con "ER linea demasiado larga" y se cierra la conexin; mientras una conexin
+// tenga ms de LIMITE_SALIDA bytes de respuestas sin enviar no se le lee nada ms.
+//
+// Direcciones: "unix:/ruta/al/socket" o "tcp:puerto".
+class ServidorBanco
+{
+private:
+	struct Conexion
+	{
+		string entrada;     // Recibido y an no procesado
+		string salida;      // Respuestas an no enviadas
+		size_t enviado = 0; // Bytes de 'salida' ya enviados
+	};
+
+	static constexpr size_t LONGITUD_MAXIMA_LINEA = 4096;
+	static constexpr size_t LIMITE_SALIDA = 1 << 20;
+
+	MGeneral& registro;
+	MQuejas& quejas;
+	atomic<bool> detenido;
+	atomic<size_t> atendidas;
+
+	static string _error(const string& motivo);
+	static bool _leerMonto(istream& in, Monto& monto);
+
+#ifdef __linux__
+	// Enva lo pendiente de la conexin; false si se cerr o fall
+	static bool _enviar(int fd, Conexion& conexion);
+#endif
+	// Responde cada lnea completa de 'entrada'; false si hay una lnea demasiado larga
+	bool _procesarEntrada(Conexion& conexion);
+
+public:
+	ServidorBanco(MGeneral& registro, MQuejas& quejas);
+
+	ServidorBanco(const ServidorBanco&) = delete;
+	ServidorBanco& operator=(const ServidorBanco&) = delete;
+
+	// Atiende una peticin (sin el salto de lnea) y retorna la respuesta (sin el salto de lnea)
+	string responder(const string& peticion);
+
+	// Escucha en 'direccion' y atiende conexiones hasta que se llame a detener(); retorna
+	// distinto de 0 si no se pudo abrir el socket o el sistema no es Linux
+	int ejecutar(const string& direccion);
+	// Seguro desde otro hilo; el bucle termina en a lo sumo 100 ms
+	void detener();
+	size_t getAtendidas() const;
+
+#ifdef __linux__
+	// Socket no bloqueante para 'direccion': escuchando si 'escuchar', si no conectado.
+	// Retorna -1 (y escribe el motivo en cerr) si falla
+	static int abrirSocket(const string& direccion, bool escuchar);
+#endif
+};
+
+constexpr size_t ServidorBanco::LONGITUD_MAXIMA_LINEA;
+constexpr size_t ServidorBanco::LIMITE_SALIDA;
+
+ServidorBanco::ServidorBanco(MGeneral& registro, MQuejas& quejas)
+	: registro(registro), quejas(quejas), detenido(false), atendidas(0)
+{}
+
+string ServidorBanco::_error(const string& motivo)
+{
+	return "ER " + motivo;
+}
+
+bool ServidorBanco::_leerMonto(istream& in, Monto& monto)
+{
+	long long centimos;
+	if (!(in >> centimos) || centimos <= 0)
+	{
+		return false;
+	}
+	return monto.setTotalCentimos(centimos);
+}
+
+bool ServidorBanco::_procesarEntrada(Conexion& conexion)
+{
+	size_t inicio = 0, fin;
+	while ((fin = conexion.entrada.find('\n', inicio)) != string::npos)
+	{
+		size_t largo = fin - inicio;
+		if (largo > LONGITUD_MAXIMA_LINEA)
+		{
+			return false;
+		}
+		if (largo > 0 && conexion.entrada[fin - 1] == '\r')
+		{
+			--largo;
+		}
+		conexion.salida += responder(conexion.entrada.substr(inicio, largo));
+		conexion.salida += '\n';
+		inicio = fin + 1;
+	}
+	conexion.entrada.erase(0, inicio);
+	return conexion.entrada.size() <= LONGITUD_MAXIMA_LINEA;
+}
+
+string ServidorBanco::responder(const string& peticion)
+{
+	static Histograma latencia("ServidorBanco.responder");
+	Cronometro cronometro(latencia);
+	++atendidas;
+	istringstream in(peticion);
+	char comando = 0;
+	in >> comando;
+
+	switch (comando)
+	{
+	case 'S':
+	case 'D':
+	case 'R':
+	{
+		string numero;
+		in >> numero;
+		Cuenta* cuenta = registro.getCuenta(numero);
+		if (cuenta == nullptr)
+		{
+			return _error("cuenta inexistente");
+		}
+		if (comando != 'S')
+		{
+			Monto monto;
+			if (!_leerMonto(in, monto))
+			{
+				return _error("monto invalido");
+			}
+			bool aplicada = (comando == 'D')
+				? cuenta->depositar(registro.getFechaActual(), monto)
+				: cuenta->retirar(registro.getFechaActual(), monto);
+			if (!aplicada)
+			{
+				return _error("operacion rechazada");
+			}
+		}
+		return "OK " + to_string(cuenta->getSaldoCentimos());
+	}
+	case 'T':
+	{
+		string origen, destino;
+		Monto monto;
+		in >> origen >> destino;
+		if (!_leerMonto(in, monto))
+		{
+			return _error("monto invalido");
+		}
+		if (!registro.transferir(origen, destino, monto))
+		{
+			return _error("transferencia rechazada");
+		}
+		return "OK " + to_string(registro.getCuenta(origen)->getSaldoCentimos());
+	}
+	case 'Q':
+	{
+		string texto;
+		getline(in >> ws, texto);
+		size_t separador = texto.find('|');
+		if (separador == string::npos ||
+			!quejas.registrarQueja(texto.substr(0, separador), texto.substr(separador + 1)))
+		{
+			return _error("queja invalida");
+		}
+		return "OK";
+	}
+	case 'L':
+	{
+		size_t limite = 0;
+		in >> limite;
+		string respuesta = "OK";
+		size_t agregadas = 0;
+		for (Cliente* cliente : registro.getClientes())
+		{
+			if (agregadas >= limite)
+			{
+				break;
+			}
+			cliente->aplicarCuentas([&](Cuenta& cuenta) {
+				if (agregadas < limite)
+				{
+					respuesta += ' ' + cuenta.getNumeroCuenta();
+					++agregadas;
+				}
+				});
+		}
+		return respuesta;
+	}
+	case 'M':
+	{
+		string filtro;
+		in >> filtro;
+		string metricas = Metricas::global().volcarLinea(filtro);
+		return metricas.empty() ? "OK" : "OK " + metricas;
+	}
+	case 'A':
+		return Memoria::getActiva() ? "OK " + Memoria::volcarLinea() : _error("sin contabilidad de memoria");
+	}
+	return _error("comando desconocido");
+}
+
+void ServidorBanco::detener()
+{
+	detenido = true;
+}
+
+size_t ServidorBanco::getAtendidas() const
+{
+	return atendidas;
+}
+
+#ifdef __linux__
+
+int ServidorBanco::abrirSocket(const string& direccion, bool escuchar)
+{
+	int fd = -1;
+	int resultado = -1;
+	if (direccion.compare(0, 5, "unix:") == 0)
+	{
+		string ruta = direccion.substr(5);
+		sockaddr_un dir{};
+		if (ruta.empty() || ruta.size() >= sizeof(dir.sun_path))
+		{
+			cerr << "Ruta de socket invalida: " << ruta << '\n';
+			return -1;
+		}
+		dir.sun_family = AF_UNIX;
+		strcpy(dir.sun_path, ruta.c_str());
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (fd >= 0 && escuchar)
+		{
+			unlink(ruta.c_str()); // Socket de una ejecucin anterior
+			resultado = ::bind(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+		}
+		else if (fd >= 0)
+		{
+			resultado = connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+		}
+	}
+	else if (direccion.compare(0, 4, "tcp:") == 0)
+	{
+		string textoPuerto = direccion.substr(4);
+		unsigned puerto = 0;
+		auto lectura = from_chars(textoPuerto.data(), textoPuerto.data() + textoPuerto.size(), puerto);
+		if (textoPuerto.empty() || lectura.ec != errc() || lectura.ptr != textoPuerto.data() + textoPuerto.size()
+			|| puerto == 0 || puerto > 65535)
+		{
+			cerr << "Puerto invalido (se esperaba un numero entre 1 y 65535): " << textoPuerto << '\n';
+			return -1;
+		}
+		sockaddr_in dir{};
+		dir.sin_family = AF_INET;
+		dir.sin_port = htons(static_cast<uint16_t>(puerto));
+		dir.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		fd = socket(AF_INET, SOCK_STREAM, 0);
+		int uno = 1;
+		if (fd >= 0 && escuchar)
+		{
+			setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+			resultado = ::bind(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+		}
+		else if (fd >= 0)
+		{
+			// Peticiones pequeas: enviarlas sin esperar a juntar ms
+			setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+			resultado = connect(fd, reinterpret_cast<sockaddr*>(&dir), sizeof(dir));
+		}
+	}
+	else
+	{
+		cerr << "Direccion invalida (se esperaba unix:/ruta o tcp:puerto): " << direccion << '\n';
+		return -1;
+	}
+
+	if (resultado == 0 && escuchar)
+	{
+		resultado = listen(fd, SOMAXCONN);
+	}
+	if (resultado != 0)
+	{
+		cerr << "No se pudo " << (escuchar ? "escuchar en " : "conectar a ") << direccion << ": " << strerror(errno) << '\n';
+		if (fd >= 0)
+		{
+			close(fd);
+		}
+		return -1;
+	}
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	return fd;
+}
+
+bool ServidorBanco::_enviar(int fd, Conexion& conexion)
+{
+	while (conexion.enviado < conexion.salida.size())
+	{
+		ssize_t n = send(fd, conexion.salida.data() + conexion.enviado, conexion.salida.size() - conexion.enviado, MSG_NOSIGNAL);
+		if (n < 0)
+		{
+			return errno == EAGAIN || errno == EWOULDBLOCK;
+		}
+		conexion.enviado += n;
+	}
+	conexion.salida.clear();
+	conexion.enviado = 0;
+	return true;
+}
+
+int ServidorBanco::ejecutar(const string& direccion)
+{
+	int escucha = abrirSocket(direccion, true);
+	if (escucha < 0)
+	{
+		return 1;
+	}
+	int ep = epoll_create1(0);
+	epoll_event evento{};
+	evento.events = EPOLLIN;
+	evento.data.fd = escucha;
+	epoll_ctl(ep, EPOLL_CTL_ADD, escucha, &evento);
+
+	unordered_map<int, Conexion> conexiones;
+	auto cerrar = [&](int fd) {
+		epoll_ctl(ep, EPOLL_CTL_DEL, fd, nullptr);
+		close(fd);
+		conexiones.erase(fd);
+	};
+
+	vector<epoll_event> eventos(256);
+	char buffer[16384];
+	while (!detenido)
+	{
+		int listos = epoll_wait(ep, eventos.data(), static_cast<int>(eventos.size()), 100);
+		for (int i = 0; i < listos; ++i)
+		{
+			int fd = eventos[i].data.fd;
+			if (fd == escucha)
+			{
+				int nueva;
+				while ((nueva = accept4(escucha, nullptr, nullptr, SOCK_NONBLOCK)) >= 0)
+				{
+					int uno = 1;
+					setsockopt(nueva, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno)); // Sin efecto en sockets Unix
+					epoll_event registroEvento{};
+					registroEvento.events = EPOLLIN;
+					registroEvento.data.fd = nueva;
+					epoll_ctl(ep, EPOLL_CTL_ADD, nueva, &registroEvento);
+					conexiones[nueva];
+				}
+				continue;
+			}
+
+			Conexion& conexion = conexiones[fd];
+			bool abierta = true;
+			if (eventos[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+			{
+				// Leer lo disponible y responder cada lnea completa mientras el cliente
+				// vaya recibiendo las respuestas
+				while (conexion.salida.size() - conexion.enviado < LIMITE_SALIDA)
+				{
+					ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+					if (n <= 0)
+					{
+						abierta = (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+						break;
+					}
+					conexion.entrada.append(buffer, n);
+					if (!_procesarEntrada(conexion))
+					{
+						conexion.salida += _error("linea demasiado larga") + '\n';
+						abierta = false;
+						break;
+					}
+				}
+			}
+
+			if (!_enviar(fd, conexion) || !abierta)
+			{
+				cerrar(fd);
+				continue;
+			}
+			// Esperar a poder escribir solo mientras queden respuestas por enviar, y a poder
+			// leer solo mientras las pendientes no superen el lmite
+			epoll_event cambio{};
+			if (conexion.salida.size() - conexion.enviado < LIMITE_SALIDA)
+			{
+				cambio.events |= EPOLLIN;
+			}
+			if (!conexion.salida.empty())
+			{
+				cambio.events |= EPOLLOUT;
+			}
+			cambio.data.fd = fd;
+			epoll_ctl(ep, EPOLL_CTL_MOD, fd, &cambio);
+		}
+	}
+
+	while (!conexiones.empty())
+	{
+		cerrar(conexiones.begin()->first);
+	}
+	close(ep);
+	close(escucha);
+	if (direccion.compare(0, 5, "unix:") == 0)
+	{
+		unlink(direccion.substr(5).c_str());
+	}
+	return 0;
+}
+
+#else
+
+int ServidorBanco::ejecutar(const string& direccion)
+{
+	cerr << "El servidor solo esta disponible en Linux (" << direccion << ")\n";
+	return 1;
+}
+
+#endif
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <utility>
+
+// Corrutina sin valor de retorno usada por los mens interactivos.
+//
+// Empieza suspendida: la inicia quien la espera con co_await (que se reanuda cuando termina)
+// o, si es la corrutina principal de una sesin, iniciar(). Las excepciones se guardan y se
+// relanzan en quien la espera.
+class Tarea
+{
+public:
+	struct promise_type
+	{
+		std::coroutine_handle<> continuacion;
+		std::exception_ptr error;
+
+		Tarea get_return_object() { return Tarea(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		std::suspend_always initial_suspend() noexcept { return {}; }
+
+		// Al terminar se contina directamente con quien la esperaba (sin crecer la pila)
+		struct Final
+		{
+			bool await_ready() noexcept { return false; }
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+			{
+				std::coroutine_handle<> continuacion = handle.promise().continuacion;
+				return continuacion ? continuacion : std::noop_coroutine();
+			}
+			void await_resume() noexcept {}
+		};
+		Final final_suspend() noexcept { return {}; }
+
+		void return_void() {}
+		void unhandled_exception() { error = std::current_exception(); }
+	};
+
+private:
+	std::coroutine_handle<promise_type> handle;
+
+public:
+	explicit Tarea(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+	Tarea(Tarea&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+	Tarea& operator=(Tarea&& other) noexcept;
+	~Tarea();
+
+	Tarea(const Tarea&) = delete;
+	Tarea& operator=(const Tarea&) = delete;
+
+	// Ejecuta la corrutina principal hasta su primera espera de entrada (o hasta terminar)
+	void iniciar();
+	bool terminada() const;
+	// Relanza la excepcin con la que termin, si hubo alguna
+	void verificar() const;
+
+	// co_await sobre una Tarea: la inicia y suspende a quien espera hasta que termine
+	bool await_ready() const noexcept { return !handle || handle.done(); }
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> padre) noexcept;
+	void await_resume() const { verificar(); }
+};
+
+Tarea& Tarea::operator=(Tarea&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (handle)
+		{
+			handle.destroy();
+		}
+		handle = std::exchange(other.handle, nullptr);
+	}
+	return *this;
+}
+
+Tarea::~Tarea()
+{
+	if (handle)
+	{
+		handle.destroy();
+	}
+}
+
+void Tarea::iniciar()
+{
+	if (handle && !handle.done())
+	{
+		handle.resume();
+	}
+}
+
+bool Tarea::terminada() const
+{
+	return !handle || handle.done();
+}
+
+void Tarea::verificar() const
+{
+	if (handle && handle.promise().error)
+	{
+		std::rethrow_exception(handle.promise().error);
+	}
+}
+
+std::coroutine_handle<> Tarea::await_suspend(std::coroutine_handle<> padre) noexcept
+{
+	handle.promise().continuacion = padre;
+	return handle;
+}
+
+// Canal de texto entre un usuario y un men interactivo.
+//
+// Los mens piden lneas con co_await leerLinea() y escriben en out(). Con un flujo de entrada
+// (por ejemplo cin) la lectura es inmediata y bloqueante, como en una consola. Sin flujo, la
+// corrutina se suspende hasta que alguien entrega una lnea con entregar(); as un solo hilo
+// puede atender miles de sesiones intercalando sus entradas.
+class Sesion
+{
+private:
+	std::istream* entrada;               // nullptr si las lneas se entregan desde fuera
+	std::ostream& salida;
+	std::deque<std::string> lineas;      // Entregadas y an no ledas
+	bool finEntrada;
+	std::coroutine_handle<> esperando;   // Corrutina suspendida en leerLinea
+
+	void _reanudar();
+
+public:
+	// Sesin de consola: lee de 'entrada' bloqueando
+	Sesion(std::istream& entrada, std::ostream& salida);
+	// Sesin alimentada con entregar()
+	Sesion(std::ostream& salida);
+
+	Sesion(const Sesion&) = delete;
+	Sesion& operator=(const Sesion&) = delete;
+
+	std::ostream& out();
+
+	// Agrega una lnea de entrada y reanuda la corrutina si la esperaba
+	void entregar(const std::string& linea);
+	// Marca el fin de la entrada: las lecturas pendientes y siguientes retornan vaco
+	void cerrarEntrada();
+	bool esperandoEntrada() const;
+
+	// co_await sesion.leerLinea() retorna la siguiente lnea, o nada si termin la entrada
+	class LecturaLinea
+	{
+	private:
+		Sesion& sesion;
+
+	public:
+		LecturaLinea(Sesion& sesion) : sesion(sesion) {}
+		bool await_ready();
+		void await_suspend(std::coroutine_handle<> handle);
+		std::optional<std::string> await_resume();
+	};
+
+	LecturaLinea leerLinea();
+
+	// Convierte una lnea completa a 'valor'; false si sobra texto o no tiene el formato
+	template<class T>
+	static bool convertir(const std::string& linea, T& valor);
+};
+
+Sesion::Sesion(std::istream& entrada, std::ostream& salida)
+	: entrada(&entrada), salida(salida), finEntrada(false)
+{}
+
+Sesion::Sesion(std::ostream& salida)
+	: entrada(nullptr), salida(salida), finEntrada(false)
+{}
+
+std::ostream& Sesion::out()
+{
+	return salida;
+}
+
+void Sesion::_reanudar()
+{
+	if (esperando)
+	{
+		std::coroutine_handle<> handle = std::exchange(esperando, nullptr);
+		handle.resume();
+	}
+}
+
+void Sesion::entregar(const std::string& linea)
+{
+	lineas.push_back(linea);
+	_reanudar();
+}
+
+void Sesion::cerrarEntrada()
+{
+	finEntrada = true;
+	_reanudar();
+}
+
+bool Sesion::esperandoEntrada() const
+{
+	return static_cast<bool>(esperando);
+}
+
+bool Sesion::LecturaLinea::await_ready()
+{
+	if (!sesion.lineas.empty() || sesion.finEntrada)
+	{
+		return true;
+	}
+	if (sesion.entrada != nullptr)
+	{
+		// Consola: leer ahora mismo sin suspender
+		sesion.salida.flush();
+		std::string linea;
+		if (std::getline(*sesion.entrada, linea))
+		{
+			sesion.lineas.push_back(linea);
+		}
+		else
+		{
+			sesion.finEntrada = true;
+		}
+		return true;
+	}
+	return false;
+}
+
+void Sesion::LecturaLinea::await_suspend(std::coroutine_handle<> handle)
+{
+	sesion.esperando = handle;
+}
+
+std::optional<std::string> Sesion::LecturaLinea::await_resume()
+{
+	if (sesion.lineas.empty())
+	{
+		return std::nullopt;
+	}
+	std::string linea = std::move(sesion.lineas.front());
+	sesion.lineas.pop_front();
+	if (!linea.empty() && linea.back() == '\r')
+	{
+		linea.pop_back();
+	}
+	return linea;
+}
+
+Sesion::LecturaLinea Sesion::leerLinea()
+{
+	return LecturaLinea(*this);
+}
+
+template<class T>
+bool Sesion::convertir(const std::string& linea, T& valor)
+{
+	std::istringstream in(linea);
+	in >> valor;
+	if (in.fail())
+	{
+		return false;
+	}
+	in >> std::ws;
+	return in.eof();
+}
@@ -1,3 +1,4 @@
+#include "Aleatorio.h"
 #include "Fecha.h"
 #include "Monto.h"
 #include "Identidad.h"
@@ -10,12 +11,68 @@
 #include "MQuejas.h"
 #include "Cliente.h"
 #include "UCliente.h"
+#include "MGeneral.h"
+#include "MotorTransferencias.h"
+#include "ImportadorClientes.h"
+#include "ProcesadorLotes.h"
+#include "ActoresCuentas.h"
+#include "BloqueHistorial.h"
+#include "HistorialColumnar.h"
+#include "ConcurrentQueue.h"
+#include "ConcurrentStack.h"
+#include "Sesion.h"
+#include "MotorSesiones.h"
+#include "ServidorBanco.h"
+#include "GeneradorCarga.h"
+#include "GeneradorBanco.h"
+#include "Benchmark.h"
+#include "Metricas.h"
+#include "Memoria.h"
+#include <charconv>
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
-int main()
+#include <new>
+
+// Atribuye cada asignacin del proceso a un subsistema (ver Memoria.h); el servidor lo
+// reporta con el comando A
+MEMORIA_REEMPLAZAR_OPERADORES()
+
+int main(int argc, char* argv[])
 {
-	srand(time(NULL));
+	Aleatorio::delHilo().sembrar(time(NULL));
+	if (argc > 1 && string(argv[1]) == "--servidor")
+	{
+		// Servicio de cuentas: --servidor [unix:/ruta|tcp:puerto] [clientes]
+		string direccion = argc > 2 ? argv[2] : "unix:/tmp/ProyectoBanco.sock";
+		size_t clientes = 10000;
+		if (argc > 3)
+		{
+			string texto = argv[3];
+			auto lectura = from_chars(texto.data(), texto.data() + texto.size(), clientes);
+			if (texto.empty() || lectura.ec != errc() || lectura.ptr != texto.data() + texto.size() || clientes == 0)
+			{
+				cerr << "Cantidad de clientes invalida: " << argv[3] << '\n';
+				return 2;
+			}
+		}
+		MGeneral registro;
+		Benchmark::generarBanco(registro, clientes);
+		MQuejas quejas(registro.getFechaActual(), TipoUsuario::Cliente);
+		ServidorBanco servidor(registro, quejas);
+		cout << "Atendiendo " << registro.getNumeroCuentas() << " cuentas en " << direccion << endl;
+		return servidor.ejecutar(direccion);
+	}
+	if (argc > 1 && string(argv[1]) == "--sesiones")
+	{
+		// Mens de cliente multiplexados sobre la entrada y salida estndar ("id texto" por lnea)
+		return MotorSesiones::atender(cin, cout, []() {
+			shared_ptr<Cliente> cliente = make_shared<Cliente>();
+			cliente->generateRandom();
+			return MotorSesiones::Programa([cliente](Sesion& sesion) { return cliente->interactuar(sesion); });
+			});
+	}
+
 	Fecha f;
 	f.generateRandom();
 	cout << f.toDebug() << endl;
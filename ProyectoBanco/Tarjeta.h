@@ -4,6 +4,9 @@
 #include "Monto.h"
 #include "IRandomizable.h"
 #include "IShowable.h"
+#include "NumeroFijo.h"
+#include <atomic>
+#include <functional>
 
 class Tarjeta : public IDebugable, ISavable, IShowable, IRandomizable
 {
@@ -11,11 +14,11 @@ public:
     enum class EstadoTarjeta { Activa, Inactiva, Bloqueada, Desconocido };
 
 protected:
-    string numero;            // Nmero de la tarjeta
+    NumeroTarjeta numero;     // Nmero de la tarjeta (16 dgitos)
     Fecha fechaVencimiento;   // Fecha de vencimiento de la tarjeta
-    string cvv;               // Cdigo de verificacin de la tarjeta
-    EstadoTarjeta estado;     // Estado de la tarjeta
-    Monto saldo;              // Saldo de la tarjeta
+    CodigoCVV cvv;            // Cdigo de verificacin de la tarjeta (3 dgitos)
+    atomic<EstadoTarjeta> estado;   // Estado de la tarjeta
+    atomic<long long> saldo;        // Saldo de la tarjeta en cntimos (se modifica sin bloqueos)
 
 public:
     // Constructores
@@ -23,6 +26,8 @@ public:
         const string& cvv, const EstadoTarjeta& estado, const float& saldo);
     Tarjeta(const string& datos);  // Constructor que carga los datos desde una cadena
     Tarjeta();                     // Constructor por defecto
+    Tarjeta(const Tarjeta& other);
+    Tarjeta& operator=(const Tarjeta& other);
 
     // Destructor
     virtual ~Tarjeta() = default;
@@ -34,6 +39,7 @@ public:
     EstadoTarjeta getEstado() const;
     float getSaldoFloat() const;
     Monto getSaldoMonto() const;
+    long long getSaldoCentimos() const;
 
     // Mtodos de modificacin
     bool setNumero(const string& numero);
@@ -41,6 +47,7 @@ public:
     bool setCVV(const string& cvv);
     bool setEstado(const EstadoTarjeta& estado);
     bool setSaldo(const float& saldo);
+    bool setSaldoCentimos(long long saldo);
 
     // Mtodos de cambio de estado
     bool activar();
@@ -55,34 +62,58 @@ public:
     virtual string toShow() const override;
 
     // Mtodo para generar una tarjeta aleatoria
-    void generateRandom() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
 
-    // Mtodos especficos de la tarjeta de dbito
+    // Mtodos especficos de la tarjeta de dbito (seguros entre hilos)
     bool depositar(float monto);
     bool retirar(float monto);
+    bool depositar(const Monto& monto);
+    // Retira solo si el saldo alcanza; la verificacin y el descuento son una sola operacin atmica
+    bool retirar(const Monto& monto);
 };
 
 // Constructor con parmetros
 Tarjeta::Tarjeta(const string& numero, const Fecha& fechaVencimiento,
     const string& cvv, const EstadoTarjeta& estado, const float& saldo)
     : numero(numero), fechaVencimiento(fechaVencimiento), cvv(cvv),
-    estado(estado), saldo(Monto(saldo))
+    estado(estado), saldo(Monto(saldo).getTotalCentimos())
 {}
 
 // Constructor por defecto
 Tarjeta::Tarjeta()
-    : numero(""), fechaVencimiento(Fecha()), cvv(""), estado(EstadoTarjeta::Desconocido)
+    : numero(), fechaVencimiento(Fecha()), cvv(), estado(EstadoTarjeta::Desconocido), saldo(0)
 {}
 
 // Constructor que recibe una cadena
 Tarjeta::Tarjeta(const string& datos)
+    : estado(EstadoTarjeta::Desconocido), saldo(0)
 {
     load(datos);
 }
 
+// Constructor de copia (los atmicos no se copian solos)
+Tarjeta::Tarjeta(const Tarjeta& other)
+    : numero(other.numero), fechaVencimiento(other.fechaVencimiento), cvv(other.cvv),
+    estado(other.estado.load()), saldo(other.saldo.load())
+{}
+
+Tarjeta& Tarjeta::operator=(const Tarjeta& other)
+{
+    if (this != &other)
+    {
+        numero = other.numero;
+        fechaVencimiento = other.fechaVencimiento;
+        cvv = other.cvv;
+        estado.store(other.estado.load());
+        saldo.store(other.saldo.load());
+    }
+    return *this;
+}
+
 // Getters
 string Tarjeta::getNumero() const {
-    return numero;
+    return numero.toString();
 }
 
 Fecha Tarjeta::getFechaVencimiento() const {
@@ -90,7 +121,7 @@ Fecha Tarjeta::getFechaVencimiento() const {
 }
 
 string Tarjeta::getCVV() const {
-    return cvv;
+    return cvv.toString();
 }
 
 Tarjeta::EstadoTarjeta Tarjeta::getEstado() const
@@ -100,30 +131,25 @@ Tarjeta::EstadoTarjeta Tarjeta::getEstado() const
 
 float Tarjeta::getSaldoFloat() const
 {
-    return saldo.getMonto();
+    return getSaldoMonto().getMonto();
 }
 
 Monto Tarjeta::getSaldoMonto() const
 {
-    return saldo;
+    Monto monto;
+    monto.setTotalCentimos(saldo.load());
+    return monto;
+}
+
+long long Tarjeta::getSaldoCentimos() const
+{
+    return saldo.load();
 }
 
 // Setters
 bool Tarjeta::setNumero(const string& numero)
 {
-    if (numero.size() != 16)
-    {
-        return false;
-    }
-    for (char c : numero)
-    {
-        if (c < '0' || c > '9')
-        {
-            return false;
-        }
-    }
-    this->numero = numero;
-    return true; // Retorna falso si el nmero no es vlido
+    return this->numero.asignar(numero); // Retorna falso si el nmero no es vlido
 }
 
 bool Tarjeta::setFechaVencimiento(const Fecha& fecha)
@@ -133,19 +159,7 @@ bool Tarjeta::setFechaVencimiento(const Fecha& fecha)
 }
 
 bool Tarjeta::setCVV(const string& cvv) {
-    if (cvv.size() != 3)
-    {
-        return false;
-    }
-    for (char c : cvv)
-    {
-        if (c < '0' || c > '9')
-        {
-            return false;
-        }
-    }
-    this->cvv = cvv;
-    return true; // Retorna falso si el CVV no es vlido
+    return this->cvv.asignar(cvv); // Retorna falso si el CVV no es vlido
 }
 
 bool Tarjeta::setEstado(const EstadoTarjeta& estado) {
@@ -159,7 +173,22 @@ bool Tarjeta::setEstado(const EstadoTarjeta& estado) {
 
 bool Tarjeta::setSaldo(const float& saldo)
 {
-    return this->saldo.setMonto(saldo);
+    if (saldo < 0)
+    {
+        return false;
+    }
+    this->saldo.store(Monto(saldo).getTotalCentimos());
+    return true;
+}
+
+bool Tarjeta::setSaldoCentimos(long long saldo)
+{
+    if (saldo < 0)
+    {
+        return false;
+    }
+    this->saldo.store(saldo);
+    return true;
 }
 
 bool Tarjeta::activar()
@@ -183,7 +212,7 @@ bool Tarjeta::bloquear()
 // Retorna una representacin en cadena del estado
 string Tarjeta::toStringEstado() const
 {
-    switch (estado) {
+    switch (estado.load()) {
     case EstadoTarjeta::Activa: return "Activa";
     case EstadoTarjeta::Inactiva: return "Inactiva";
     case EstadoTarjeta::Bloqueada: return "Bloqueada";
@@ -203,30 +232,37 @@ string Tarjeta::toDebug() const {
 
 // Mtodo para guardar la informacin de la tarjeta
 string Tarjeta::toSave() const {
-    ostringstream out;
-    out << numero << Serialization::DELIMITER_FIELD
-        << fechaVencimiento.toStringDDMMAAAA() << Serialization::DELIMITER_FIELD
-        << cvv << Serialization::DELIMITER_FIELD
-        << toStringEstado() << Serialization::DELIMITER_FIELD
-        << saldo.toSave();
-    return out.str();
+    string out;
+    numero.escribirEn(out);
+    out += Serialization::DELIMITER_FIELD;
+    out += fechaVencimiento.toStringDDMMAAAA();
+    out += Serialization::DELIMITER_FIELD;
+    cvv.escribirEn(out);
+    out += Serialization::DELIMITER_FIELD;
+    out += toStringEstado();
+    out += Serialization::DELIMITER_FIELD;
+    out += getSaldoMonto().toSave();
+    return out;
 }
 
 void Tarjeta::load(const string& data)
 {
     istringstream in(data);
+    string numeroString;
     string fechaString;
+    string cvvString;
     string estadoString;
+    string saldoString;
 
-    if (!getline(in, numero, Serialization::DELIMITER_FIELD) ||
+    if (!getline(in, numeroString, Serialization::DELIMITER_FIELD) ||
         !getline(in, fechaString, Serialization::DELIMITER_FIELD) ||
-        !getline(in, cvv, Serialization::DELIMITER_FIELD) ||
+        !getline(in, cvvString, Serialization::DELIMITER_FIELD) ||
         !getline(in, estadoString, Serialization::DELIMITER_FIELD))
     {
         throw runtime_error("Error al cargar los datos: datos insuficientes o mal formateados.");
     }
 
-    if (!setNumero(numero) || !setCVV(cvv))
+    if (!setNumero(numeroString) || !setCVV(cvvString))
     {
         throw runtime_error("Datos de tarjeta invlidos");
     }
@@ -246,6 +282,11 @@ void Tarjeta::load(const string& data)
     else {
         estado = EstadoTarjeta::Desconocido;
     }
+
+    // El saldo es el ltimo campo guardado por toSave
+    if (getline(in, saldoString, Serialization::DELIMITER_FIELD) && !saldoString.empty()) {
+        saldo.store(Monto(saldoString).getTotalCentimos());
+    }
 }
 
 string Tarjeta::toShow() const
@@ -262,28 +303,28 @@ string Tarjeta::toShow() const
     return show.str();
 }
 
-void Tarjeta::generateRandom()
+void Tarjeta::generateRandom(Aleatorio& aleatorio)
 {
-    ostringstream numTarjeta;
     // Generar nmero de tarjeta (16 dgitos en grupos de 4)
+    uint64_t numTarjeta = 0;
     for (int i = 0; i < 16; i++) {
-        numTarjeta << rand() % 10;
+        numTarjeta = numTarjeta * 10 + aleatorio.entero(10);
     }
 
     // CVV (3 dgitos)
-    ostringstream cvvTarjeta;
+    uint64_t cvvTarjeta = 0;
     for (int i = 0; i < 3; i++) {
-        cvvTarjeta << rand() % 10;
+        cvvTarjeta = cvvTarjeta * 10 + aleatorio.entero(10);
     }
 
     Fecha fecha;
-    fecha.generateRandom();
-    fecha.setAnio(2024 + (rand() % 4 + 2));
+    fecha.generateRandom(aleatorio);
+    fecha.setAnio(2024 + (aleatorio.entero(4) + 2));
 
-    float saldoTarjeta(rand() % 10000);
+    float saldoTarjeta(aleatorio.entero(10000));
 
-    setNumero(numTarjeta.str());
-    setCVV(cvvTarjeta.str());
+    numero.setValor(numTarjeta);
+    cvv.setValor(cvvTarjeta);
     setFechaVencimiento(fecha);
     setEstado(Tarjeta::EstadoTarjeta::Activa);
     setSaldo(saldoTarjeta);
@@ -292,20 +333,41 @@ void Tarjeta::generateRandom()
 // Mtodos especficos de la tarjeta de dbito
 bool Tarjeta::depositar(float monto)
 {
-    if (estado != EstadoTarjeta::Activa || monto <= 0)
+    return monto > 0 && depositar(Monto(monto));
+}
+
+bool Tarjeta::retirar(float monto)
+{
+    return monto > 0 && retirar(Monto(monto));
+}
+
+bool Tarjeta::depositar(const Monto& monto)
+{
+    long long centimos = monto.getTotalCentimos();
+    if (estado.load() != EstadoTarjeta::Activa || centimos <= 0)
     {
         return false;
     }
-    saldo.setMonto(saldo.getMonto() + monto);
+    saldo.fetch_add(centimos);
     return true;
 }
 
-bool Tarjeta::retirar(float monto)
+bool Tarjeta::retirar(const Monto& monto)
 {
-    if (estado != EstadoTarjeta::Activa || monto <= 0 || saldo.getMonto() < monto)
+    long long centimos = monto.getTotalCentimos();
+    if (estado.load() != EstadoTarjeta::Activa || centimos <= 0)
     {
         return false;
     }
-    saldo.setMonto(saldo.getMonto() - monto);
+
+    // Si otro hilo cambi el saldo entre la lectura y el intercambio, se vuelve a verificar
+    long long actual = saldo.load();
+    do
+    {
+        if (actual < centimos)
+        {
+            return false;
+        }
+    } while (!saldo.compare_exchange_weak(actual, actual - centimos));
     return true;
 }
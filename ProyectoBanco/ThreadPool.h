@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Conjunto de hilos con robo de trabajo.
+//
+// Cada hilo tiene su propia cola: agrega y toma tareas por el final (las ms recientes, que
+// suelen tener sus datos en cach) y, cuando se queda sin trabajo, roba por el inicio de la
+// cola de otro hilo (las ms antiguas, que suelen ser los trozos ms grandes de una divisin).
+// Quien espera a que termine un grupo de tareas tambin ejecuta tareas mientras espera, por lo
+// que parallelFor y parallelReduce pueden anidarse sin bloquear el conjunto.
+class ThreadPool
+{
+private:
+	struct Cola
+	{
+		std::mutex m;
+		std::deque<std::function<void()>> tareas;
+	};
+
+	std::vector<std::unique_ptr<Cola>> colas;
+	std::vector<std::thread> hilos;
+	std::atomic<bool> detener;
+	std::atomic<size_t> pendientes;   // Tareas encoladas an no tomadas
+	std::atomic<size_t> siguiente;    // Cola para las tareas enviadas desde fuera del conjunto
+	std::mutex mEspera;
+	std::condition_variable cvEspera;
+
+	static thread_local ThreadPool* poolActual;
+	static thread_local size_t indiceActual;
+
+	void _encolar(std::function<void()> tarea);
+	bool _tomarTarea(std::function<void()>& tarea);
+	void _trabajar(size_t indice);
+	void _esperar(const std::atomic<size_t>& restantes);
+
+public:
+	// 'numeroHilos' = 0 usa todos los ncleos
+	ThreadPool(size_t numeroHilos = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	size_t size() const;
+
+	// Encola una tarea sin esperar su resultado
+	void submit(const std::function<void()>& tarea);
+
+	// Ejecuta cuerpo(desde, hasta) sobre trozos de como mximo 'grano' elementos de [inicio, fin)
+	// y espera a que terminen todos; relanza la primera excepcin que ocurra
+	void parallelFor(size_t inicio, size_t fin, size_t grano, const std::function<void(size_t, size_t)>& cuerpo);
+
+	// Calcula 'mapear' sobre cada trozo y combina los resultados parciales
+	template<class T>
+	T parallelReduce(size_t inicio, size_t fin, size_t grano, const T& identidad,
+		const std::function<T(size_t, size_t)>& mapear, const std::function<T(const T&, const T&)>& combinar);
+};
+
+thread_local ThreadPool* ThreadPool::poolActual = nullptr;
+thread_local size_t ThreadPool::indiceActual = 0;
+
+ThreadPool::ThreadPool(size_t numeroHilos) : detener(false), pendientes(0), siguiente(0)
+{
+	if (numeroHilos == 0)
+	{
+		numeroHilos = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+
+	for (size_t i = 0; i < numeroHilos; ++i)
+	{
+		colas.emplace_back(new Cola());
+	}
+	for (size_t i = 0; i < numeroHilos; ++i)
+	{
+		hilos.emplace_back(&ThreadPool::_trabajar, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> bloqueo(mEspera);
+		detener = true;
+	}
+	cvEspera.notify_all();
+	for (auto& hilo : hilos)
+	{
+		hilo.join();
+	}
+}
+
+size_t ThreadPool::size() const
+{
+	return hilos.size();
+}
+
+void ThreadPool::_encolar(std::function<void()> tarea)
+{
+	// Desde un hilo del conjunto la tarea va a su propia cola; desde fuera, se reparten
+	size_t indice = (poolActual == this) ? indiceActual : siguiente.fetch_add(1) % colas.size();
+	{
+		std::lock_guard<std::mutex> bloqueo(colas[indice]->m);
+		colas[indice]->tareas.push_back(std::move(tarea));
+	}
+	++pendientes;
+
+	// Tomar el mutex antes de notificar evita que un hilo que est por dormir pierda el aviso
+	{
+		std::lock_guard<std::mutex> bloqueo(mEspera);
+	}
+	cvEspera.notify_one();
+}
+
+bool ThreadPool::_tomarTarea(std::function<void()>& tarea)
+{
+	size_t n = colas.size();
+	bool propio = (poolActual == this);
+	size_t inicio = propio ? indiceActual : 0;
+
+	// Primero la cola propia por el final
+	if (propio)
+	{
+		Cola& cola = *colas[inicio];
+		std::lock_guard<std::mutex> bloqueo(cola.m);
+		if (!cola.tareas.empty())
+		{
+			tarea = std::move(cola.tareas.back());
+			cola.tareas.pop_back();
+			--pendientes;
+			return true;
+		}
+	}
+
+	// Luego robar por el inicio de las dems
+	for (size_t k = propio ? 1 : 0; k < n; ++k)
+	{
+		Cola& cola = *colas[(inicio + k) % n];
+		std::lock_guard<std::mutex> bloqueo(cola.m);
+		if (!cola.tareas.empty())
+		{
+			tarea = std::move(cola.tareas.front());
+			cola.tareas.pop_front();
+			--pendientes;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::_trabajar(size_t indice)
+{
+	poolActual = this;
+	indiceActual = indice;
+
+	std::function<void()> tarea;
+	while (true)
+	{
+		if (_tomarTarea(tarea))
+		{
+			tarea();
+			tarea = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> bloqueo(mEspera);
+		cvEspera.wait(bloqueo, [this]() { return detener.load() || pendientes.load() > 0; });
+		if (detener && pendientes.load() == 0)
+		{
+			return;
+		}
+	}
+}
+
+// Ejecuta tareas pendientes hasta que 'restantes' llegue a cero
+void ThreadPool::_esperar(const std::atomic<size_t>& restantes)
+{
+	std::function<void()> tarea;
+	while (restantes.load() > 0)
+	{
+		if (_tomarTarea(tarea))
+		{
+			tarea();
+			tarea = nullptr;
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void ThreadPool::submit(const std::function<void()>& tarea)
+{
+	_encolar(tarea);
+}
+
+void ThreadPool::parallelFor(size_t inicio, size_t fin, size_t grano, const std::function<void(size_t, size_t)>& cuerpo)
+{
+	if (inicio >= fin)
+	{
+		return;
+	}
+	if (grano == 0)
+	{
+		grano = 1;
+	}
+
+	std::atomic<size_t> restantes(1);
+	std::mutex mError;
+	std::exception_ptr error;
+
+	// Cada tarea parte su rango a la mitad y encola la mitad derecha hasta llegar al grano:
+	// as los ladrones se llevan trozos grandes y la cola propia queda con los pequeos
+	std::function<void(size_t, size_t)> dividir = [&](size_t desde, size_t hasta) {
+		while (hasta - desde > grano)
+		{
+			size_t medio = desde + (hasta - desde) / 2;
+			++restantes;
+			_encolar([&dividir, medio, hasta]() { dividir(medio, hasta); });
+			hasta = medio;
+		}
+
+		try
+		{
+			cuerpo(desde, hasta);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> bloqueo(mError);
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+		--restantes;
+		};
+
+	dividir(inicio, fin);
+	_esperar(restantes);
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+template<class T>
+T ThreadPool::parallelReduce(size_t inicio, size_t fin, size_t grano, const T& identidad,
+	const std::function<T(size_t, size_t)>& mapear, const std::function<T(const T&, const T&)>& combinar)
+{
+	if (grano == 0)
+	{
+		grano = 1;
+	}
+
+	// Un resultado parcial por trozo, combinados en orden al final
+	size_t trozos = (fin > inicio) ? (fin - inicio + grano - 1) / grano : 0;
+	std::vector<T> parciales(trozos, identidad);
+	parallelFor(0, trozos, 1, [&](size_t desde, size_t hasta) {
+		for (size_t t = desde; t < hasta; ++t)
+		{
+			size_t a = inicio + t * grano;
+			size_t b = std::min(fin, a + grano);
+			parciales[t] = mapear(a, b);
+		}
+		});
+
+	T resultado = identidad;
+	for (const T& parcial : parciales)
+	{
+		resultado = combinar(resultado, parcial);
+	}
+	return resultado;
+}
@@ -5,12 +5,40 @@
 #include "Monto.h"
 #include "IShowable.h"
 #include "IRandomizable.h"
+#include "Serializable.h"
+#include <cstdint>
+#include <type_traits>
 
 // Enumeracin para el tipo de transaccin
 enum class TipoTransaccion { Deposito, Retiro, Desconocido };
 
+template<>
+struct NombresEnum<TipoTransaccion>
+{
+    static constexpr const char* nombres[] = { "Deposito", "Retiro", "Desconocido" };
+};
+
+// Registro compacto de una transaccin, como se guarda en los historiales: 16 bytes sin
+// punteros ni vtable, as un historial se copia con memcpy y un milln de transacciones
+// ocupan unos 16 MB. Para mostrarla o serializarla se convierte en Transaccion.
+struct RegistroTransaccion
+{
+    int64_t centimos;   // Monto en cntimos
+    int32_t numeroDia;  // Fecha de emisin (Fecha::toNumeroDia)
+    uint8_t tipo;       // TipoTransaccion
+    uint8_t banderas;   // Reservado: 0
+    uint16_t relleno;   // Sin uso; mantiene el tamao explcito
+
+    static RegistroTransaccion crear(const Monto& monto, const Fecha& fechaEmision, TipoTransaccion tipo);
+
+    TipoTransaccion getTipo() const;
+};
+
+static_assert(sizeof(RegistroTransaccion) == 16, "RegistroTransaccion debe ocupar 16 bytes");
+static_assert(is_trivially_copyable<RegistroTransaccion>::value, "RegistroTransaccion debe poder copiarse con memcpy");
+
 // Clase Transaccion
-class Transaccion : public IDebugable, ISavable, IShowable, IRandomizable
+class Transaccion : public IDebugable, ISavable, IShowable, IRandomizable, public Serializable<Transaccion>
 {
 private:
     TipoTransaccion tipo;             // Tipo de transaccin
@@ -27,6 +55,8 @@ public:
     Transaccion(const Monto& monto, const Fecha& fechaEmision, const TipoTransaccion& tipo);
     // Constructor que inicializa la transaccin a partir de una cadena de texto
     Transaccion(const string& datos);
+    // Constructor que reconstruye la transaccin desde su registro compacto
+    explicit Transaccion(const RegistroTransaccion& registro);
     // Constructor por defecto
     Transaccion();
     // Destructor por defecto
@@ -42,6 +72,8 @@ public:
     Fecha getFechaEmision() const;
     // Retorna el tipo de transaccin
     TipoTransaccion getTipo() const;
+    // Retorna el registro compacto que se guarda en los historiales
+    RegistroTransaccion toRegistro() const;
 
     // Mtodos de modificacin
 
@@ -77,9 +109,29 @@ public:
     string toShow() const override;
 
     // Mtodo que genera una transaccin aletoria
-    void generateRandom() override;
+    void generateRandom(Aleatorio& aleatorio) override;
+    using IRandomizable::generateRandom;
+
+    // Campos que se guardan, en orden (ver Serializable.h)
+    static constexpr auto esquema();
 };
 
+constexpr auto Transaccion::esquema()
+{
+    return crearEsquema("Transaccion", Serialization::DELIMITER_FIELD,
+        campo("Tipo", &Transaccion::tipo),
+        campo("FechaEmision", &Transaccion::fechaEmision),
+        campo("Monto", &Transaccion::monto, &Transaccion::setMontoMonto));
+}
+
+RegistroTransaccion RegistroTransaccion::crear(const Monto& monto, const Fecha& fechaEmision, TipoTransaccion tipo) {
+    return { monto.getTotalCentimos(), fechaEmision.toNumeroDia(), static_cast<uint8_t>(tipo), 0, 0 };
+}
+
+TipoTransaccion RegistroTransaccion::getTipo() const {
+    return static_cast<TipoTransaccion>(tipo);
+}
+
 // Constructor que recibe el monto como float, fecha de emisin y tipo
 Transaccion::Transaccion(const float& monto, const Fecha& fechaEmision, const TipoTransaccion& tipo)
     : monto(Monto(monto)), fechaEmision(fechaEmision), tipo(tipo) {}
@@ -93,6 +145,12 @@ Transaccion::Transaccion(const string& datos) {
     load(datos);
 }
 
+// Constructor desde el registro compacto
+Transaccion::Transaccion(const RegistroTransaccion& registro) : tipo(registro.getTipo()) {
+    fechaEmision.setNumeroDia(registro.numeroDia);
+    monto.setTotalCentimos(registro.centimos);
+}
+
 // Constructor por defecto
 Transaccion::Transaccion() : monto(0), fechaEmision(Fecha()), tipo(TipoTransaccion::Desconocido) {}
 
@@ -116,6 +174,11 @@ TipoTransaccion Transaccion::getTipo() const {
     return tipo;
 }
 
+// Retorna el registro compacto de la transaccin
+RegistroTransaccion Transaccion::toRegistro() const {
+    return RegistroTransaccion::crear(monto, fechaEmision, tipo);
+}
+
 // Establece el monto a partir de un float, con validacin
 bool Transaccion::setMontoFloat(const float& monto) {
     if (monto < 0) {
@@ -172,40 +235,12 @@ string Transaccion::toDebug() const {
 
 // Mtodo de guardado
 string Transaccion::toSave() const {
-    ostringstream out;
-    out << toStringTipo() << Serialization::DELIMITER_FIELD
-        << fechaEmision.toStringDDMMAAAA() << Serialization::DELIMITER_FIELD
-        << monto.toSave();
-    return out.str();
+    return guardar();
 }
 
 // Mtodo para cargar los datos desde una cadena
 void Transaccion::load(const string& data) {
-    istringstream in(data);
-    string tipoString, fechaString, montoString;
-
-    if (!getline(in, tipoString, Serialization::DELIMITER_FIELD) ||
-        !getline(in, fechaString, Serialization::DELIMITER_FIELD) ||
-        !getline(in, montoString)) {
-        throw runtime_error("Error al cargar los datos: datos insuficientes o mal formateados.");
-    }
-
-    fechaEmision = Fecha(fechaString);
-    monto = Monto(montoString);
-
-    if (!setMontoMonto(monto)) {
-        throw runtime_error("Error al asignar monto");
-    }
-
-    if (tipoString == "Deposito") {
-        tipo = TipoTransaccion::Deposito;
-    }
-    else if (tipoString == "Retiro") {
-        tipo = TipoTransaccion::Retiro;
-    }
-    else {
-        tipo = TipoTransaccion::Desconocido;
-    }
+    cargar(data);
 }
 
 // Mtodo para mostrar la transaccin
@@ -221,10 +256,10 @@ string Transaccion::toShow() const {
 }
 
 // Mtodo para generar una transaccin aleatoria
-void Transaccion::generateRandom() {
-    short option = rand() % 2;
-    fechaEmision.generateRandom();
-    monto.generateRandom();
+void Transaccion::generateRandom(Aleatorio& aleatorio) {
+    short option = aleatorio.entero(2);
+    fechaEmision.generateRandom(aleatorio);
+    monto.generateRandom(aleatorio);
 
     tipo = (option == 0) ? TipoTransaccion::Deposito : TipoTransaccion::Retiro;
 }
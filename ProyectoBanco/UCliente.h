@@ -32,36 +32,38 @@ public:
 	Monto _totalRetiros(size_t& numeroRetiros) const;
 
 
-	void _showDatos() const;
-	void _showHistorial() const;
-	void _showReporte() const;
+	void _showDatos(ostream& out) const;
+	void _showHistorial(ostream& out) const;
+	void _showReporte(ostream& out) const;
 
-	void _interactDepositar();
-	void _interactRetirar();
-	void _interactRegistrarQueja();
+	Tarea _interactDepositar(Sesion& sesion);
+	Tarea _interactRetirar(Sesion& sesion);
+	Tarea _interactRegistrarQueja(Sesion& sesion);
 
 	string toShow() const override;
 	string toSave() const override;
 	void load(const string& datos) override;
-	void generateRandom() override;
-	void interact() override;
+	void generateRandom(Aleatorio& aleatorio) override;
+	using IRandomizable::generateRandom;
+	Tarea interactuar(Sesion& sesion) override;
+	using IInteractive::interact;
 };
 
 UCliente::UCliente()
 	: fechaActual(Fecha()), tarjeta(Tarjeta()), historial(SQueue<Transaccion>()),
-	quejas(MQuejas(fechaActual, TipoUsuario::Cliente)),
+	quejas(fechaActual, TipoUsuario::Cliente),
 	Usuario(Identidad(), Contacto())
 {}
 
 UCliente::UCliente(const Fecha& fechaActual, const Identidad& identidad, const Contacto& contacto)
-	: historial(SQueue<Transaccion>()), quejas(MQuejas(fechaActual, TipoUsuario::Cliente)), Usuario(Identidad(), Contacto())
+	: historial(SQueue<Transaccion>()), quejas(fechaActual, TipoUsuario::Cliente), Usuario(Identidad(), Contacto())
 {
 	tarjeta.generateRandom();
 	tarjeta.setSaldo(0);
 }
 
 UCliente::UCliente(const Fecha& fechaActual, const string& datos) : fechaActual(fechaActual),
-historial(SQueue<Transaccion>()), quejas(MQuejas(fechaActual, TipoUsuario::Cliente))
+historial(SQueue<Transaccion>()), quejas(fechaActual, TipoUsuario::Cliente)
 {
 	load(datos);
 }
@@ -107,53 +109,52 @@ Monto UCliente::_totalRetiros(size_t& numeroRetiros) const {
 }
 
 
-void UCliente::_showDatos() const
+void UCliente::_showDatos(ostream& out) const
 {
-	cout << toShow() << endl;
+	out << toShow() << '\n';
 }
 
-void UCliente::_showHistorial() const
+void UCliente::_showHistorial(ostream& out) const
 {
 	for (auto &transaccion : historial) {
-		cout << transaccion.toShow() << endl;
+		out << transaccion.toShow() << '\n';
 	}
 }
 
-void UCliente::_showReporte() const {
+void UCliente::_showReporte(ostream& out) const {
 	size_t numeroDepositos, numeroRetiros;
-	cout << "=== Reporte de Cuenta ===\n";
-	cout << "Total Depositos: " << _totalDepositos(numeroDepositos).toString() << '\n';
-	cout << "Total Retiros: " << _totalRetiros(numeroRetiros).toString() << '\n';
-	cout << "Numero Depositos: " << numeroDepositos << '\n';
-	cout << "Numero Retiros: " << numeroRetiros << '\n';
-	cout << "Saldo Actual: " << tarjeta.getSaldoMonto().toString() << '\n';
+	out << "=== Reporte de Cuenta ===\n";
+	out << "Total Depositos: " << _totalDepositos(numeroDepositos).toString() << '\n';
+	out << "Total Retiros: " << _totalRetiros(numeroRetiros).toString() << '\n';
+	out << "Numero Depositos: " << numeroDepositos << '\n';
+	out << "Numero Retiros: " << numeroRetiros << '\n';
+	out << "Saldo Actual: " << tarjeta.getSaldoMonto().toString() << '\n';
 }
 
-void UCliente::_interactDepositar() {
+Tarea UCliente::_interactDepositar(Sesion& sesion) {
 	float monto;
-	cout << "Ingrese monto a depositar: ";
-	cin >> monto;
-	if (_addDeposito(fechaActual, monto))
-		cout << "Deposito exitoso.\n";
+	sesion.out() << "Ingrese monto a depositar: ";
+	optional<string> linea = co_await sesion.leerLinea();
+	if (linea && Sesion::convertir(*linea, monto) && _addDeposito(fechaActual, monto))
+		sesion.out() << "Deposito exitoso.\n";
 	else
-		cout << "Deposito fallido.\n";
+		sesion.out() << "Deposito fallido.\n";
 }
 
-void UCliente::_interactRetirar() {
+Tarea UCliente::_interactRetirar(Sesion& sesion) {
 	float monto;
-	cout << "Ingrese monto a retirar: ";
-	cin >> monto;
-	if (_addRetiro(fechaActual, monto))
-		cout << "Retiro exitoso.\n";
+	sesion.out() << "Ingrese monto a retirar: ";
+	optional<string> linea = co_await sesion.leerLinea();
+	if (linea && Sesion::convertir(*linea, monto) && _addRetiro(fechaActual, monto))
+		sesion.out() << "Retiro exitoso.\n";
 	else
-		cout << "Retiro fallido.\n";
+		sesion.out() << "Retiro fallido.\n";
 }
 
-void UCliente::_interactRegistrarQueja()
+Tarea UCliente::_interactRegistrarQueja(Sesion& sesion)
 {
-	quejas.loadFromFile();
-	quejas.interact();
-	quejas.saveToFile();
+	// La queja se anexa al archivo al registrarse; no hace falta cargarlo ni reescribirlo
+	co_await quejas.interactuar(sesion);
 }
 
 string UCliente::toShow() const
@@ -227,13 +228,13 @@ void UCliente::load(const string& datos) {
 	}
 }
 
-void UCliente::generateRandom()
+void UCliente::generateRandom(Aleatorio& aleatorio)
 {
-	identidad.generateRandom();
-	contacto.generateRandom();
-	tarjeta.generateRandom();
+	identidad.generateRandom(aleatorio);
+	contacto.generateRandom(aleatorio);
+	tarjeta.generateRandom(aleatorio);
 
-	size_t n = rand() % 3 + 1; // Generar de 1 a 3 cuentas
+	size_t n = aleatorio.entero(3) + 1; // Generar de 1 a 3 cuentas
 
 	// Limpiar historial
 	historial.clear();
@@ -247,10 +248,10 @@ void UCliente::generateRandom()
 	AVLTree<Transaccion> historialTree(compare);
 
 	// Generar entre 1 y 10 transacciones aleatorias
-	size_t num = 1 + rand() % 10;
+	size_t num = 1 + aleatorio.entero(10);
 	for (size_t i = 0; i < num; ++i) {
 		Transaccion t;
-		t.generateRandom();
+		t.generateRandom(aleatorio);
 		historialTree.insert(t); // Insertar en el rbol AVL
 	}
 
@@ -261,11 +262,11 @@ void UCliente::generateRandom()
 	}
 }
 
-void UCliente::interact()
+Tarea UCliente::interactuar(Sesion& sesion)
 {
-	int opcion;
-	do {
-		cout << "=== Menu de Cliente ===\n"
+	ostream& out = sesion.out();
+	while (true) {
+		out << "=== Menu de Cliente ===\n"
 			<< "1. Mostrar datos\n"
 			<< "2. Mostrar historial\n"
 			<< "3. Mostrar reporte\n"
@@ -274,24 +275,24 @@ void UCliente::interact()
 			<< "6. Registrar queja\n"
 			<< "7. Salir\n"
 			<< "Seleccione una opcin: ";
-		cin >> opcion;
+		optional<string> linea = co_await sesion.leerLinea();
+		if (!linea) co_return; // Fin de la entrada
 
-		if (cin.fail()) {
-			cin.clear();
-			cin.ignore();
-			cout << "Entrada invlida. Intente nuevamente.\n";
+		int opcion;
+		if (!Sesion::convertir(*linea, opcion)) {
+			out << "Entrada invlida. Intente nuevamente.\n";
 			continue;
 		}
 
 		switch (opcion) {
-		case 1: _showDatos(); break;
-		case 2: _showHistorial(); break;
-		case 3: _showReporte(); break;
-		case 4: _interactDepositar(); break;
-		case 5: _interactRetirar(); break;
-		case 6: _interactRegistrarQueja(); break;
-		case 7: cout << "Saliendo del men.\n"; break;
-		default: cout << "Opcin invlida. Intente nuevamente.\n";
+		case 1: _showDatos(out); break;
+		case 2: _showHistorial(out); break;
+		case 3: _showReporte(out); break;
+		case 4: co_await _interactDepositar(sesion); break;
+		case 5: co_await _interactRetirar(sesion); break;
+		case 6: co_await _interactRegistrarQueja(sesion); break;
+		case 7: out << "Saliendo del men.\n"; co_return;
+		default: out << "Opcin invlida. Intente nuevamente.\n";
 		}
-	} while (opcion != 7);
+	}
 }
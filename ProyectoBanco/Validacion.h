@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VALIDACION_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define VALIDACION_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Validadores de los campos que se revisan en cada carga masiva: corridas de dgitos (DNI,
+// tarjeta, CVV, telfono, nmero de cuenta) y la forma de un correo electrnico. Con SSE2
+// (siempre disponible en x86-64) un campo de hasta 16 caracteres se valida y convierte con un
+// solo registro de 16 bytes; con AVX2 (opcin PROYECTOBANCO_AVX2 de CMake o /arch:AVX2)
+// esDigitos recorre los textos largos de a 32 bytes. En otras arquitecturas se usan las versiones
+// escalares, que se conservan tambin para comparar (Benchmarks micro --filtro Validacion).
+class Validacion
+{
+private:
+#ifdef VALIDACION_SSE2
+	// Los 'longitud' (<= 16) caracteres alineados a la derecha y completados con 'relleno'
+	static __m128i _cargar16(const char* texto, size_t longitud, char relleno);
+	static bool _digitos16(__m128i bloque);
+#endif
+
+public:
+	// Conjunto de instrucciones con que se compil: "AVX2", "SSE2" o "escalar"
+	static const char* getInstrucciones();
+
+	// true si todos los caracteres son dgitos (tambin si 'texto' est vaco)
+	static bool esDigitos(string_view texto);
+	static bool esDigitosEscalar(string_view texto);
+
+	// Valida y convierte a la vez hasta 19 dgitos; si alguno no es dgito retorna false y no
+	// cambia 'valor'
+	static bool leerDigitos(string_view texto, uint64_t& valor);
+	static bool leerDigitosEscalar(string_view texto, uint64_t& valor);
+
+	// Forma de correo que exige Contacto: un '@' y, despus del primero, un '.'
+	static bool esCorreo(string_view texto);
+	static bool esCorreoEscalar(string_view texto);
+};
+
+const char* Validacion::getInstrucciones()
+{
+#if defined(VALIDACION_AVX2)
+	return "AVX2";
+#elif defined(VALIDACION_SSE2)
+	return "SSE2";
+#else
+	return "escalar";
+#endif
+}
+
+#ifdef VALIDACION_SSE2
+__m128i Validacion::_cargar16(const char* texto, size_t longitud, char relleno)
+{
+	if (longitud == 16)
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(texto));
+	}
+	if (longitud >= 8)
+	{
+		// Dos lecturas de 8 bytes que se solapan: la alta son los ltimos 8 caracteres y la baja
+		// los primeros, desplazados hacia arriba para dejar 16 - longitud bytes de relleno
+		__m128i desplazamiento = _mm_cvtsi32_si128(static_cast<int>(8 * (16 - longitud)));
+		__m128i primeros = _mm_sll_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(texto)), desplazamiento);
+		__m128i rellenos = _mm_srl_epi64(_mm_set1_epi8(relleno), _mm_cvtsi32_si128(static_cast<int>(8 * (longitud - 8))));
+		__m128i ultimos = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(texto + longitud - 8));
+		return _mm_unpacklo_epi64(_mm_or_si128(primeros, rellenos), ultimos);
+	}
+	// No se lee ms all del texto: se copia a un bloque local
+	alignas(16) char bloque[16];
+	memset(bloque, relleno, sizeof(bloque));
+	if (longitud > 0)
+	{
+		memcpy(bloque + 16 - longitud, texto, longitud);
+	}
+	return _mm_load_si128(reinterpret_cast<const __m128i*>(bloque));
+}
+
+bool Validacion::_digitos16(__m128i bloque)
+{
+	// c - '0' <= 9 sin signo: lo que excede a 9 queda distinto de cero tras la resta saturada
+	__m128i valores = _mm_sub_epi8(bloque, _mm_set1_epi8('0'));
+	__m128i exceso = _mm_subs_epu8(valores, _mm_set1_epi8(9));
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(exceso, _mm_setzero_si128())) == 0xFFFF;
+}
+#endif
+
+bool Validacion::esDigitosEscalar(string_view texto)
+{
+	for (char c : texto)
+	{
+		if (static_cast<unsigned char>(c - '0') > 9)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Validacion::esDigitos(string_view texto)
+{
+#ifdef VALIDACION_SSE2
+	const char* inicio = texto.data();
+	size_t restantes = texto.size();
+#ifdef VALIDACION_AVX2
+	const __m256i cero = _mm256_set1_epi8('0');
+	const __m256i nueve = _mm256_set1_epi8(9);
+	for (; restantes >= 32; inicio += 32, restantes -= 32)
+	{
+		__m256i valores = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(inicio)), cero);
+		__m256i exceso = _mm256_subs_epu8(valores, nueve);
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(exceso, _mm256_setzero_si256())) != -1)
+		{
+			return false;
+		}
+	}
+#endif
+	for (; restantes >= 16; inicio += 16, restantes -= 16)
+	{
+		if (!_digitos16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inicio))))
+		{
+			return false;
+		}
+	}
+	return restantes == 0 || _digitos16(_cargar16(inicio, restantes, '0'));
+#else
+	return esDigitosEscalar(texto);
+#endif
+}
+
+bool Validacion::leerDigitosEscalar(string_view texto, uint64_t& valor)
+{
+	uint64_t nuevo = 0;
+	for (char c : texto)
+	{
+		unsigned char digito = static_cast<unsigned char>(c - '0');
+		if (digito > 9)
+		{
+			return false;
+		}
+		nuevo = nuevo * 10 + digito;
+	}
+	valor = nuevo;
+	return true;
+}
+
+bool Validacion::leerDigitos(string_view texto, uint64_t& valor)
+{
+#ifdef VALIDACION_SSE2
+	if (texto.size() > 16)
+	{
+		return leerDigitosEscalar(texto, valor);
+	}
+	// Con ceros a la izquierda el bloque representa el mismo nmero
+	__m128i bloque = _cargar16(texto.data(), texto.size(), '0');
+	if (!_digitos16(bloque))
+	{
+		return false;
+	}
+
+	// Se combinan dgitos vecinos en pasos de 2, 4 y 8 dgitos: 16 bytes -> 2 enteros de 8 dgitos
+	__m128i digitos = _mm_sub_epi8(bloque, _mm_set1_epi8('0'));
+	__m128i bajos = _mm_unpacklo_epi8(digitos, _mm_setzero_si128());
+	__m128i altos = _mm_unpackhi_epi8(digitos, _mm_setzero_si128());
+	const __m128i por10 = _mm_setr_epi16(10, 1, 10, 1, 10, 1, 10, 1);
+	__m128i pares = _mm_packs_epi32(_mm_madd_epi16(bajos, por10), _mm_madd_epi16(altos, por10));
+	__m128i cuartetos = _mm_madd_epi16(pares, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+	cuartetos = _mm_packs_epi32(cuartetos, cuartetos);
+	__m128i octetos = _mm_madd_epi16(cuartetos, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+
+	uint64_t alto = static_cast<uint32_t>(_mm_cvtsi128_si32(octetos));
+	uint64_t bajo = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(octetos, 4)));
+	valor = alto * 100000000ULL + bajo;
+	return true;
+#else
+	return leerDigitosEscalar(texto, valor);
+#endif
+}
+
+bool Validacion::esCorreoEscalar(string_view texto)
+{
+	bool tieneArroba = false;
+	for (char c : texto)
+	{
+		if (c == '@')
+		{
+			tieneArroba = true;
+		}
+		else if (tieneArroba && c == '.')
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Validacion::esCorreo(string_view texto)
+{
+#ifdef VALIDACION_SSE2
+	const char* inicio = texto.data();
+	size_t restantes = texto.size();
+	bool tieneArroba = false;
+	const __m128i arroba = _mm_set1_epi8('@');
+	const __m128i punto = _mm_set1_epi8('.');
+	while (restantes > 0)
+	{
+		size_t tamanio = restantes < 16 ? restantes : 16;
+		__m128i bloque = _cargar16(inicio, tamanio, ' ');
+		unsigned puntos = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bloque, punto)));
+		if (!tieneArroba)
+		{
+			unsigned arrobas = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(bloque, arroba)));
+			if (arrobas == 0)
+			{
+				inicio += tamanio;
+				restantes -= tamanio;
+				continue;
+			}
+			// Solo cuentan los puntos que siguen al primer '@' (el bit ms bajo)
+			tieneArroba = true;
+			unsigned primera = arrobas & (0u - arrobas);
+			puntos &= ~((primera << 1) - 1);
+		}
+		if (puntos != 0)
+		{
+			return true;
+		}
+		inicio += tamanio;
+		restantes -= tamanio;
+	}
+	return false;
+#else
+	return esCorreoEscalar(texto);
+#endif
+}